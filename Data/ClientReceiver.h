@@ -1,63 +1,97 @@
-#pragma once
-
-#include <QObject>
-#include <QMap>
-#include <QVector>
-#include <QVariant>
-#include <QStringList>
-#include <QDate>
-#include <QJsonObject>
-#include <QMutex> // For thread safety
-
-#include "Plots/PlotDataForDate.h"
-
-// Forward declaration
-class QJsonObject;
-
-// Structure to hold parsed data for a specific expiration date
-struct SmileData {
-    QVector<double> strikes;
-    QVector<double> theoIvs;
-    QVector<double> askIvs;
-    QVector<double> bidIvs;
-    QStringList tooltips; // Pre-generate tooltips here
-    bool isValid = false;
-};
-
-class ClientReceiver : public QObject
-{
-    Q_OBJECT
-
-public:
-    explicit ClientReceiver(QObject* parent = nullptr);
-    ~ClientReceiver() override = default;
-
-    // Public method to get the smile data for plotting
-    SmileData getSmileData(const QString& symbol, const QDate& expirationDate) const;
-
-    // Public method to get currently available symbols
-    QStringList getAvailableSymbols() const;
-
-    // Public method to get available expiration dates for a symbol
-    QList<QDate> getAvailableExpirationDates(const QString& symbol) const;
-
-
-signals:
-    // Emitted when new data has been processed and is ready
-    void plotDataUpdated(const QString& symbol, const QDate& date, const PlotDataForDate& data);
-
-public slots:
-    // Slot to receive the incoming JSON message containing compressed data
-    void processWebSocketMessage(const QString& symbol, const QString& model, const QJsonObject& data);
-
-private:
-    // Internal data storage: Symbol -> ExpirationDate -> SmileData
-    QMap<QString, QMap<QDate, SmileData>> m_dataStore;
-    mutable QMutex m_dataMutex; // Protect access across threads
-
-    // Helper function to parse CSV and populate internal storage
-    //bool parseAndLoadData(const QByteArray& decompressedCsvData, QMap<QString, QMap<QDate, SmileData>>& outData);
-
-    static QString getFieldSafe(const QStringList& fields, int index);
-    bool parseSmileCSV(const QString& csvData, QDate& outDate, PlotDataForDate& outPlotData);
+#pragma once
+
+#include <QObject>
+#include <QMap>
+#include <QVector>
+#include <QVariant>
+#include <QStringList>
+#include <QDate>
+#include <QMutex> // For thread safety
+#include <QHash>
+
+#include "Plots/PlotDataForDate.h"
+#include "SmileSnapshot.h"
+#include "SnapshotStore.h"
+#include "Network/MessageEnvelope.h"
+#include "IngestExecutor.h"
+
+class ClientReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ClientReceiver(int ingestWorkers = 1, int queueCapacity = 64,
+        IngestExecutor::OverflowPolicy overflowPolicy = IngestExecutor::OverflowPolicy::DropOldest, QObject* parent = nullptr);
+    ~ClientReceiver() override = default;
+
+    // Key of a symbol/model stream ("symbol_model"): ingest queues, delta sequences and published snapshots
+    static QString streamKey(const QString& symbol, const QString& model) { return SnapshotStore::streamKey(symbol, model); }
+
+    // Public method to get the latest published smile (null if none)
+    SmileSnapshotPtr getLatestSnapshot(const QString& symbol, const QString& model, const QDate& expirationDate) const;
+
+    // Public method to get the latest published smile of every symbol/model/date
+    QList<SmileSnapshotPtr> getAllLatestSnapshots() const;
+
+    // Public method to get currently available symbols
+    QStringList getAvailableSymbols() const;
+
+    // Public method to get available expiration dates for a symbol/model
+    QList<QDate> getAvailableExpirationDates(const QString& symbol, const QString& model) const;
+
+    // Ingress queue counters per symbol_model (enqueued, processed, dropped, depth). Thread-safe.
+    QList<IngestExecutor::KeyStats> getIngressStats() const;
+    // Deepest symbol_model ingress queue right now (replay backpressure). Thread-safe.
+    int getIngressBacklog() const { return m_executor->maxDepth(); }
+    int getIngressQueueCapacity() const { return m_executor->queueCapacity(); }
+
+    // JSON snapshots without "date" are coalesced per symbol/model instead of queued as is. Only for servers
+    // that send one expiry per symbol/model. Set before messages arrive ([Ingest] CoalesceUndatedSnapshots).
+    void setCoalesceUndatedSnapshots(bool enabled) { m_coalesceUndatedSnapshots = enabled; }
+
+
+signals:
+    // Emitted when a new snapshot has been published. Receivers share the snapshot, they must not copy its data.
+    void plotDataUpdated(const QString& symbol, const QDate& date, const SmileSnapshotPtr& snapshot);
+    // Emitted (from an ingest worker) when a delta sequence gap was detected; the stream needs a full snapshot
+    void resnapshotRequired(const QString& symbol, const QString& model);
+
+public slots:
+    // Slot to receive the envelope of an incoming JSON message (compressed data already base64-decoded).
+    // Thread-safe: connected directly on the network thread, it only queues the message for a worker.
+    void processWebSocketMessage(const MessageEnvelope& envelope);
+    // Slot to receive a binary columnar smile frame (see Network/SmileWireFormat.h). Thread-safe, as above.
+    void processSmileFrame(const QByteArray& frame);
+    // Stops the ingest workers, call before application exit
+    void shutdown();
+
+private:
+    IngestExecutor* m_executor = nullptr; // Decode/inflate/parse workers, keyed by symbol_model
+    bool m_coalesceUndatedSnapshots = false;
+    static constexpr qint64 UndatedSlot = -1; // postLatest() slot of undated snapshots (dated ones use the Julian day)
+
+    SnapshotStore m_snapshots; // Latest published snapshot per symbol/model/date
+
+    // Delta sequence tracking per symbol_model stream
+    struct StreamState {
+        quint64 lastSequence = 0;      // Sequence of the last applied snapshot/delta (0 = unknown: the next delta seeds it)
+        bool awaitingSnapshot = false; // Gap detected, deltas are dropped until the next snapshot
+    };
+    QHash<QString, StreamState> m_streams;
+    QMutex m_streamMutex;
+
+    // Helper function to parse CSV and populate internal storage
+    //bool parseAndLoadData(const QByteArray& decompressedCsvData, QMap<QString, QMap<QDate, SmileData>>& outData);
+
+    void decodeDataStream(const MessageEnvelope& envelope);
+    void decodeSmileFrame(const QByteArray& frame, const Trace::Timeline& trace);
+    // False if the delta could not be applied (no base snapshot)
+    bool applyDelta(const QString& symbol, const QString& model, const QDate& date,
+        const PlotDataForDate& rows, const QVector<quint8>& ops, const Trace::Timeline& trace);
+    // Snapshot: restarts the sequence. Delta: true if it directly follows the last one (or the sequence is unknown),
+    // otherwise requests a resnapshot. An accepted delta is committed with commitSequence once applied.
+    bool acceptSequence(const QString& symbol, const QString& model, quint64 sequence, bool isDelta);
+    void commitSequence(const QString& symbol, const QString& model, quint64 sequence);
+    // A delta was lost (gap, or it failed to decode/apply): drops deltas until the next snapshot and asks for one
+    void requestResnapshot(const QString& symbol, const QString& model);
 };
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include "IngestExecutor.h"
+#include "Glob/Logger.h"
+
+#include <QThread>
+#include <QMetaObject>
+#include <QReadLocker>
+#include <QWriteLocker>
+
+#include <chrono>
+
+namespace {
+    qint64 monotonicNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+IngestExecutor::IngestExecutor(int workerCount, int queueCapacity, OverflowPolicy policy, QObject* parent)
+    : QObject(parent), m_queueCapacity(qMax(2, queueCapacity)), m_policy(policy) {
+    const int count = qMax(1, workerCount);
+
+    for (int i = 0; i < count; ++i) {
+        QThread* thread = new QThread();
+        thread->setObjectName(QString("Ingest-%1").arg(i));
+
+        QObject* lane = new QObject();
+        lane->moveToThread(thread);
+
+        m_threads.append(thread);
+        m_lanes.append(lane);
+        thread->start();
+    }
+
+    Log.msg(FNAME + QString("Ingest executor started with %1 worker(s), queue capacity %2 per key, overflow policy %3.")
+        .arg(count).arg(m_queueCapacity).arg(policyName(m_policy)), Logger::Level::INFO);
+}
+
+IngestExecutor::~IngestExecutor() {
+    shutdown();
+}
+
+int IngestExecutor::workerCount() const {
+    return m_lanes.size();
+}
+
+int IngestExecutor::workerForKey(const QString& key) const {
+    if (m_lanes.isEmpty()) return -1;
+    return static_cast<int>(qHash(key) % static_cast<size_t>(m_lanes.size()));
+}
+
+QString IngestExecutor::policyName(OverflowPolicy policy) {
+    return policy == OverflowPolicy::Coalesce ? "coalesce" : "drop-oldest";
+}
+
+bool IngestExecutor::policyFromName(const QString& name, OverflowPolicy& outPolicy) {
+    const QString normalized = name.trimmed().toLower();
+    if (normalized == "drop-oldest") {
+        outPolicy = OverflowPolicy::DropOldest;
+        return true;
+    }
+    if (normalized == "coalesce") {
+        outPolicy = OverflowPolicy::Coalesce;
+        return true;
+    }
+    return false;
+}
+
+bool IngestExecutor::post(const QString& key, std::function<void()> task, qsizetype bytes) {
+    KeyQueue* kq = keyQueue(key);
+    if (!kq) {
+        Log.msg(FNAME + "Executor is shut down, dropping task for key: " + key, Logger::Level::WARNING);
+        return false;
+    }
+    kq->enqueued.fetch_add(1, std::memory_order_relaxed);
+    kq->bytes.fetch_add(quint64(bytes), std::memory_order_relaxed);
+    enqueue(kq, Item{ std::move(task), nullptr });
+    return true;
+}
+
+bool IngestExecutor::postLatest(const QString& key, qint64 slot, std::function<void()> task, qsizetype bytes) {
+    KeyQueue* kq = keyQueue(key);
+    if (!kq) {
+        Log.msg(FNAME + "Executor is shut down, dropping task for key: " + key, Logger::Level::WARNING);
+        return false;
+    }
+    kq->enqueued.fetch_add(1, std::memory_order_relaxed);
+    kq->bytes.fetch_add(quint64(bytes), std::memory_order_relaxed);
+
+    LatestSlot* latest = kq->latestSlot(slot);
+    Task* previous = latest->exchange(new Task(std::move(task)), std::memory_order_acq_rel);
+    if (previous) {
+        // Not started yet: its token is still queued and will run the newer task instead
+        delete previous;
+        kq->coalesced.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    enqueue(kq, Item{ Task(), latest });
+    return true;
+}
+
+IngestExecutor::LatestSlot* IngestExecutor::KeyQueue::latestSlot(qint64 slot) {
+    QMutexLocker locker(&latestMutex);
+    LatestSlot*& result = latest[slot];
+    if (!result) {
+        result = new LatestSlot(nullptr);
+    }
+    return result;
+}
+
+void IngestExecutor::markSkipped(const QString& key) {
+    QReadLocker locker(&m_keysLock);
+    if (KeyQueue* kq = m_keys.value(key, nullptr)) {
+        kq->skipped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void IngestExecutor::markUncoalesced(const QString& key) {
+    QReadLocker locker(&m_keysLock);
+    if (KeyQueue* kq = m_keys.value(key, nullptr)) {
+        kq->uncoalesced.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+IngestExecutor::KeyQueue* IngestExecutor::keyQueue(const QString& key) {
+    {
+        QReadLocker locker(&m_keysLock);
+        if (m_lanes.isEmpty()) return nullptr;
+        if (KeyQueue* kq = m_keys.value(key, nullptr)) return kq;
+    }
+
+    QWriteLocker locker(&m_keysLock);
+    if (m_lanes.isEmpty()) return nullptr;
+    KeyQueue*& kq = m_keys[key]; // Another producer may have created it meanwhile
+    if (!kq) {
+        kq = new KeyQueue(key, workerForKey(key), m_queueCapacity);
+    }
+    return kq;
+}
+
+void IngestExecutor::enqueue(KeyQueue* kq, Item&& item) {
+    // tryPush leaves 'item' untouched when the queue is full
+    while (!kq->queue.tryPush(std::move(item))) {
+        const bool firstOverflow = kq->dropped.load(std::memory_order_relaxed) == 0;
+        Item evicted;
+        if (m_policy == OverflowPolicy::Coalesce) {
+            while (kq->queue.tryPop(evicted)) discard(kq, evicted);
+        }
+        else if (kq->queue.tryPop(evicted)) {
+            discard(kq, evicted);
+        }
+
+        if (firstOverflow) {
+            Log.msg(FNAME + QString("Ingress queue of %1 is full (%2), applying %3. Further drops are only counted.")
+                .arg(kq->key).arg(kq->queue.capacity()).arg(policyName(m_policy)), Logger::Level::WARNING);
+        }
+    }
+
+    const int depth = kq->queue.sizeApprox();
+    int peak = kq->peakDepth.load(std::memory_order_relaxed);
+    while (depth > peak && !kq->peakDepth.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {}
+
+    schedule(kq);
+}
+
+void IngestExecutor::discard(KeyQueue* kq, Item& evicted) {
+    if (evicted.latest) {
+        // The pending latest task goes with its token; the next postLatest() queues a new one
+        delete evicted.latest->exchange(nullptr, std::memory_order_acq_rel);
+    }
+    evicted = Item();
+    kq->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void IngestExecutor::schedule(KeyQueue* kq) {
+    // Pairs with the fence in drain(): either the worker sees the pushed task, or we see
+    // 'scheduled' cleared and post a new drain. One queued invocation per burst, not per message.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (kq->scheduled.exchange(true)) {
+        return;
+    }
+    QMetaObject::invokeMethod(m_lanes[kq->lane], [this, kq]() { drain(kq); }, Qt::QueuedConnection);
+}
+
+// Runs on the worker owning the key. Queued invocations on one lane are delivered in posting
+// order and a key is only ever drained by its own worker -> per-key FIFO is preserved.
+void IngestExecutor::drain(KeyQueue* kq) {
+    kq->scheduled.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    Item item;
+    const qint64 start = monotonicNs();
+    int i = 0;
+    for (; i < DRAIN_BATCH; ++i) {
+        if (!kq->queue.tryPop(item)) {
+            break;
+        }
+        if (item.latest) {
+            // Take the newest task of the slot; a later postLatest() then queues a new token
+            if (Task* latest = item.latest->exchange(nullptr, std::memory_order_acq_rel)) {
+                (*latest)();
+                delete latest;
+            }
+        }
+        else {
+            item.task();
+        }
+        item = Item();
+        kq->processed.fetch_add(1, std::memory_order_relaxed);
+    }
+    kq->busyNs.fetch_add(monotonicNs() - start, std::memory_order_relaxed);
+
+    // Batch used up: continue after the keys already waiting on this worker
+    if (i == DRAIN_BATCH && kq->queue.sizeApprox() > 0) {
+        schedule(kq);
+    }
+}
+
+QList<IngestExecutor::KeyStats> IngestExecutor::stats() const {
+    QList<KeyStats> result;
+    QReadLocker locker(&m_keysLock);
+    result.reserve(m_keys.size());
+    for (auto it = m_keys.constBegin(); it != m_keys.constEnd(); ++it) {
+        const KeyQueue* kq = it.value();
+        KeyStats stats;
+        stats.key = kq->key;
+        stats.enqueued = kq->enqueued.load(std::memory_order_relaxed);
+        stats.processed = kq->processed.load(std::memory_order_relaxed);
+        stats.bytes = kq->bytes.load(std::memory_order_relaxed);
+        stats.busyNs = kq->busyNs.load(std::memory_order_relaxed);
+        stats.dropped = kq->dropped.load(std::memory_order_relaxed);
+        stats.coalesced = kq->coalesced.load(std::memory_order_relaxed);
+        stats.skipped = kq->skipped.load(std::memory_order_relaxed);
+        stats.uncoalesced = kq->uncoalesced.load(std::memory_order_relaxed);
+        stats.depth = kq->queue.sizeApprox();
+        stats.peakDepth = kq->peakDepth.load(std::memory_order_relaxed);
+        result.append(stats);
+    }
+    return result;
+}
+
+int IngestExecutor::maxDepth() const {
+    QReadLocker locker(&m_keysLock);
+    int depth = 0;
+    for (const KeyQueue* kq : m_keys) {
+        depth = qMax(depth, kq->queue.sizeApprox());
+    }
+    return depth;
+}
+
+void IngestExecutor::shutdown() {
+    if (m_threads.isEmpty()) {
+        return;
+    }
+
+    for (QThread* thread : std::as_const(m_threads)) {
+        thread->quit();
+    }
+    for (QThread* thread : std::as_const(m_threads)) {
+        thread->wait();
+    }
+
+    // Threads are finished, lanes and queues can be deleted from here
+    QWriteLocker locker(&m_keysLock);
+    qDeleteAll(m_lanes);
+    qDeleteAll(m_threads);
+    qDeleteAll(m_keys);
+    m_lanes.clear();
+    m_threads.clear();
+    m_keys.clear();
+
+    Log.msg(FNAME + "Ingest executor stopped.", Logger::Level::DEBUG);
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+#include <QMutex>
+
+#include <atomic>
+#include <functional>
+
+#include "IngressQueue.h"
+
+class QThread;
+
+// Fixed pool of ingest worker threads for the decode/inflate/parse pipeline.
+//
+// Every task is posted with a key (symbol_model). A key is always routed to the
+// same worker, and each worker runs its tasks in FIFO order, so messages of one
+// key are processed strictly in arrival order while different keys run in parallel.
+//
+// Each key has its own bounded lock-free ingress queue (IngressQueue). The worker is
+// woken once per burst, not once per message, and drains the key in small batches so
+// that one busy key cannot starve the others sharing its worker. When a key's queue is
+// full the overflow policy decides what is lost; drops and queue depth are counted per key.
+//
+// postLatest() adds latest-wins coalescing for full snapshots: a key keeps at most one such task
+// per slot (the snapshot date: each expiry is its own smile) that has not started yet, and a newer
+// one for the same slot replaces it, so stale snapshots are never inflated or parsed during a burst.
+// The pending task runs where the first snapshot of the burst was queued,
+// so deltas queued behind it still follow a snapshot (older deltas are then dropped as stale by
+// their sequence number, see markSkipped).
+class IngestExecutor : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class OverflowPolicy {
+        DropOldest, // Evict the oldest queued message of the key
+        Coalesce    // Drop everything queued for the key, only the newest message is kept
+    };
+
+    struct KeyStats {
+        QString key;
+        quint64 enqueued = 0;
+        quint64 processed = 0;
+        quint64 bytes = 0;     // Payload bytes posted
+        qint64 busyNs = 0;     // Time the workers spent running tasks of this key
+        quint64 dropped = 0;   // Lost to the overflow policy
+        quint64 coalesced = 0; // Replaced by a newer postLatest() task before running
+        quint64 skipped = 0;   // Ran but found stale by the consumer (markSkipped)
+        quint64 uncoalesced = 0; // Snapshots queued with post() because they had no slot (markUncoalesced)
+        int depth = 0;     // Currently queued
+        int peakDepth = 0; // Highest depth seen
+    };
+
+    explicit IngestExecutor(int workerCount, int queueCapacity = 64,
+        OverflowPolicy policy = OverflowPolicy::DropOldest, QObject* parent = nullptr);
+    ~IngestExecutor() override;
+
+    int workerCount() const;
+    int workerForKey(const QString& key) const;
+    int queueCapacity() const { return m_queueCapacity; }
+    OverflowPolicy overflowPolicy() const { return m_policy; }
+
+    // Queue a task on the worker that owns 'key'. Thread-safe, never blocks on a full queue.
+    // 'bytes' (payload size) only feeds the statistics. Returns false if the task was rejected (executor shut down).
+    bool post(const QString& key, std::function<void()> task, qsizetype bytes = 0);
+    // Latest-wins: replaces the task of 'key' and 'slot' that was posted this way and has not started yet.
+    // Tasks of other slots of the key are kept.
+    bool postLatest(const QString& key, qint64 slot, std::function<void()> task, qsizetype bytes = 0);
+    // Counts a message of 'key' the consumer dropped as stale without decoding it. Thread-safe.
+    void markSkipped(const QString& key);
+    // Counts a snapshot of 'key' that had to be posted without latest-wins (no slot known). Thread-safe.
+    void markUncoalesced(const QString& key);
+
+    // Counters of every key seen so far. Thread-safe, only relaxed atomic loads per key.
+    QList<KeyStats> stats() const;
+    // Deepest queue over all keys, a cheap backpressure signal. Thread-safe.
+    int maxDepth() const;
+
+    // Stops all workers (pending tasks are dropped). Safe to call more than once.
+    void shutdown();
+
+    static QString policyName(OverflowPolicy policy);
+    static bool policyFromName(const QString& name, OverflowPolicy& outPolicy);
+
+private:
+    using Task = std::function<void()>;
+
+    using LatestSlot = std::atomic<Task*>; // Newest postLatest() task of a slot, a token for it is queued while set
+
+    struct Item {
+        Task task;
+        LatestSlot* latest = nullptr; // Token: runs the pending task of this slot instead of 'task'
+    };
+
+    struct KeyQueue {
+        KeyQueue(const QString& k, int lane, int capacity) : key(k), lane(lane), queue(capacity) {}
+        ~KeyQueue() {
+            for (LatestSlot* slot : std::as_const(latest)) {
+                delete slot->load();
+                delete slot;
+            }
+        }
+
+        // Slot of postLatest(), created on first use and never removed while running
+        LatestSlot* latestSlot(qint64 slot);
+
+        const QString key;
+        const int lane;
+        IngressQueue<Item> queue;
+        QHash<qint64, LatestSlot*> latest; // Guarded by latestMutex (lookup only, the slots themselves are atomic)
+        QMutex latestMutex;
+        std::atomic<bool> scheduled{ false }; // A drain of this key is pending on its worker
+        std::atomic<quint64> enqueued{ 0 };
+        std::atomic<quint64> processed{ 0 };
+        std::atomic<quint64> bytes{ 0 };
+        std::atomic<qint64> busyNs{ 0 };
+        std::atomic<quint64> dropped{ 0 };
+        std::atomic<quint64> coalesced{ 0 };
+        std::atomic<quint64> skipped{ 0 };
+        std::atomic<quint64> uncoalesced{ 0 };
+        std::atomic<int> peakDepth{ 0 };
+    };
+
+    KeyQueue* keyQueue(const QString& key);
+    void enqueue(KeyQueue* kq, Item&& item);
+    void discard(KeyQueue* kq, Item& evicted);
+    void schedule(KeyQueue* kq);
+    void drain(KeyQueue* kq);
+
+    // Tasks run per drain before the key yields its worker to the other keys
+    static const int DRAIN_BATCH = 8;
+
+    const int m_queueCapacity;
+    const OverflowPolicy m_policy;
+    QVector<QThread*> m_threads;
+    QVector<QObject*> m_lanes; // One context object per worker, lives in m_threads[i]
+
+    QHash<QString, KeyQueue*> m_keys; // Never removed while running, so lookups can hand out pointers
+    mutable QReadWriteLock m_keysLock;
+};
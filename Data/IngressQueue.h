@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <utility>
+
+// Bounded lock-free multi-producer/multi-consumer ring (D. Vyukov's bounded MPMC queue).
+//
+// Every cell carries a sequence number: a producer may write cell i when its sequence equals
+// the enqueue position, a consumer may read it when it equals the position + 1. Positions are
+// claimed with one CAS, so push/pop never block and never allocate after construction.
+//
+// Used as the per symbol/model ingress queue of IngestExecutor: the network thread pushes, the
+// owning ingest worker pops, and the network thread itself may pop to evict on overflow.
+template <typename T>
+class IngressQueue {
+public:
+    // 'capacity' is rounded up to a power of two (minimum 2)
+    explicit IngressQueue(int capacity) {
+        qsizetype size = 2;
+        while (size < capacity) size <<= 1;
+        m_mask = size - 1;
+        m_cells.reset(new Cell[size]);
+        for (qsizetype i = 0; i < size; ++i) {
+            m_cells[i].sequence.store(size_t(i), std::memory_order_relaxed);
+        }
+    }
+
+    IngressQueue(const IngressQueue&) = delete;
+    IngressQueue& operator=(const IngressQueue&) = delete;
+
+    int capacity() const { return int(m_mask + 1); }
+
+    // False when full ('value' is left untouched)
+    bool tryPush(T&& value) {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & m_mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false; // Full
+            }
+            else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // False when empty
+    bool tryPop(T& out) {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & m_mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = intptr_t(sequence) - intptr_t(pos + 1);
+            if (diff == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(cell.value);
+                    cell.value = T(); // Release what the cell holds now, not when it is overwritten
+                    cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false; // Empty
+            }
+            else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Approximate number of queued items (exact when no push/pop is in flight)
+    int sizeApprox() const {
+        const size_t enqueued = m_enqueuePos.load(std::memory_order_relaxed);
+        const size_t dequeued = m_dequeuePos.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? int(enqueued - dequeued) : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{ 0 };
+        T value{};
+    };
+
+    // Producer and consumer positions on separate cache lines
+    static constexpr size_t CacheLine = 64;
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask = 0;
+    alignas(CacheLine) std::atomic<size_t> m_enqueuePos{ 0 };
+    alignas(CacheLine) std::atomic<size_t> m_dequeuePos{ 0 };
+};
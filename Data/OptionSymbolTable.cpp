@@ -0,0 +1,45 @@
+#include "OptionSymbolTable.h"
+
+#include <QReadLocker>
+#include <QWriteLocker>
+
+quint32 OptionSymbolTable::intern(const char* utf8, qsizetype size) {
+    if (!utf8 || size <= 0) {
+        return InvalidId;
+    }
+
+    // fromRawData does not copy: lookup of an already known symbol is allocation free
+    const QByteArray key = QByteArray::fromRawData(utf8, size);
+    {
+        QReadLocker locker(&m_lock);
+        auto it = m_ids.constFind(key);
+        if (it != m_ids.constEnd()) {
+            return it.value();
+        }
+    }
+
+    QWriteLocker locker(&m_lock);
+    auto it = m_ids.constFind(key); // Another worker may have added it meanwhile
+    if (it != m_ids.constEnd()) {
+        return it.value();
+    }
+    const quint32 id = static_cast<quint32>(m_symbols.size());
+    m_ids.insert(QByteArray(utf8, size), id); // Deep copy for the stored key
+    m_symbols.append(QString::fromUtf8(utf8, size));
+    return id;
+}
+
+quint32 OptionSymbolTable::intern(const QString& symbol) {
+    const QByteArray utf8 = symbol.toUtf8();
+    return intern(utf8.constData(), utf8.size());
+}
+
+QString OptionSymbolTable::symbol(quint32 id) const {
+    QReadLocker locker(&m_lock);
+    return (id < static_cast<quint32>(m_symbols.size())) ? m_symbols.at(id) : QString();
+}
+
+qsizetype OptionSymbolTable::size() const {
+    QReadLocker locker(&m_lock);
+    return m_symbols.size();
+}
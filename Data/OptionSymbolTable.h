@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+// Process-wide intern table for option symbols (e.g. "AAPL2025-04-17100.0p").
+// Smile columns store a 32-bit id instead of a QString per row; the text is only
+// looked up when a tooltip or click needs it. Append-only: ids stay valid for the
+// lifetime of the process. Thread-safe (ingest workers intern, GUI thread reads).
+class OptionSymbolTable {
+public:
+    OptionSymbolTable(const OptionSymbolTable&) = delete;
+    OptionSymbolTable& operator=(const OptionSymbolTable&) = delete;
+
+    static constexpr quint32 InvalidId = 0xFFFFFFFFu;
+
+    static OptionSymbolTable& instance() {
+        static OptionSymbolTable table; // Guaranteed to be destroyed and thread-safe
+        return table;
+    }
+
+    // Returns the id of the UTF-8 symbol, adding it if it is new. No allocation for known symbols.
+    quint32 intern(const char* utf8, qsizetype size);
+    quint32 intern(const QString& symbol);
+
+    // Returns the symbol text for an id (empty for unknown ids)
+    QString symbol(quint32 id) const;
+
+    qsizetype size() const;
+
+private:
+    OptionSymbolTable() = default;
+    ~OptionSymbolTable() = default;
+
+    mutable QReadWriteLock m_lock;
+    QHash<QByteArray, quint32> m_ids; // UTF-8 symbol -> id
+    QVector<QString> m_symbols;       // id -> symbol
+};
@@ -0,0 +1,298 @@
+#include "SmileCsvParser.h"
+#include "Glob/Logger.h"
+#include "SmileDelta.h"
+
+#include <QVector>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+    const char* const FIELD_NAMES[SmileCsvParser::FieldCount] = {
+        "snap_shot_dates", "log_moneyness", "theo_ivs", "mid_iv", "bid_iv",
+        "ask_iv", "strikes", "symbol", "bid_prices", "ask_prices", "op"
+    };
+
+    inline bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    // Trim spaces/tabs/CR on both sides of [begin, end)
+    inline void trimSpan(const char*& begin, const char*& end) {
+        while (begin < end && isBlank(*begin)) ++begin;
+        while (end > begin && isBlank(*(end - 1))) --end;
+    }
+
+    inline bool toDouble(const char* begin, const char* end, double& out) {
+        if (begin == end) return false;
+        auto result = std::from_chars(begin, end, out);
+        return result.ec == std::errc() && result.ptr == end;
+    }
+
+} // namespace
+
+const char* SmileCsvParser::fieldName(Field field) {
+    return (field >= 0 && field < FieldCount) ? FIELD_NAMES[field] : "";
+}
+
+bool SmileCsvParser::parse(const QByteArray& csvData, QDate& outDate, PlotDataForDate& outPlotData) {
+    return parse(csvData.constData(), csvData.size(), outDate, outPlotData);
+}
+
+bool SmileCsvParser::parse(const QByteArray& csvData, QDate& outDate, PlotDataForDate& outPlotData, QVector<quint8>& outOps) {
+    return parse(csvData.constData(), csvData.size(), outDate, outPlotData, &outOps);
+}
+
+bool SmileCsvParser::parse(const char* data, qsizetype size, QDate& outDate, PlotDataForDate& outPlotData) {
+    return parse(data, size, outDate, outPlotData, nullptr);
+}
+
+bool SmileCsvParser::parse(const char* data, qsizetype size, QDate& outDate, PlotDataForDate& outPlotData,
+    QVector<quint8>* outOps) {
+    outDate = QDate(); // Reset date
+
+    SmileCsvParser parser(outPlotData, outOps);
+    if (!data || size <= 0) {
+        Log.msg(FNAME + "CSV data is empty.", Logger::Level::WARNING);
+        return false;
+    }
+
+    // One vectorised pass to size the output vectors (rows ~= newlines)
+    parser.m_reserveRows = std::count(data, data + size, '\n') + 1;
+
+    const char* tail = parser.parseLines(data, data + size);
+    if (parser.m_failed) {
+        return false;
+    }
+    if (tail < data + size && !parser.parseLine(tail, data + size)) {
+        return false;
+    }
+    return parser.finish(outDate);
+}
+
+SmileCsvParser::SmileCsvParser(PlotDataForDate& outPlotData, QVector<quint8>* outOps)
+    : m_out(outPlotData), m_ops(outOps) {
+    m_out.clear();
+    if (m_ops) m_ops->clear();
+}
+
+bool SmileCsvParser::feed(const char* data, qsizetype size) {
+    if (m_failed || size <= 0) {
+        return !m_failed;
+    }
+    const char* pos = data;
+    const char* const end = data + size;
+
+    // Complete the line left over from the previous chunk
+    if (!m_carry.isEmpty()) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+        if (!lineEnd) {
+            m_carry.append(pos, end - pos);
+            return true;
+        }
+        m_carry.append(pos, lineEnd - pos);
+        pos = lineEnd + 1;
+        if (!parseLine(m_carry.constData(), m_carry.constData() + m_carry.size())) {
+            m_failed = true;
+            return false;
+        }
+        m_carry.clear(); // Keeps the capacity
+    }
+
+    const char* tail = parseLines(pos, end);
+    if (m_failed) {
+        return false;
+    }
+    if (tail < end) {
+        m_carry.append(tail, end - tail);
+    }
+    return true;
+}
+
+bool SmileCsvParser::finish(QDate& outDate) {
+    outDate = QDate();
+    if (m_failed) {
+        return false;
+    }
+    if (!m_carry.isEmpty()) {
+        const bool ok = parseLine(m_carry.constData(), m_carry.constData() + m_carry.size());
+        m_carry.clear();
+        if (!ok) return false;
+    }
+
+    if (!m_headerParsed || m_lineNum < 2) { // Need header + data
+        Log.msg(FNAME + "CSV data has too few lines (< 2).", Logger::Level::WARNING);
+        return false;
+    }
+    if (m_out.isEmpty()) {
+        Log.msg(FNAME + "No valid data points parsed from CSV.", Logger::Level::WARNING);
+        return false;
+    }
+    if (!m_dateParsed) {
+        Log.msg(FNAME + "No valid date found in CSV data.", Logger::Level::ERROR);
+        return false;
+    }
+
+    outDate = m_date;
+    return true; // Success
+}
+
+const char* SmileCsvParser::parseLines(const char* begin, const char* end) {
+    const char* pos = begin;
+    while (pos < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+        if (!lineEnd) break; // Unterminated, left to the caller
+
+        if (!parseLine(pos, lineEnd)) {
+            m_failed = true;
+            break;
+        }
+        pos = lineEnd + 1;
+    }
+    return pos;
+}
+
+bool SmileCsvParser::parseLine(const char* begin, const char* end) {
+    trimSpan(begin, end);
+    if (begin == end) return true; // Skip empty lines
+    m_lineNum++;
+
+    if (!m_headerParsed) {
+        if (!parseHeader(begin, end)) {
+            return false;
+        }
+        m_headerParsed = true;
+
+        if (m_reserveRows > 0) {
+            m_out.reserve(m_reserveRows);
+            if (m_ops) m_ops->reserve(m_reserveRows);
+        }
+        return true;
+    }
+
+    parseRow(begin, end);
+    if (m_lineNum == 2 && !m_dateParsed) {
+        return false; // Date of the first row is mandatory, error already logged
+    }
+    return true;
+}
+
+// Resolves required column names into field slots. Called once per CSV.
+bool SmileCsvParser::parseHeader(const char* begin, const char* end) {
+    m_columnToField.clear();
+
+    int foundMask = 0;
+    const char* fieldBegin = begin;
+    while (true) {
+        const char* comma = static_cast<const char*>(std::memchr(fieldBegin, ',', end - fieldBegin));
+        const char* fieldEnd = comma ? comma : end;
+
+        const char* nameBegin = fieldBegin;
+        const char* nameEnd = fieldEnd;
+        trimSpan(nameBegin, nameEnd);
+        const size_t nameLen = static_cast<size_t>(nameEnd - nameBegin);
+
+        qint8 slot = -1;
+        for (int f = 0; f < FieldCount; ++f) {
+            if (std::strlen(FIELD_NAMES[f]) == nameLen && std::memcmp(FIELD_NAMES[f], nameBegin, nameLen) == 0) {
+                // Last occurrence wins for duplicated column names (same as the old QMap lookup)
+                if (foundMask & (1 << f)) {
+                    m_columnToField[m_columnToField.lastIndexOf(static_cast<qint8>(f))] = -1;
+                }
+                slot = static_cast<qint8>(f);
+                foundMask |= (1 << f);
+                break;
+            }
+        }
+        m_columnToField.append(slot);
+
+        if (!comma) break;
+        fieldBegin = comma + 1;
+    }
+    Log.msg(FNAME + "Parsed header with " + QString::number(m_columnToField.size()) + " columns.", Logger::Level::DEBUG);
+
+    for (int f = 0; f < FieldCount; ++f) {
+        if (!(foundMask & (1 << f)) && !isOptional(f)) {
+            Log.msg(FNAME + "CSV header is missing required column: '" + QString::fromLatin1(FIELD_NAMES[f]) + "'.",
+                Logger::Level::ERROR);
+            return false; // Cannot proceed without required columns
+        }
+    }
+    return true;
+}
+
+void SmileCsvParser::parseRow(const char* begin, const char* end) {
+    Span spans[FieldCount];
+
+    // --- Locate required fields in a single pass over the row ---
+    const int columnCount = m_columnToField.size();
+    const char* fieldBegin = begin;
+    for (int column = 0; column < columnCount; ++column) {
+        const char* comma = static_cast<const char*>(std::memchr(fieldBegin, ',', end - fieldBegin));
+        const char* fieldEnd = comma ? comma : end;
+
+        const qint8 slot = m_columnToField[column];
+        if (slot >= 0) {
+            const char* b = fieldBegin;
+            const char* e = fieldEnd;
+            trimSpan(b, e);
+            spans[slot].begin = b;
+            spans[slot].end = e;
+        }
+
+        if (!comma) break; // Short row: missing fields stay empty
+        fieldBegin = comma + 1;
+    }
+
+    // --- Parse Date (first data row only) ---
+    if (!m_dateParsed) {
+        const Span& dateSpan = spans[SnapshotDate];
+        QString dateStr = QString::fromLatin1(dateSpan.begin, dateSpan.end - dateSpan.begin);
+        m_date = QDate::fromString(dateStr, Qt::ISODate);
+        if (!m_date.isValid()) {
+            Log.msg(FNAME + "Failed to parse snapshot date from first data row: " + dateStr, Logger::Level::ERROR);
+            return;
+        }
+        m_dateParsed = true;
+        Log.msg(FNAME + "Parsed snapshot date: " + m_date.toString(Qt::ISODate), Logger::Level::DEBUG);
+    }
+
+    // --- Parse Delta Op (upsert when the column is absent or empty) ---
+    quint8 op = SmileDelta::OpUpsert;
+    if (m_ops && !SmileDelta::parseOp(spans[Op].begin, spans[Op].end, op)) {
+        Log.msg(FNAME + "Skipping line " + QString::number(m_lineNum) + ": Invalid op value.", Logger::Level::WARNING);
+        return;
+    }
+
+    // --- Parse Numeric Values ---
+    double values[FieldCount] = {};
+    static const Field numericFields[] = { LogMoneyness, TheoIv, MidIv, BidIv, AskIv, Strike, BidPrice, AskPrice };
+    for (Field field : numericFields) {
+        if (op == SmileDelta::OpDelete) break; // Only the option symbol matters for a delete
+        if (!toDouble(spans[field].begin, spans[field].end, values[field])) {
+            Log.msg(FNAME + "Skipping line " + QString::number(m_lineNum) +
+                ": Invalid " + QString::fromLatin1(FIELD_NAMES[field]) + " value.", Logger::Level::WARNING);
+            return;
+        }
+    }
+
+    const Span& symbolSpan = spans[OptionSymbol];
+    if (symbolSpan.begin == symbolSpan.end) {
+        Log.msg(FNAME + "Skipping line " + QString::number(m_lineNum) +
+            ": Missing option symbol.", Logger::Level::WARNING);
+        return;
+    }
+
+    // Append one value per column; the symbol text is interned, not copied per row
+    m_out.logMoneyness.append(values[LogMoneyness]);
+    m_out.strike.append(values[Strike]);
+    m_out.theoIv.append(values[TheoIv]);
+    m_out.midIv.append(values[MidIv]);
+    m_out.bidIv.append(values[BidIv]);
+    m_out.askIv.append(values[AskIv]);
+    m_out.bidPrice.append(values[BidPrice]);
+    m_out.askPrice.append(values[AskPrice]);
+    m_out.symbolId.append(OptionSymbolTable::instance().intern(symbolSpan.begin, symbolSpan.end - symbolSpan.begin));
+    if (m_ops) m_ops->append(op);
+}
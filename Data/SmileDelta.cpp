@@ -0,0 +1,205 @@
+#include "SmileDelta.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace SmileDelta {
+
+namespace {
+
+    // Calls f(column) for every column of the smile, numeric and symbol id alike
+    template <typename F>
+    void forEachColumn(PlotDataForDate& data, F&& f) {
+        f(data.logMoneyness); f(data.strike);
+        f(data.theoIv); f(data.midIv); f(data.bidIv); f(data.askIv);
+        f(data.bidPrice); f(data.askPrice);
+        f(data.symbolId);
+    }
+
+    // Writes 'value' only if it differs (NaN equals NaN): an unchanged column stays shared with the base
+    template <typename T>
+    bool writeCell(QVector<T>& column, qsizetype row, T value) {
+        const T current = column.at(row);
+        if (current == value || (current != current && value != value)) return false;
+        column[row] = value; // Detaches the column on its first write
+        return true;
+    }
+
+    // True if any field of the row changed
+    bool writeRow(PlotDataForDate& data, qsizetype row, const PlotDataForDate& src, qsizetype srcRow) {
+        bool changed = writeCell(data.logMoneyness, row, src.logMoneyness.at(srcRow));
+        changed |= writeCell(data.strike, row, src.strike.at(srcRow));
+        changed |= writeCell(data.theoIv, row, src.theoIv.at(srcRow));
+        changed |= writeCell(data.midIv, row, src.midIv.at(srcRow));
+        changed |= writeCell(data.bidIv, row, src.bidIv.at(srcRow));
+        changed |= writeCell(data.askIv, row, src.askIv.at(srcRow));
+        changed |= writeCell(data.bidPrice, row, src.bidPrice.at(srcRow));
+        changed |= writeCell(data.askPrice, row, src.askPrice.at(srcRow));
+        // symbolId is the row key: equal by construction
+        return changed;
+    }
+
+    void appendRow(PlotDataForDate& data, const PlotDataForDate& src, qsizetype srcRow) {
+        data.logMoneyness.append(src.logMoneyness[srcRow]);
+        data.strike.append(src.strike[srcRow]);
+        data.theoIv.append(src.theoIv[srcRow]);
+        data.midIv.append(src.midIv[srcRow]);
+        data.bidIv.append(src.bidIv[srcRow]);
+        data.askIv.append(src.askIv[srcRow]);
+        data.bidPrice.append(src.bidPrice[srcRow]);
+        data.askPrice.append(src.askPrice[srcRow]);
+        data.symbolId.append(src.symbolId[srcRow]);
+    }
+
+    // Reorders every column by ascending log-moneyness (stable)
+    void sortByX(PlotDataForDate& data) {
+        QVector<qsizetype> order(data.size());
+        std::iota(order.begin(), order.end(), 0);
+        const double* x = data.logMoneyness.constData();
+        std::stable_sort(order.begin(), order.end(), [x](qsizetype a, qsizetype b) { return x[a] < x[b]; });
+        forEachColumn(data, [&](auto& column) {
+            auto sorted = column;
+            for (qsizetype row = 0; row < order.size(); ++row) {
+                sorted[row] = column[order[row]];
+            }
+            column = std::move(sorted);
+        });
+    }
+
+    // True if row's x still lies between its neighbours'
+    bool inOrder(const QVector<double>& x, qsizetype row) {
+        return (row == 0 || !(x[row] < x[row - 1])) && (row + 1 == x.size() || !(x[row + 1] < x[row]));
+    }
+
+    bool equalsToken(const char* begin, const char* end, const char* token) {
+        const size_t len = std::strlen(token);
+        return static_cast<size_t>(end - begin) == len && std::memcmp(begin, token, len) == 0;
+    }
+
+} // namespace
+
+QHash<quint32, qsizetype> buildIndex(const PlotDataForDate& data) {
+    QHash<quint32, qsizetype> index;
+    index.reserve(data.symbolId.size());
+    for (qsizetype row = 0; row < data.symbolId.size(); ++row) {
+        index.insert(data.symbolId[row], row);
+    }
+    return index;
+}
+
+bool parseOp(const char* begin, const char* end, quint8& outOp) {
+    if (begin == end || equalsToken(begin, end, "upsert") || equalsToken(begin, end, "u") || equalsToken(begin, end, "U")) {
+        outOp = OpUpsert;
+        return true;
+    }
+    if (equalsToken(begin, end, "delete") || equalsToken(begin, end, "d") || equalsToken(begin, end, "D")) {
+        outOp = OpDelete;
+        return true;
+    }
+    return false;
+}
+
+void apply(PlotDataForDate& data, QHash<quint32, qsizetype>& index,
+    const PlotDataForDate& rows, const QVector<quint8>& ops, Result& result) {
+    result = Result();
+
+    const qsizetype baseRows = data.size();
+    QVector<bool> removed;                   // Allocated on the first delete only
+    QVector<qsizetype> inserts;              // Delta rows to append, -1 = cancelled
+    QHash<quint32, qsizetype> pendingInsert; // Symbol id -> position in 'inserts'
+
+    // Checked on the base: the updates below may move x out of order
+    const bool wasSorted = std::is_sorted(data.logMoneyness.cbegin(), data.logMoneyness.cend());
+
+    // --- In place updates, collect deletes/inserts ---
+    for (qsizetype i = 0; i < rows.size(); ++i) {
+        const quint32 id = rows.symbolId.value(i, OptionSymbolTable::InvalidId);
+        if (id == OptionSymbolTable::InvalidId) continue;
+        const quint8 op = ops.value(i, OpUpsert);
+
+        auto it = index.constFind(id);
+        if (it != index.constEnd()) {
+            const qsizetype row = it.value();
+            if (op == OpDelete) {
+                if (removed.isEmpty()) removed.fill(false, baseRows);
+                if (!removed[row]) {
+                    removed[row] = true;
+                    ++result.deleted;
+                }
+                continue;
+            }
+            if (!removed.isEmpty() && removed[row]) { // Deleted and re-added in the same delta
+                removed[row] = false;
+                --result.deleted;
+            }
+            if (writeRow(data, row, rows, i)) {
+                result.changedRows.append(row);
+                ++result.updated;
+            }
+        }
+        else {
+            auto pending = pendingInsert.find(id);
+            if (op == OpDelete) {
+                if (pending != pendingInsert.end()) inserts[pending.value()] = -1; // Insert cancelled
+                continue;
+            }
+            if (pending != pendingInsert.end()) inserts[pending.value()] = i; // Last upsert wins
+            else {
+                pendingInsert.insert(id, inserts.size());
+                inserts.append(i);
+            }
+        }
+    }
+    for (qsizetype i : inserts) {
+        if (i >= 0) ++result.inserted;
+    }
+
+    // An update that moved a row past its neighbours (all updates are written by now)
+    bool reordered = false;
+    if (wasSorted) {
+        for (qsizetype row : std::as_const(result.changedRows)) {
+            if (!inOrder(data.logMoneyness, row)) {
+                reordered = true;
+                break;
+            }
+        }
+    }
+
+    if (result.inserted == 0 && result.deleted == 0 && !reordered) {
+        // Sort and dedupe so consumers can walk the rows in order
+        std::sort(result.changedRows.begin(), result.changedRows.end());
+        result.changedRows.erase(std::unique(result.changedRows.begin(), result.changedRows.end()), result.changedRows.end());
+        return; // Layout unchanged: 'index' is still valid
+    }
+
+    // --- Layout changed: compact deletes, append inserts, then restore the log-moneyness order ---
+    result.structural = true;
+    result.changedRows.clear();
+
+    if (result.deleted > 0) {
+        forEachColumn(data, [&](auto& column) {
+            qsizetype out = 0;
+            for (qsizetype row = 0; row < baseRows; ++row) {
+                if (!removed[row]) column[out++] = column[row];
+            }
+            column.resize(out);
+        });
+    }
+
+    if (result.inserted > 0) {
+        data.reserve(data.size() + result.inserted);
+        for (qsizetype i : inserts) {
+            if (i >= 0) appendRow(data, rows, i);
+        }
+    }
+
+    // Keep the smile ordered by x so the theo line is still drawn left to right
+    if (wasSorted && (result.inserted > 0 || reordered)) {
+        sortByX(data);
+    }
+
+    index = buildIndex(data);
+}
+
+} // namespace SmileDelta
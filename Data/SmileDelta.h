@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QHash>
+#include <QVector>
+
+#include "Plots/PlotDataForDate.h"
+
+// Incremental smile updates ("delta" mode of data_stream / FlagDelta binary frames).
+//
+// A delta carries only the rows that changed since the previous message of the same
+// symbol/model, each with an operation keyed by the option symbol:
+//   upsert - replace the row with the same option symbol, or insert it if it is new
+//   delete - remove the row with that option symbol (numeric fields are ignored)
+// Deltas are numbered; ClientReceiver checks the sequence and asks for a fresh
+// snapshot when one is missing.
+namespace SmileDelta {
+
+    enum Op : quint8 {
+        OpUpsert = 0,
+        OpDelete = 1
+    };
+
+    struct Result {
+        // Rows rewritten in place (same row layout as the base). Empty if the layout changed.
+        QVector<qsizetype> changedRows;
+        bool structural = false; // Rows were inserted, deleted or reordered: consumers must refresh everything
+        int updated = 0;
+        int inserted = 0;
+        int deleted = 0;
+
+        bool isEmpty() const { return updated == 0 && inserted == 0 && deleted == 0; }
+    };
+
+    // Option symbol id -> row
+    QHash<quint32, qsizetype> buildIndex(const PlotDataForDate& data);
+
+    // Parses an op token from the CSV 'op' column ("upsert"/"u", "delete"/"d", empty = upsert)
+    bool parseOp(const char* begin, const char* end, quint8& outOp);
+
+    // Applies 'rows' (with one op per row, missing ops = upsert) on top of 'data'.
+    // 'data' is usually a shallow copy of the published snapshot: an upsert writes only the fields
+    // whose value changed, so only those columns get detached (any insert or delete rewrites all).
+    // An upsert that changes nothing is not counted in 'updated'. A smile sorted by log-moneyness stays sorted:
+    // inserts and updates that move a row's x out of order re-sort all rows (structural).
+    // 'index' must describe 'data' and is kept up to date.
+    void apply(PlotDataForDate& data, QHash<quint32, qsizetype>& index,
+        const PlotDataForDate& rows, const QVector<quint8>& ops, Result& result);
+
+} // namespace SmileDelta
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QString>
+#include <QDate>
+#include <QSharedPointer>
+#include <QMetaType>
+#include <QHash>
+#include <QVector>
+
+#include "Plots/PlotDataForDate.h"
+#include "Glob/Trace.h"
+
+// One parsed smile for (symbol, model, date), published once by ClientReceiver.
+// Snapshots are immutable after publish: every chart window shares the same instance
+// through SmileSnapshotPtr, so memory does not grow with the number of open windows.
+struct SmileSnapshot {
+    QString symbol;
+    QString model;
+    QDate date;
+    quint64 version = 0; // Increments with every publish for the same (symbol, model, date)
+    PlotDataForDate data;
+
+    // Set when this version was produced by a delta that kept the row layout: rows that differ
+    // from version - 1. Empty means consumers must refresh everything.
+    QVector<qsizetype> changedRows;
+    // Option symbol id -> row of 'data', used to apply the next delta (shared between versions)
+    QHash<quint32, qsizetype> rowBySymbol;
+
+    // Timestamps of the message this version was built from (untraced when tracing is off)
+    Trace::Timeline trace;
+};
+
+using SmileSnapshotPtr = QSharedPointer<const SmileSnapshot>;
+
+Q_DECLARE_METATYPE(SmileSnapshotPtr)
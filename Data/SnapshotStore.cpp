@@ -0,0 +1,61 @@
+#include "SnapshotStore.h"
+#include "SmileDelta.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+
+SmileSnapshotPtr SnapshotStore::publish(const QString& symbol, const QString& model, const QDate& date,
+    PlotDataForDate&& plotData, const Trace::Timeline& trace) {
+    Trace::Scope scope(Trace::Stage::Publish);
+    QSharedPointer<SmileSnapshot> snapshot = QSharedPointer<SmileSnapshot>::create();
+    snapshot->symbol = symbol;
+    snapshot->model = model;
+    snapshot->date = date;
+    snapshot->data = std::move(plotData);
+    snapshot->rowBySymbol = SmileDelta::buildIndex(snapshot->data);
+    snapshot->trace = trace;
+    if (trace.isValid()) snapshot->trace.publishNs = Trace::now();
+    return store(snapshot);
+}
+
+SmileSnapshotPtr SnapshotStore::store(QSharedPointer<SmileSnapshot> snapshot) {
+    QMutexLocker locker(&m_mutex);
+    SmileSnapshotPtr& slot = m_store[streamKey(snapshot->symbol, snapshot->model)][snapshot->date];
+    snapshot->version = slot ? slot->version + 1 : 1;
+    slot = snapshot;
+    return snapshot;
+}
+
+SmileSnapshotPtr SnapshotStore::latest(const QString& symbol, const QString& model, const QDate& date) const {
+    QMutexLocker locker(&m_mutex);
+    // Use value() to avoid creating empty maps if symbol/date doesn't exist
+    return m_store.value(streamKey(symbol, model)).value(date);
+}
+
+QList<SmileSnapshotPtr> SnapshotStore::all() const {
+    QMutexLocker locker(&m_mutex);
+    QList<SmileSnapshotPtr> snapshots;
+    for (const auto& dateMap : m_store) {
+        snapshots.append(dateMap.values());
+    }
+    return snapshots;
+}
+
+QStringList SnapshotStore::symbols() const {
+    QMutexLocker locker(&m_mutex);
+    QStringList symbols;
+    for (const auto& dateMap : m_store) {
+        if (!dateMap.isEmpty() && !symbols.contains(dateMap.first()->symbol)) {
+            symbols.append(dateMap.first()->symbol);
+        }
+    }
+    return symbols;
+}
+
+QList<QDate> SnapshotStore::dates(const QString& symbol, const QString& model) const {
+    QMutexLocker locker(&m_mutex);
+    QList<QDate> dates = m_store.value(streamKey(symbol, model)).keys();
+    std::sort(dates.begin(), dates.end());
+    return dates;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QDate>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+
+#include "Plots/PlotDataForDate.h"
+#include "SmileSnapshot.h"
+#include "Glob/Trace.h"
+
+// Latest published smile per (symbol, model, date), as held by ClientReceiver.
+// Every publish replaces the previous version, which is released as soon as the last window holding it
+// moves on. Thread-safe: written by the ingest workers, read by the GUI.
+class SnapshotStore
+{
+public:
+    // Key of a symbol/model stream ("symbol_model")
+    static QString streamKey(const QString& symbol, const QString& model) { return symbol + "_" + model; }
+
+    // Wraps freshly parsed data into an immutable snapshot (with its delta index) and stores it
+    SmileSnapshotPtr publish(const QString& symbol, const QString& model, const QDate& date, PlotDataForDate&& plotData,
+        const Trace::Timeline& trace = Trace::Timeline());
+    // Stores a snapshot built by the caller (a delta applied to the previous version), numbering its version
+    SmileSnapshotPtr store(QSharedPointer<SmileSnapshot> snapshot);
+
+    // Latest snapshot, null if none
+    SmileSnapshotPtr latest(const QString& symbol, const QString& model, const QDate& date) const;
+    QList<SmileSnapshotPtr> all() const;
+    QStringList symbols() const;
+    // Sorted expiration dates of a symbol/model
+    QList<QDate> dates(const QString& symbol, const QString& model) const;
+
+private:
+    // Stream (symbol_model) -> ExpirationDate -> Snapshot.
+    // Two models of one symbol are separate smiles, with their own versions.
+    QMap<QString, QMap<QDate, SmileSnapshotPtr>> m_store;
+    mutable QMutex m_mutex;
+};
@@ -1,10 +1,10 @@
-#pragma once
-
-#define NAME_PROGRAM_FULL "DataAlpha"
-#define NAME_PROGRAM_SHORT "DA"
-
-#define NAME_COMPANY "IntegralAlpha"
-
-#define VERSION "0.0.1"
-
-#define CONF_FILE "conf.ini"
+#pragma once
+
+#define NAME_PROGRAM_FULL "DataAlpha"
+#define NAME_PROGRAM_SHORT "DA"
+
+#define NAME_COMPANY "IntegralAlpha"
+
+#define VERSION "0.0.1"
+
+#define CONF_FILE "conf.ini"
@@ -1,95 +1,242 @@
-#include "Config.h"
-#include "Glob/Logger.h" // Include Logger
-#include "../Defines.h"
-
-#include <QCoreApplication>
-#include <QSettings>
-#include <QDir>
-#include <QFileInfo>
-#include <QVariant>
-#include <QUrl>
-#include <QMessageBox> // Optional for error display
-
-namespace Config {
-
-    // Helper function to get the application config file path
-    QString getAppConfigPath() {
-        return QCoreApplication::applicationDirPath() + "/DataAlpha.ini";
-    }
-
-    void initializeUserSettingsDefaults() {
-        // Set defaults for USER state settings (AppData)
-        QCoreApplication::setOrganizationName(NAME_COMPANY);
-        QCoreApplication::setApplicationName(NAME_PROGRAM_FULL);
-        // Set the default format to INI for all QSettings instances
-        QSettings::setDefaultFormat(QSettings::IniFormat);
-    }
-
-    QVariant getAppSetting(const QString& section, const QString& key, const QVariant& defaultValue) {
-        QString configPath = getAppConfigPath();
-        QSettings appSettings(configPath, QSettings::IniFormat);
-
-        QFileInfo configFileInfo(configPath);
-        if (!configFileInfo.exists() || !configFileInfo.isReadable()) {
-            // Log only once per missing file check maybe? Or use a flag.
-            // For simplicity, log each time for now.
-            QString msg = "App config file not found or not readable: " + configPath + 
-                ". Returning default for " + section + "/" + key;
-            QMessageBox::warning(nullptr, "Error", msg);
-            return defaultValue;
-        }
-
-        QString settingsKey = section + "/" + key;
-        return appSettings.value(settingsKey, defaultValue);
-    }
-
-    QUrl getWebSocketUrl() {
-        QString key = "WebSocketUrl"; // Key name from the QHash
-        QString defaultValue = NetworkDefaults.value(key, "ws://127.0.0.1:8765"); // Fallback default if key missing in QHash itself
-
-        QVariant valueFromSettings = getAppSetting(SECTION_NETWORK, key, defaultValue);
-        QString urlString = valueFromSettings.toString();
-
-        QUrl url(urlString, QUrl::StrictMode);
-
-        if (!url.isValid() || url.isEmpty()) {
-            Log.msg(FNAME + "Invalid WebSocket URL read ('" + urlString + "'). Falling back to default: " + defaultValue, 
-                Logger::Level::WARNING);
-            // Optional: Show message box
-            // QMessageBox::warning(nullptr, "Configuration Error", ...);
-            url = QUrl(defaultValue, QUrl::StrictMode); // Use default
-
-            // Optional: Write the default back if the setting was invalid/missing
-            // QSettings appSettings(getAppConfigPath(), QSettings::IniFormat);
-            // appSettings.setValue(SECTION_NETWORK + "/" + key, defaultValue);
-            // appSettings.sync();
-        }
-        return url;
-    }
-
-    // Implement other specific getters here, e.g.:
-    // int getConnectionTimeout() {
-    //     QString key = "ConnectionTimeout";
-    //     int defaultValue = NetworkDefaults.value(key, "5000").toInt(); // Get default from QHash
-    //     QVariant valueFromSettings = getAppSetting(SECTION_NETWORK, key, defaultValue);
-    //     bool ok;
-    //     int timeout = valueFromSettings.toInt(&ok);
-    //     if (!ok) {
-    //         Log.msg(FNAME + "Invalid ConnectionTimeout value: " + valueFromSettings.toString() + ". Using default: " + QString::number(defaultValue), Logger::Level::WARNING);
-    //         return defaultValue;
-    //     }
-    //     return timeout;
-    // }
-
-    Logger::Level getLogLevel() {
-        QString key = "Level"; // Key name from QHash
-        QString defaultLevelStr = LoggingDefaults.value(key, "INFO"); // Default from QHash
-
-        QVariant valueFromSettings = getAppSetting(SECTION_LOGGING, key, defaultLevelStr);
-        QString levelStr = valueFromSettings.toString();
-
-        Logger::Level level = Logger::levelFromString(levelStr, Logger::Level::INFO); // Convert string to enum
-        return level;
-    }
-
+#include "Config.h"
+#include "Glob/Logger.h" // Include Logger
+#include "../Defines.h"
+
+#include <QCoreApplication>
+#include <QSettings>
+#include <QDir>
+#include <QFileInfo>
+#include <QVariant>
+#include <QUrl>
+#include <QMessageBox> // Optional for error display
+#include <QThread>
+
+namespace Config {
+
+    // Helper function to get the application config file path
+    QString getAppConfigPath() {
+        return QCoreApplication::applicationDirPath() + "/DataAlpha.ini";
+    }
+
+    void initializeUserSettingsDefaults() {
+        // Set defaults for USER state settings (AppData)
+        QCoreApplication::setOrganizationName(NAME_COMPANY);
+        QCoreApplication::setApplicationName(NAME_PROGRAM_FULL);
+        // Set the default format to INI for all QSettings instances
+        QSettings::setDefaultFormat(QSettings::IniFormat);
+    }
+
+    QVariant getAppSetting(const QString& section, const QString& key, const QVariant& defaultValue) {
+        QString configPath = getAppConfigPath();
+        QSettings appSettings(configPath, QSettings::IniFormat);
+
+        QFileInfo configFileInfo(configPath);
+        if (!configFileInfo.exists() || !configFileInfo.isReadable()) {
+            // Log only once per missing file check maybe? Or use a flag.
+            // For simplicity, log each time for now.
+            QString msg = "App config file not found or not readable: " + configPath + 
+                ". Returning default for " + section + "/" + key;
+            QMessageBox::warning(nullptr, "Error", msg);
+            return defaultValue;
+        }
+
+        QString settingsKey = section + "/" + key;
+        return appSettings.value(settingsKey, defaultValue);
+    }
+
+    QUrl getWebSocketUrl() {
+        QString key = "WebSocketUrl"; // Key name from the QHash
+        QString defaultValue = NetworkDefaults.value(key, "ws://127.0.0.1:8765"); // Fallback default if key missing in QHash itself
+
+        QVariant valueFromSettings = getAppSetting(SECTION_NETWORK, key, defaultValue);
+        QString urlString = valueFromSettings.toString();
+
+        QUrl url(urlString, QUrl::StrictMode);
+
+        if (!url.isValid() || url.isEmpty()) {
+            Log.msg(FNAME + "Invalid WebSocket URL read ('" + urlString + "'). Falling back to default: " + defaultValue, 
+                Logger::Level::WARNING);
+            // Optional: Show message box
+            // QMessageBox::warning(nullptr, "Configuration Error", ...);
+            url = QUrl(defaultValue, QUrl::StrictMode); // Use default
+
+            // Optional: Write the default back if the setting was invalid/missing
+            // QSettings appSettings(getAppConfigPath(), QSettings::IniFormat);
+            // appSettings.setValue(SECTION_NETWORK + "/" + key, defaultValue);
+            // appSettings.sync();
+        }
+        return url;
+    }
+
+    bool getAcceptBinaryFrames() {
+        QString key = "AcceptBinaryFrames";
+        QString defaultValue = NetworkDefaults.value(key, "true");
+
+        QVariant valueFromSettings = getAppSetting(SECTION_NETWORK, key, defaultValue);
+        QString value = valueFromSettings.toString().trimmed().toLower();
+        if (value != "true" && value != "false") {
+            Log.msg(FNAME + "Invalid AcceptBinaryFrames value: " + valueFromSettings.toString() +
+                ". Using default: " + defaultValue, Logger::Level::WARNING);
+            value = defaultValue;
+        }
+        return value == "true";
+    }
+
+    // Implement other specific getters here, e.g.:
+    // int getConnectionTimeout() {
+    //     QString key = "ConnectionTimeout";
+    //     int defaultValue = NetworkDefaults.value(key, "5000").toInt(); // Get default from QHash
+    //     QVariant valueFromSettings = getAppSetting(SECTION_NETWORK, key, defaultValue);
+    //     bool ok;
+    //     int timeout = valueFromSettings.toInt(&ok);
+    //     if (!ok) {
+    //         Log.msg(FNAME + "Invalid ConnectionTimeout value: " + valueFromSettings.toString() + ". Using default: " + QString::number(defaultValue), Logger::Level::WARNING);
+    //         return defaultValue;
+    //     }
+    //     return timeout;
+    // }
+
+    Logger::Level getLogLevel() {
+        QString key = "Level"; // Key name from QHash
+        QString defaultLevelStr = LoggingDefaults.value(key, "INFO"); // Default from QHash
+
+        QVariant valueFromSettings = getAppSetting(SECTION_LOGGING, key, defaultLevelStr);
+        QString levelStr = valueFromSettings.toString();
+
+        Logger::Level level = Logger::levelFromString(levelStr, Logger::Level::INFO); // Convert string to enum
+        return level;
+    }
+
+    int getIngestWorkerCount() {
+        QString key = "WorkerCount";
+        int defaultValue = IngestDefaults.value(key, "2").toInt();
+        const int maxWorkers = qMax(1, QThread::idealThreadCount());
+
+        QVariant valueFromSettings = getAppSetting(SECTION_INGEST, key, defaultValue);
+        bool ok;
+        int count = valueFromSettings.toInt(&ok);
+        if (!ok || count < 0) {
+            Log.msg(FNAME + "Invalid Ingest WorkerCount value: " + valueFromSettings.toString() +
+                ". Using default: " + QString::number(defaultValue), Logger::Level::WARNING);
+            count = defaultValue;
+        }
+        if (count == 0) {
+            count = maxWorkers / 2; // auto
+        }
+        return qBound(1, count, maxWorkers);
+    }
+
+    QString getDictionaryDir() {
+        QString key = "DictionaryDir";
+        QString defaultValue = IngestDefaults.value(key, "dicts");
+
+        QString dir = getAppSetting(SECTION_INGEST, key, defaultValue).toString().trimmed();
+        if (dir.isEmpty()) {
+            return QString(); // Dictionaries disabled
+        }
+        if (QDir::isRelativePath(dir)) {
+            dir = QCoreApplication::applicationDirPath() + "/" + dir;
+        }
+        return QDir::cleanPath(dir);
+    }
+
+    int getIngestQueueCapacity() {
+        QString key = "QueueCapacity";
+        int defaultValue = IngestDefaults.value(key, "64").toInt();
+
+        QVariant valueFromSettings = getAppSetting(SECTION_INGEST, key, defaultValue);
+        bool ok;
+        int capacity = valueFromSettings.toInt(&ok);
+        if (!ok || capacity < 2) {
+            Log.msg(FNAME + "Invalid Ingest QueueCapacity value: " + valueFromSettings.toString() +
+                ". Using default: " + QString::number(defaultValue), Logger::Level::WARNING);
+            capacity = defaultValue;
+        }
+        return qBound(2, capacity, 4096);
+    }
+
+    QString getIngestOverflowPolicy() {
+        QString key = "OverflowPolicy";
+        QString defaultValue = IngestDefaults.value(key, "drop-oldest");
+
+        QString policy = getAppSetting(SECTION_INGEST, key, defaultValue).toString().trimmed().toLower();
+        if (policy != "drop-oldest" && policy != "coalesce") {
+            Log.msg(FNAME + "Invalid Ingest OverflowPolicy value: " + policy +
+                ". Using default: " + defaultValue, Logger::Level::WARNING);
+            policy = defaultValue;
+        }
+        return policy;
+    }
+
+    bool getCoalesceUndatedSnapshots() {
+        QString key = "CoalesceUndatedSnapshots";
+        QString defaultValue = IngestDefaults.value(key, "false");
+
+        QVariant valueFromSettings = getAppSetting(SECTION_INGEST, key, defaultValue);
+        QString value = valueFromSettings.toString().trimmed().toLower();
+        if (value != "true" && value != "false") {
+            Log.msg(FNAME + "Invalid Ingest CoalesceUndatedSnapshots value: " + valueFromSettings.toString() +
+                ". Using default: " + defaultValue, Logger::Level::WARNING);
+            value = defaultValue;
+        }
+        return value == "true";
+    }
+
+    bool getTraceEnabled() {
+        QString key = "Enabled";
+        QString defaultValue = TraceDefaults.value(key, "false");
+
+        QVariant valueFromSettings = getAppSetting(SECTION_TRACE, key, defaultValue);
+        QString value = valueFromSettings.toString().trimmed().toLower();
+        if (value != "true" && value != "false") {
+            Log.msg(FNAME + "Invalid Trace Enabled value: " + valueFromSettings.toString() +
+                ". Using default: " + defaultValue, Logger::Level::WARNING);
+            value = defaultValue;
+        }
+        return value == "true";
+    }
+
+    QString getTraceDumpFile() {
+        QString key = "DumpFile";
+        QString defaultValue = TraceDefaults.value(key, "trace.txt");
+
+        QString file = getAppSetting(SECTION_TRACE, key, defaultValue).toString().trimmed();
+        if (file.isEmpty()) {
+            file = defaultValue;
+        }
+        if (QDir::isRelativePath(file)) {
+            file = QCoreApplication::applicationDirPath() + "/" + file;
+        }
+        return QDir::cleanPath(file);
+    }
+
+    QString getSmileRenderer() {
+        QString key = "SmileRenderer";
+        QString defaultValue = UIDefaults.value(key, "charts");
+
+        QVariant valueFromSettings = getAppSetting(SECTION_UI, key, defaultValue);
+        QString value = valueFromSettings.toString().trimmed().toLower();
+        if (value != "charts" && value != "raster") {
+            Log.msg(FNAME + "Invalid UI SmileRenderer value: " + valueFromSettings.toString() +
+                ". Using default: " + defaultValue, Logger::Level::WARNING);
+            value = defaultValue;
+        }
+        return value;
+    }
+
+    int getFrameIntervalMs() {
+        QString key = "FrameIntervalMs";
+        int defaultValue = UIDefaults.value(key, "33").toInt();
+
+        QVariant valueFromSettings = getAppSetting(SECTION_UI, key, defaultValue);
+        bool ok;
+        int interval = valueFromSettings.toInt(&ok);
+        if (!ok || interval <= 0) {
+            Log.msg(FNAME + "Invalid UI FrameIntervalMs value: " + valueFromSettings.toString() +
+                ". Using default: " + QString::number(defaultValue), Logger::Level::WARNING);
+            interval = defaultValue;
+        }
+        return qBound(4, interval, 1000);
+    }
+
 } // namespace Config
\ No newline at end of file
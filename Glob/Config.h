@@ -1,62 +1,149 @@
-#pragma once
-
-#include "Glob/Logger.h"
-
-#include <QString>
-#include <QUrl>
-#include <QHash>
-#include <QVariant> 
-
-// --- Configuration Namespace ---
-namespace Config {
-
-    // --- Section Names ---
-    const QString SECTION_NETWORK = "Network";
-    const QString SECTION_LOGGING = "Logging";
-    // Add other sections like "UI", "Trading", etc. as needed
-
-    // --- Network Settings ---
-    // Define keys and their default values
-    // Key = INI Key Name, Value = Default Value (as QString)
-    const QHash<QString, QString> NetworkDefaults = {
-        {"WebSocketUrl", "ws://127.0.0.1:8765"},
-        {"ConnectionTimeout", "5000"} // Example: Timeout in ms
-        // Add other network keys and defaults here
-    };
-
-    // --- Logging Settings ---
-    const QHash<QString, QString> LoggingDefaults = {
-        {"Level", "INFO"} // Default level is INFO
-        // Add other logging keys like "LogRotation", "MaxSize" etc. later
-    };
-
-    // --- Public Functions ---
-
-    /**
-     * @brief Initializes application-wide settings defaults (OrgName, AppName, User INI format).
-     * Call this ONCE early in main().
-     */
-    void initializeUserSettingsDefaults();
-
-    /**
-     * @brief Reads a specific setting from the application config file (DataAlpha.ini next to exe).
-     *
-     * @param section The INI section name (e.g., "Network").
-     * @param key The INI key name (e.g., "WebSocketUrl").
-     * @param defaultValue A QVariant holding the default value to return if the key is not found.
-     * @return QVariant The value read from the config file or the defaultValue.
-     */
-    QVariant getAppSetting(const QString& section, const QString& key, const QVariant& defaultValue = QVariant());
-
-    /**
-     * @brief Reads the WebSocket URL from the application config file, with validation and fallback.
-     * @return QUrl The configured or default WebSocket URL.
-     */
-    QUrl getWebSocketUrl();
-
-    Logger::Level getLogLevel();
-
-    // Add other specific getter functions as needed, e.g.:
-    // int getConnectionTimeout();
-
-} // namespace Config
+#pragma once
+
+#include "Glob/Logger.h"
+
+#include <QString>
+#include <QUrl>
+#include <QHash>
+#include <QVariant> 
+
+// --- Configuration Namespace ---
+namespace Config {
+
+    // --- Section Names ---
+    const QString SECTION_NETWORK = "Network";
+    const QString SECTION_LOGGING = "Logging";
+    const QString SECTION_INGEST = "Ingest";
+    const QString SECTION_TRACE = "Trace";
+    const QString SECTION_UI = "UI";
+    // Add other sections like "Trading", etc. as needed
+
+    // --- Network Settings ---
+    // Define keys and their default values
+    // Key = INI Key Name, Value = Default Value (as QString)
+    const QHash<QString, QString> NetworkDefaults = {
+        {"WebSocketUrl", "ws://127.0.0.1:8765"},
+        {"ConnectionTimeout", "5000"}, // Example: Timeout in ms
+        {"AcceptBinaryFrames", "true"} // Offer binary columnar smile frames in the hello handshake
+        // Add other network keys and defaults here
+    };
+
+    // --- Logging Settings ---
+    const QHash<QString, QString> LoggingDefaults = {
+        {"Level", "INFO"} // Default level is INFO
+        // Add other logging keys like "LogRotation", "MaxSize" etc. later
+    };
+
+    // --- Ingest (decode/inflate/parse) Settings ---
+    const QHash<QString, QString> IngestDefaults = {
+        {"WorkerCount", "2"}, // 0 = auto (half of the available cores)
+        {"DictionaryDir", "dicts"}, // Trained compression dictionaries ("<codec>-<id>.dict"), relative to the exe
+        {"QueueCapacity", "64"}, // Queued messages per symbol/model before the overflow policy applies
+        {"OverflowPolicy", "drop-oldest"}, // "drop-oldest" or "coalesce" (keep only the newest queued message)
+        {"CoalesceUndatedSnapshots", "false"} // Latest-wins per symbol/model for JSON snapshots without "date"
+    };
+
+    // --- Latency tracing Settings ---
+    const QHash<QString, QString> TraceDefaults = {
+        {"Enabled", "false"}, // Record per-stage latency histograms (socket receive -> paint)
+        {"DumpFile", "trace.txt"} // Histograms written on exit, relative to the exe
+    };
+
+    // --- UI Settings ---
+    const QHash<QString, QString> UIDefaults = {
+        {"SmileRenderer", "charts"}, // Default renderer of new chart windows: "charts" (Qt Charts) or "raster" (QPainter)
+        {"FrameIntervalMs", "33"}    // Minimum time between two repaints of a window (RedrawScheduler)
+    };
+
+    // --- Public Functions ---
+
+    /**
+     * @brief Initializes application-wide settings defaults (OrgName, AppName, User INI format).
+     * Call this ONCE early in main().
+     */
+    void initializeUserSettingsDefaults();
+
+    /**
+     * @brief Reads a specific setting from the application config file (DataAlpha.ini next to exe).
+     *
+     * @param section The INI section name (e.g., "Network").
+     * @param key The INI key name (e.g., "WebSocketUrl").
+     * @param defaultValue A QVariant holding the default value to return if the key is not found.
+     * @return QVariant The value read from the config file or the defaultValue.
+     */
+    QVariant getAppSetting(const QString& section, const QString& key, const QVariant& defaultValue = QVariant());
+
+    /**
+     * @brief Reads the WebSocket URL from the application config file, with validation and fallback.
+     * @return QUrl The configured or default WebSocket URL.
+     */
+    QUrl getWebSocketUrl();
+
+    /**
+     * @brief Whether the client offers binary columnar smile frames to the server.
+     * @return bool false forces the JSON/CSV format even with servers that support binary.
+     */
+    bool getAcceptBinaryFrames();
+
+    Logger::Level getLogLevel();
+
+    /**
+     * @brief Number of ingest worker threads used for decode/inflate/parse of incoming data.
+     * @return int Configured count, clamped to [1, idealThreadCount]. 0 in the config means auto.
+     */
+    int getIngestWorkerCount();
+
+    /**
+     * @brief Directory holding the trained zstd/LZ4 dictionaries.
+     * @return QString Absolute path (relative paths are resolved against the application directory), empty if disabled.
+     */
+    QString getDictionaryDir();
+
+    /**
+     * @brief Capacity of the ingress queue of each symbol/model (rounded up to a power of two).
+     * @return int Configured capacity, clamped to [2, 4096].
+     */
+    int getIngestQueueCapacity();
+
+    /**
+     * @brief What happens when a symbol/model ingress queue is full.
+     * @return QString "drop-oldest" (evict the oldest queued message) or "coalesce" (keep only the newest).
+     */
+    QString getIngestOverflowPolicy();
+
+    /**
+     * @brief Whether JSON snapshots without a "date" field are coalesced per symbol/model.
+     * Only correct for servers that send a single expiry per symbol/model: with several expiries
+     * a snapshot would replace one of another expiry.
+     * @return bool false queues such snapshots without coalescing (dated ones coalesce per expiry).
+     */
+    bool getCoalesceUndatedSnapshots();
+
+    /**
+     * @brief Whether end-to-end latency tracing of the smile pipeline is enabled.
+     * @return bool false leaves every probe at a single atomic load.
+     */
+    bool getTraceEnabled();
+
+    /**
+     * @brief File the latency histograms are written to on exit.
+     * @return QString Absolute path (relative paths are resolved against the application directory).
+     */
+    QString getTraceDumpFile();
+
+    /**
+     * @brief Renderer of the smile plot in newly opened chart windows (each window can switch it).
+     * @return QString "charts" (Qt Charts scene graph) or "raster" (QPainter into a cached image).
+     */
+    QString getSmileRenderer();
+
+    /**
+     * @brief Frame interval of the RedrawScheduler: a chart window repaints at most once per interval.
+     * @return int Milliseconds, clamped to [4, 1000].
+     */
+    int getFrameIntervalMs();
+
+    // Add other specific getter functions as needed, e.g.:
+    // int getConnectionTimeout();
+
+} // namespace Config
@@ -0,0 +1,91 @@
+// GUI half of the Logger: the log widget sink. Only the application links it; tools log without widgets.
+#include "Logger.h"
+
+#include <QPlainTextEdit>
+#include <QTextCursor>
+#include <QScrollBar>
+#include <QTextDocument>
+#include <QTextBlock>
+#include <QMutexLocker>
+#include <QCoreApplication>
+#include <QThread>
+
+namespace {
+
+    void addHtmlInverted(QPlainTextEdit* textEdit, const QString& htmlLine) {
+        QTextDocument* doc = textEdit->document();
+        if (!doc) {
+            qWarning("addHtmlInverted: Could not get document from QPlainTextEdit!");
+            return;
+        }
+
+        // --- 1. Insert the new content at the beginning ---
+        QTextCursor cursor(doc); 
+        cursor.movePosition(QTextCursor::Start); 
+
+        // Insert the HTML for the new line
+        cursor.insertHtml(htmlLine);
+
+        // Insert a block separator (like pressing Enter) right after the inserted HTML.
+        // This ensures the new HTML is its own paragraph/block and pushes
+        // the previous content down onto the next line(s).
+        cursor.insertBlock();
+
+        // --- 2. Limit the number of blocks ---
+        const int maxBlocks = 1000;
+        // Keep removing the *last* block until the count is within the limit
+        // Note: blockCount() can be slightly expensive if called repeatedly in a tight loop
+        // for very large documents, but is generally fine here.
+        while (doc->blockCount() > maxBlocks) {
+            QTextCursor removeCursor(doc->lastBlock()); // Cursor targeting the last block
+            removeCursor.select(QTextCursor::BlockUnderCursor); // Select the entire block
+            removeCursor.removeSelectedText(); // Remove the selected block content
+            // For QPlainTextEdit, removeSelectedText on a BlockUnderCursor
+            // usually removes the block itself cleanly.
+        }
+        // As an alternative, consider using QPlainTextEdit::setMaximumBlockCount(maxBlocks)
+        // It's simpler but might have different performance characteristics. Test which works best.
+        // plainTextEdit->setMaximumBlockCount(maxBlocks); // Call this once during setup if preferred
+
+        // --- 3. Scroll to the top ---
+        // Ensure the scrollbar is positioned at the top to show the newly added line.
+        QScrollBar* scrollBar = textEdit->verticalScrollBar();
+        if (scrollBar) {
+            scrollBar->setValue(scrollBar->minimum());
+        }
+    }
+
+} // namespace
+
+void Logger::init(QPlainTextEdit* loggerWidget) {
+    QMutexLocker locker(&m_logMutex); // Lock for initialization
+
+    if (isInited) {
+        return;
+    }
+
+    m_display = [loggerWidget](const QString& htmlLine) {
+        // Get pointers to the current thread and the application's main GUI thread
+        QThread* currentThread = QThread::currentThread();
+        QThread* mainGuiThread = QCoreApplication::instance() ? QCoreApplication::instance()->thread() : nullptr;
+
+        if (mainGuiThread && currentThread == mainGuiThread) {
+            // --- Current thread IS the main GUI thread ---
+            // Call the update function directly
+            addHtmlInverted(loggerWidget, htmlLine);
+        }
+        else if (mainGuiThread) {
+            // Use invokeMethod to ensure thread-safety if msg can be called from other threads
+            QMetaObject::invokeMethod(loggerWidget, [loggerWidget, htmlLine]() {
+                // Inverted for show newest messages on logs top
+                addHtmlInverted(loggerWidget, htmlLine);
+                },
+                Qt::QueuedConnection // Queue to UI thread
+            );
+        }
+    };
+
+    if (!openLogFile()) {
+        m_display = nullptr;
+    }
+}
@@ -0,0 +1,75 @@
+#include "ProcessStats.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <ctime>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
+
+namespace ProcessStats {
+
+#if defined(_WIN32)
+
+qint64 residentBytes() {
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return -1;
+    }
+    return qint64(counters.WorkingSetSize);
+}
+
+qint64 peakResidentBytes() {
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return -1;
+    }
+    return qint64(counters.PeakWorkingSetSize);
+}
+
+qint64 cpuTimeNs() {
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        return -1;
+    }
+    auto ticks = [](const FILETIME& time) {
+        return (qint64(time.dwHighDateTime) << 32) | qint64(time.dwLowDateTime);
+    };
+    return (ticks(kernel) + ticks(user)) * 100; // 100 ns units
+}
+
+#else
+
+qint64 residentBytes() {
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) return -1;
+    long long size = 0, resident = 0;
+    const int fields = std::fscanf(file, "%lld %lld", &size, &resident);
+    std::fclose(file);
+    return fields == 2 ? qint64(resident) * sysconf(_SC_PAGESIZE) : -1;
+}
+
+qint64 peakResidentBytes() {
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return qint64(usage.ru_maxrss) * 1024; // kilobytes on Linux
+}
+
+qint64 cpuTimeNs() {
+    timespec time;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) {
+        return -1;
+    }
+    return qint64(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
+
+#endif
+
+} // namespace ProcessStats
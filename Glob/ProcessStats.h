@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QtGlobal>
+
+// Process-wide resource counters read by the performance dashboard.
+// Each call is one OS query, cheap enough for a once-per-second sample.
+namespace ProcessStats {
+
+    // Resident set size (working set on Windows) in bytes, -1 if unavailable
+    qint64 residentBytes();
+
+    // Highest resident set size (peak working set on Windows) reached so far, in bytes, -1 if unavailable
+    qint64 peakResidentBytes();
+
+    // User + kernel CPU time consumed by the whole process so far, in nanoseconds, -1 if unavailable
+    qint64 cpuTimeNs();
+
+} // namespace ProcessStats
@@ -0,0 +1,189 @@
+#include "Trace.h"
+#include "Glob/Logger.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QTextStream>
+
+#include <bit>
+#include <chrono>
+
+namespace Trace {
+
+namespace detail {
+    std::atomic<bool> enabled{ false };
+}
+
+namespace {
+
+    std::array<Histogram, int(Stage::Count)>& histograms() {
+        static std::array<Histogram, int(Stage::Count)> instance;
+        return instance;
+    }
+
+    QString formatUs(qint64 ns) {
+        return QString::number(double(ns) / 1000.0, 'f', 1);
+    }
+
+} // namespace
+
+const char* stageName(Stage stage) {
+    switch (stage) {
+    case Stage::ServerToReceive: return "server->receive";
+    case Stage::Envelope:        return "envelope";
+    case Stage::Base64:          return "base64";
+    case Stage::QueueWait:       return "queue wait";
+    case Stage::Inflate:         return "inflate";
+    case Stage::Parse:           return "parse";
+    case Stage::Publish:         return "publish";
+    case Stage::ChartSlot:       return "chart slot";
+    case Stage::PlotUpdate:      return "plot update";
+    case Stage::Paint:           return "paint";
+    case Stage::EndToEnd:        return "end-to-end";
+    case Stage::Count:           break;
+    }
+    return "?";
+}
+
+// --- Histogram ---
+
+int Histogram::indexOf(qint64 value) {
+    if (value < 2 * SubBucketHalf) {
+        return int(qMax<qint64>(0, value));
+    }
+    const int msb = std::bit_width(quint64(value)) - 1;
+    const int exponent = qMin(msb - (SubBucketBits - 1), MaxExponent);
+    const qint64 subBucket = qMin<qint64>(value >> exponent, 2 * SubBucketHalf - 1);
+    return int(exponent * SubBucketHalf + subBucket);
+}
+
+qint64 Histogram::valueAt(int index) {
+    if (index < 2 * SubBucketHalf) {
+        return index;
+    }
+    // Middle of the bucket, halves the worst-case error of its lower bound
+    const int exponent = index / SubBucketHalf - 1;
+    const qint64 subBucket = index % SubBucketHalf + SubBucketHalf;
+    return (subBucket << exponent) + ((qint64(1) << exponent) >> 1);
+}
+
+void Histogram::record(qint64 valueNs) {
+    if (valueNs < 0) valueNs = 0;
+    m_buckets[indexOf(valueNs)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(valueNs, std::memory_order_relaxed);
+    qint64 max = m_max.load(std::memory_order_relaxed);
+    while (valueNs > max && !m_max.compare_exchange_weak(max, valueNs, std::memory_order_relaxed)) {}
+}
+
+void Histogram::reset() {
+    for (std::atomic<quint64>& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+double Histogram::mean() const {
+    const quint64 n = count();
+    return n ? double(m_sum.load(std::memory_order_relaxed)) / double(n) : 0.0;
+}
+
+qint64 Histogram::percentile(double percentile) const {
+    const quint64 total = count();
+    if (total == 0) return 0;
+    if (percentile >= 100.0) return max();
+    const quint64 target = qMax<quint64>(1, quint64(double(total) * qBound(0.0, percentile, 100.0) / 100.0 + 0.5));
+
+    quint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return qMin(valueAt(i), max());
+        }
+    }
+    return max();
+}
+
+// --- Recording ---
+
+void setEnabled(bool enabled) {
+    detail::enabled.store(enabled, std::memory_order_relaxed);
+    Log.msg(FNAME + QString("Latency tracing %1.").arg(enabled ? "enabled" : "disabled"), Logger::Level::INFO);
+}
+
+qint64 now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void record(Stage stage, qint64 durationNs) {
+    if (!isEnabled() || stage == Stage::Count) return;
+    histograms()[int(stage)].record(durationNs);
+}
+
+void recordSince(Stage stage, qint64 sinceNs) {
+    if (sinceNs == 0 || !isEnabled()) return;
+    record(stage, now() - sinceNs);
+}
+
+const Histogram& histogram(Stage stage) {
+    return histograms()[qBound(0, int(stage), int(Stage::Count) - 1)];
+}
+
+void reset() {
+    for (Histogram& h : histograms()) {
+        h.reset();
+    }
+}
+
+bool dump(const QString& fileName) {
+    bool hasSamples = false;
+    for (int i = 0; i < int(Stage::Count) && !hasSamples; ++i) {
+        hasSamples = histograms()[i].count() > 0;
+    }
+    if (!isEnabled() && !hasSamples) return true;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        Log.msg(FNAME + "Cannot write trace dump: " + fileName, Logger::Level::ERROR);
+        return false;
+    }
+    QTextStream out(&file);
+    out << "# Smile pipeline latency, " << QDateTime::currentDateTime().toString(Qt::ISODate) << "\n";
+    out << "# Values in microseconds\n\n";
+    out << QString("%1 %2 %3 %4 %5 %6 %7 %8\n").arg("stage", -16).arg("count", 10).arg("mean", 10)
+        .arg("p50", 10).arg("p90", 10).arg("p99", 10).arg("p99.9", 10).arg("max", 10);
+
+    for (int i = 0; i < int(Stage::Count); ++i) {
+        const Histogram& h = histograms()[i];
+        out << QString("%1 %2 %3 %4 %5 %6 %7 %8\n").arg(stageName(Stage(i)), -16).arg(h.count(), 10)
+            .arg(QString::number(h.mean() / 1000.0, 'f', 1), 10)
+            .arg(formatUs(h.percentile(50)), 10).arg(formatUs(h.percentile(90)), 10)
+            .arg(formatUs(h.percentile(99)), 10).arg(formatUs(h.percentile(99.9)), 10)
+            .arg(formatUs(h.max()), 10);
+    }
+
+    // Percentile distribution, one block per recorded stage
+    static const double percentiles[] = { 0, 25, 50, 75, 90, 95, 99, 99.9, 99.99, 100 };
+    for (int i = 0; i < int(Stage::Count); ++i) {
+        const Histogram& h = histograms()[i];
+        if (h.count() == 0) continue;
+        out << "\n[" << stageName(Stage(i)) << "]\n";
+        out << QString("%1 %2\n").arg("percentile", 12).arg("value", 12);
+        for (double p : percentiles) {
+            out << QString("%1 %2\n").arg(p, 12, 'f', 2).arg(formatUs(h.percentile(p)), 12);
+        }
+    }
+
+    file.close();
+    if (file.error() != QFile::NoError) {
+        Log.msg(FNAME + "Trace dump failed: " + file.errorString(), Logger::Level::ERROR);
+        return false;
+    }
+    Log.msg(FNAME + "Trace histograms written to " + fileName, Logger::Level::INFO);
+    return true;
+}
+
+} // namespace Trace
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+
+#include <array>
+#include <atomic>
+
+// End-to-end latency tracing of the smile pipeline, from socket receive to paint.
+//
+// Every message carries a Timeline (monotonic receive/publish timestamps plus the server's
+// metrics.load_time) through MessageEnvelope and SmileSnapshot. Each stage records its latency
+// into a per-stage log-linear ("HDR-style") histogram: ~3% precision from 1 ns to hours,
+// lock-free recording from any thread, percentiles readable at any time and dumpable to a file.
+//
+// Disabled ([Trace] Enabled=false), every probe is one relaxed atomic load and no clock is read.
+namespace Trace {
+
+    enum class Stage : int {
+        ServerToReceive, // metrics.load_time (server clock) -> receive (client clock), clock offset included
+        Envelope,        // JSON envelope scan, base64 excluded
+        Base64,          // base64 decode of 'data_compressed'
+        QueueWait,       // Receive -> ingest worker picks the message up
+        Inflate,         // Decompression (zlib streams into the parser: parse time excluded)
+        Parse,           // CSV parse, or binary frame decode
+        Publish,         // Snapshot / delta publish
+        ChartSlot,       // Publish -> QuoteChartWindow::plotDataUpdated entered (GUI thread hop)
+        PlotUpdate,      // SmilePlot::updateData / updateRows
+        Paint,           // SmilePlot paint
+        EndToEnd,        // Receive -> painted
+        Count
+    };
+
+    const char* stageName(Stage stage);
+
+    // Per message timestamps, copied along the pipeline (cheap, trivially copyable)
+    struct Timeline {
+        qint64 receiveNs = 0;    // Trace::now() when the message left the socket, 0 = not traced
+        qint64 publishNs = 0;    // Trace::now() when the snapshot was published
+        qint64 serverLoadMs = 0; // metrics.load_time (ms since epoch, server clock), 0 = unknown
+
+        bool isValid() const { return receiveNs != 0; }
+    };
+
+    // Log-linear histogram of nanosecond values: 16 linear sub-buckets per power of two
+    class Histogram {
+    public:
+        void record(qint64 valueNs);
+        void reset();
+
+        quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+        qint64 max() const { return m_max.load(std::memory_order_relaxed); }
+        double mean() const;
+        // Value at 'percentile' (0..100), middle of its bucket (100 = exact max)
+        qint64 percentile(double percentile) const;
+
+    private:
+        static constexpr int SubBucketBits = 5;
+        static constexpr int SubBucketHalf = 1 << (SubBucketBits - 1);
+        static constexpr int MaxExponent = 40; // 2^45 ns (~10 h), larger values are clamped
+        static constexpr int BucketCount = (MaxExponent + 2) * SubBucketHalf;
+
+        static int indexOf(qint64 value);
+        static qint64 valueAt(int index);
+
+        std::array<std::atomic<quint64>, BucketCount> m_buckets{};
+        std::atomic<quint64> m_count{ 0 };
+        std::atomic<qint64> m_sum{ 0 };
+        std::atomic<qint64> m_max{ 0 };
+    };
+
+    namespace detail {
+        extern std::atomic<bool> enabled;
+    }
+
+    inline bool isEnabled() { return detail::enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled);
+
+    // Monotonic clock in nanoseconds
+    qint64 now();
+
+    void record(Stage stage, qint64 durationNs);
+    // Latency from 'sinceNs' (a Trace::now() value, 0 = untraced) to now
+    void recordSince(Stage stage, qint64 sinceNs);
+    const Histogram& histogram(Stage stage);
+    void reset();
+
+    // Writes a summary table and the percentile distribution of every stage. Nothing is written (and the
+    // file is left alone) while tracing is disabled and no stage has samples, e.g. tracing was never
+    // switched on at runtime. Returns false on I/O error.
+    bool dump(const QString& fileName);
+
+    // Records the lifetime of the scope as 'stage' (nothing when tracing is disabled)
+    class Scope {
+    public:
+        explicit Scope(Stage stage) : m_stage(stage), m_start(isEnabled() ? now() : 0) {}
+        ~Scope() { if (m_start) record(m_stage, now() - m_start); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Stage m_stage;
+        qint64 m_start;
+    };
+
+} // namespace Trace
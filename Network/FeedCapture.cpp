@@ -0,0 +1,144 @@
+#include "FeedCapture.h"
+#include "Glob/Logger.h"
+
+#include <QDateTime>
+#include <QtEndian>
+
+#include <chrono>
+#include <cstring>
+
+namespace FeedCapture {
+
+namespace {
+
+    qint64 steadyNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Length of the file up to the end of its last complete record (reads record headers only)
+    qint64 completeLength(QFile& file) {
+        const qint64 size = file.size();
+        qint64 pos = sizeof(Magic);
+        char header[RecordHeaderSize];
+        while (pos + RecordHeaderSize <= size) {
+            if (!file.seek(pos) || file.read(header, sizeof(header)) != qint64(sizeof(header))) break;
+            const qint64 end = pos + RecordHeaderSize + qFromLittleEndian<quint32>(header + 12);
+            if (quint8(header[0]) > quint8(Kind::Binary) || end > size) break;
+            pos = end;
+        }
+        return pos;
+    }
+
+} // namespace
+
+// --- Recorder ---
+
+Recorder::~Recorder() {
+    close();
+}
+
+bool Recorder::open(const QString& fileName) {
+    close();
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        Log.msg(FNAME + QString("Cannot open capture file %1: %2").arg(fileName, m_file.errorString()),
+            Logger::Level::ERROR);
+        return false;
+    }
+    if (m_file.size() == 0) {
+        m_file.write(Magic, sizeof(Magic));
+    }
+    else {
+        char magic[sizeof(Magic)];
+        if (m_file.read(magic, sizeof(magic)) != qint64(sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0) {
+            Log.msg(FNAME + "Not a feed capture file, not recording: " + fileName, Logger::Level::ERROR);
+            m_file.close();
+            return false;
+        }
+        // Appending after a partial record would misalign every record of the new session
+        const qint64 length = completeLength(m_file);
+        if (length < m_file.size()) {
+            Log.msg(FNAME + QString("Removing a truncated last record (%1 bytes) from %2")
+                .arg(m_file.size() - length).arg(fileName), Logger::Level::WARNING);
+            if (!m_file.resize(length)) {
+                Log.msg(FNAME + "Cannot truncate capture file: " + m_file.errorString(), Logger::Level::ERROR);
+                m_file.close();
+                return false;
+            }
+        }
+        m_file.seek(length);
+    }
+    m_wallStartNs = QDateTime::currentMSecsSinceEpoch() * 1000000;
+    m_steadyStartNs = steadyNs();
+    m_records = 0;
+    Log.msg(FNAME + "Recording WebSocket feed to " + fileName, Logger::Level::INFO);
+    return true;
+}
+
+void Recorder::close() {
+    if (!m_file.isOpen()) return;
+    m_file.close();
+    Log.msg(FNAME + QString("Capture closed, %1 message(s) recorded.").arg(m_records), Logger::Level::INFO);
+}
+
+void Recorder::record(Kind kind, const char* data, qsizetype size) {
+    if (!m_file.isOpen()) return;
+
+    char header[RecordHeaderSize] = {};
+    header[0] = char(kind);
+    qToLittleEndian<qint64>(m_wallStartNs + (steadyNs() - m_steadyStartNs), header + 4);
+    qToLittleEndian<quint32>(quint32(size), header + 12);
+
+    // QFile buffers, a record is usually a single copy into that buffer; flushed per record so that
+    // a crash loses at most the record being written
+    if (m_file.write(header, sizeof(header)) != qint64(sizeof(header)) || m_file.write(data, size) != size
+        || !m_file.flush()) {
+        Log.msg(FNAME + "Capture write failed, recording stopped: " + m_file.errorString(), Logger::Level::ERROR);
+        m_file.close();
+        return;
+    }
+    ++m_records;
+}
+
+// --- Reader ---
+
+bool Reader::open(const QString& fileName) {
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        Log.msg(FNAME + QString("Cannot open capture file %1: %2").arg(fileName, m_file.errorString()),
+            Logger::Level::ERROR);
+        return false;
+    }
+    char magic[sizeof(Magic)];
+    if (m_file.read(magic, sizeof(magic)) != qint64(sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0) {
+        Log.msg(FNAME + "Not a feed capture file: " + fileName, Logger::Level::ERROR);
+        m_file.close();
+        return false;
+    }
+    return true;
+}
+
+bool Reader::next(Record& out) {
+    char header[RecordHeaderSize];
+    if (m_file.read(header, sizeof(header)) != qint64(sizeof(header))) {
+        return false;
+    }
+    const quint8 kind = quint8(header[0]);
+    if (kind > quint8(Kind::Binary)) {
+        Log.msg(FNAME + QString("Corrupt capture record (kind %1), replay stopped.").arg(kind), Logger::Level::ERROR);
+        return false;
+    }
+    out.kind = Kind(kind);
+    out.receiveNs = qFromLittleEndian<qint64>(header + 4);
+    const quint32 size = qFromLittleEndian<quint32>(header + 12);
+
+    out.payload = QByteArray(qsizetype(size), Qt::Uninitialized); // The previous payload may still be in flight
+    if (m_file.read(out.payload.data(), size) != qint64(size)) {
+        Log.msg(FNAME + "Truncated last capture record ignored.", Logger::Level::WARNING);
+        return false;
+    }
+    return true;
+}
+
+} // namespace FeedCapture
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+// Capture file of raw WebSocket messages ("DAFEED1"), for record and replay of production traffic.
+//
+// Append-only: a new session is appended to an existing capture. Each record is flushed as it is
+// written; a truncated last record (crash while recording) is ignored by the reader and cut off
+// before a new session is appended. All integers are little-endian. Layout:
+//
+//   File header   char[8] magic "DAFEED1\0"
+//   Record        u8      kind (FeedCapture::Kind)
+//                 u8[3]   reserved
+//                 i64     receive time, ns since epoch (wall clock at session start + monotonic offset)
+//                 u32     payload length
+//                 payload (text messages as UTF-8, binary messages as received)
+namespace FeedCapture {
+
+    const char Magic[8] = { 'D', 'A', 'F', 'E', 'E', 'D', '1', '\0' };
+    constexpr int RecordHeaderSize = 16;
+
+    enum class Kind : quint8 {
+        Text = 0,
+        Binary = 1
+    };
+
+    struct Record {
+        Kind kind = Kind::Text;
+        qint64 receiveNs = 0;
+        QByteArray payload;
+    };
+
+    // Appends received messages to a capture file. Not thread-safe: used on the network thread only.
+    class Recorder {
+    public:
+        ~Recorder();
+
+        // Opens 'fileName' for appending (writes the file header if the file is new or empty).
+        // Refuses files that are not captures; a truncated last record is removed first.
+        bool open(const QString& fileName);
+        void close();
+        bool isOpen() const { return m_file.isOpen(); }
+
+        void record(Kind kind, const char* data, qsizetype size);
+
+        quint64 recordCount() const { return m_records; }
+
+    private:
+        QFile m_file;
+        qint64 m_wallStartNs = 0;
+        qint64 m_steadyStartNs = 0;
+        quint64 m_records = 0;
+    };
+
+    // Sequential reader of a capture file
+    class Reader {
+    public:
+        bool open(const QString& fileName);
+        void close() { m_file.close(); }
+
+        // Next record; false at the end of the file or at a truncated record
+        bool next(Record& out);
+
+    private:
+        QFile m_file;
+    };
+
+} // namespace FeedCapture
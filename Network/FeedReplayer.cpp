@@ -0,0 +1,102 @@
+#include "FeedReplayer.h"
+#include "Glob/Logger.h"
+
+#include <cmath>
+
+FeedReplayer::FeedReplayer(QObject* parent)
+    : QObject(parent)
+    , m_timer(this) {
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &FeedReplayer::replayDue);
+}
+
+bool FeedReplayer::start(const QString& fileName, double speed, BacklogProbe backlog, int maxBacklog) {
+    stop();
+    if (!m_reader.open(fileName)) {
+        return false;
+    }
+    m_speed = qMax(0.0, speed);
+    m_backlog = std::move(backlog);
+    m_maxBacklog = qMax(0, maxBacklog);
+    m_backlogPauses = 0;
+    m_messages = 0;
+    m_bytes = 0;
+    m_captureNs = 0;
+    m_lastReceiveNs = 0;
+    m_hasNext = readNext();
+    if (!m_hasNext) {
+        Log.msg(FNAME + "Capture file is empty: " + fileName, Logger::Level::WARNING);
+        m_reader.close();
+        return false;
+    }
+
+    Log.msg(FNAME + QString("Replaying %1 at %2.").arg(fileName,
+        m_speed > 0 ? QString("%1x").arg(m_speed) : QString("max speed")), Logger::Level::INFO);
+    m_running = true;
+    m_clock.start();
+    m_timer.start(0);
+    return true;
+}
+
+void FeedReplayer::stop() {
+    m_timer.stop();
+    m_reader.close();
+    m_hasNext = false;
+    m_running = false;
+}
+
+bool FeedReplayer::readNext() {
+    if (!m_reader.next(m_next)) {
+        return false;
+    }
+    if (m_lastReceiveNs != 0) {
+        m_captureNs += qBound<qint64>(0, m_next.receiveNs - m_lastReceiveNs, MAX_GAP_NS);
+    }
+    m_lastReceiveNs = m_next.receiveNs;
+    return true;
+}
+
+void FeedReplayer::replayDue() {
+    int batch = 0;
+    while (m_hasNext) {
+        if (m_speed > 0) {
+            const qint64 dueNs = qint64(double(m_captureNs) / m_speed);
+            const qint64 waitNs = dueNs - m_clock.nsecsElapsed();
+            if (waitNs > 0) {
+                m_timer.start(int(std::ceil(double(waitNs) / 1e6)));
+                return;
+            }
+        }
+        else if (batch == MAX_SPEED_BATCH) {
+            m_timer.start(0); // Let the thread's other events run
+            return;
+        }
+        else if (m_backlog && m_backlog() > m_maxBacklog) {
+            ++m_backlogPauses;
+            m_timer.start(BACKLOG_WAIT_MS); // Let the consumer catch up instead of overflowing its queues
+            return;
+        }
+
+        const FeedCapture::Record record = m_next; // Shallow, the next read allocates a new payload
+        m_hasNext = readNext();
+        ++m_messages;
+        ++batch;
+        m_bytes += quint64(record.payload.size());
+        if (record.kind == FeedCapture::Kind::Text) {
+            emit textMessage(QString::fromUtf8(record.payload));
+        }
+        else {
+            emit binaryMessage(record.payload);
+        }
+        if (!m_running) return; // Stopped by a receiver
+    }
+
+    const qint64 elapsedMs = m_clock.elapsed();
+    Log.msg(FNAME + QString("Replay finished: %1 message(s), %2 MB in %3 ms (%4 msg/s), %5 backlog pause(s).")
+        .arg(m_messages).arg(double(m_bytes) / 1e6, 0, 'f', 1).arg(elapsedMs)
+        .arg(elapsedMs > 0 ? double(m_messages) * 1000.0 / double(elapsedMs) : 0.0, 0, 'f', 0)
+        .arg(m_backlogPauses), Logger::Level::INFO);
+    stop();
+    emit finished(m_messages, elapsedMs);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <functional>
+
+#include "FeedCapture.h"
+
+// Plays a feed capture (see FeedCapture.h) back as received WebSocket messages.
+//
+// Speed 1 keeps the recorded inter-arrival times, N replays N times faster, 0 replays as fast as
+// the event loop allows (in batches, so the owning thread stays responsive). At speed 0 a backlog
+// probe applies backpressure: the replay pauses while the consumer has more than 'maxBacklog'
+// messages queued, so a slower build is not fed faster than it ingests and its bounded queues do
+// not drop what a faster build would keep. Gaps between recorded messages are capped at MAX_GAP_NS,
+// so idle time between appended sessions is skipped.
+// Lives on the thread of its owner; records are read from the file one ahead of their due time.
+class FeedReplayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Messages the consumer has queued and not processed yet. Called on the replayer's thread.
+    using BacklogProbe = std::function<int()>;
+
+    explicit FeedReplayer(QObject* parent = nullptr);
+
+    // 'backlog' (optional) throttles speed 0, see above
+    bool start(const QString& fileName, double speed, BacklogProbe backlog = BacklogProbe(), int maxBacklog = 0);
+    void stop();
+    bool isRunning() const { return m_running; }
+
+signals:
+    void textMessage(const QString& message);
+    void binaryMessage(const QByteArray& message);
+    // End of the capture: messages replayed and the wall time it took
+    void finished(quint64 messages, qint64 elapsedMs);
+
+private slots:
+    void replayDue();
+
+private:
+    bool readNext();
+
+    static constexpr qint64 MAX_GAP_NS = 1000000000; // 1 s
+    static const int MAX_SPEED_BATCH = 32;            // Messages per event loop pass at speed 0
+    static const int BACKLOG_WAIT_MS = 1;             // Pause while the consumer's backlog is above the limit
+
+    FeedCapture::Reader m_reader;
+    FeedCapture::Record m_next;
+    bool m_hasNext = false;
+    bool m_running = false;
+    double m_speed = 1.0;
+    BacklogProbe m_backlog;
+    int m_maxBacklog = 0;
+    quint64 m_backlogPauses = 0;
+    qint64 m_lastReceiveNs = 0; // Capture time of the last record read
+    qint64 m_captureNs = 0;     // Capture time elapsed up to m_next (gaps capped)
+    quint64 m_messages = 0;
+    quint64 m_bytes = 0;
+    QElapsedTimer m_clock;
+    QTimer m_timer; // Child of this
+};
@@ -0,0 +1,311 @@
+#include "MessageEnvelope.h"
+#include "libs/Base64.h"
+
+namespace {
+
+    // Forward-only JSON scanner over UTF-16 text. Reads the values it is asked for and skips the rest.
+    struct Scanner {
+        const char16_t* pos;
+        const char16_t* end;
+        QString error;
+        qint64 base64Ns = 0;
+
+        bool fail(const char* reason) {
+            if (error.isEmpty()) error = QString::fromLatin1(reason);
+            return false;
+        }
+
+        void skipWhitespace() {
+            while (pos < end && (*pos == u' ' || *pos == u'\t' || *pos == u'\n' || *pos == u'\r')) ++pos;
+        }
+
+        bool expect(char16_t c) {
+            skipWhitespace();
+            if (pos >= end || *pos != c) return fail("unexpected character");
+            ++pos;
+            return true;
+        }
+
+        bool peek(char16_t c) {
+            skipWhitespace();
+            return pos < end && *pos == c;
+        }
+
+        // Span of a string value without its quotes; 'escaped' is set if it contains escapes.
+        // Uses QStringView's vectorised searches, 'data_compressed' is megabytes long.
+        bool stringSpan(QStringView& span, bool& escaped) {
+            if (!expect(u'"')) return false;
+            const char16_t* begin = pos;
+            while (true) {
+                const qsizetype quote = QStringView(pos, end).indexOf(u'"');
+                if (quote < 0) return fail("unterminated string");
+                pos += quote;
+                // A quote preceded by an odd number of backslashes is escaped
+                qsizetype backslashes = 0;
+                for (const char16_t* p = pos; p > begin && p[-1] == u'\\'; --p) ++backslashes;
+                if (backslashes % 2 == 0) break;
+                ++pos;
+            }
+            span = QStringView(begin, pos);
+            escaped = span.contains(u'\\');
+            ++pos;
+            return true;
+        }
+
+        static int hexValue(char16_t c) {
+            if (c >= u'0' && c <= u'9') return c - u'0';
+            if (c >= u'a' && c <= u'f') return c - u'a' + 10;
+            if (c >= u'A' && c <= u'F') return c - u'A' + 10;
+            return -1;
+        }
+
+        bool unescape(QStringView span, QString& out) {
+            out.clear();
+            out.reserve(span.size());
+            for (qsizetype i = 0; i < span.size(); ++i) {
+                const QChar c = span[i];
+                if (c != u'\\') {
+                    out.append(c);
+                    continue;
+                }
+                if (++i >= span.size()) return fail("bad escape");
+                switch (span[i].unicode()) {
+                case u'"':  out.append(u'"'); break;
+                case u'\\': out.append(u'\\'); break;
+                case u'/':  out.append(u'/'); break;
+                case u'b':  out.append(u'\b'); break;
+                case u'f':  out.append(u'\f'); break;
+                case u'n':  out.append(u'\n'); break;
+                case u'r':  out.append(u'\r'); break;
+                case u't':  out.append(u'\t'); break;
+                case u'u': {
+                    if (i + 4 >= span.size()) return fail("bad \\u escape");
+                    int code = 0;
+                    for (int k = 1; k <= 4; ++k) {
+                        const int v = hexValue(span[i + k].unicode());
+                        if (v < 0) return fail("bad \\u escape");
+                        code = code * 16 + v;
+                    }
+                    out.append(QChar(char16_t(code))); // Surrogate pairs arrive as two escapes
+                    i += 4;
+                    break;
+                }
+                default:
+                    return fail("bad escape");
+                }
+            }
+            return true;
+        }
+
+        // String value; null or another type leaves 'out' empty
+        bool readString(QString& out) {
+            if (!peek(u'"')) return skipValue();
+            QStringView span;
+            bool escaped;
+            if (!stringSpan(span, escaped)) return false;
+            if (!escaped) {
+                out = span.toString();
+                return true;
+            }
+            return unescape(span, out);
+        }
+
+        // Number token; false (and nothing consumed) if the value is not a number
+        bool numberToken(QStringView& token) {
+            skipWhitespace();
+            if (pos >= end || (*pos != u'-' && (*pos < u'0' || *pos > u'9'))) return false;
+            const char16_t* begin = pos;
+            while (pos < end && (*pos == u'-' || *pos == u'+' || *pos == u'.' || *pos == u'e' || *pos == u'E'
+                || (*pos >= u'0' && *pos <= u'9'))) {
+                ++pos;
+            }
+            token = QStringView(begin, pos);
+            return true;
+        }
+
+        // Integer value; fractional or exponent forms are truncated, null or another type leaves 'out' unchanged
+        bool readUnsigned(quint64& out) {
+            QStringView token;
+            if (!numberToken(token)) return skipValue();
+            bool ok = false;
+            out = token.toULongLong(&ok);
+            if (!ok) {
+                const double value = token.toDouble(&ok);
+                if (!ok) return fail("bad number");
+                out = value > 0 ? quint64(value) : 0;
+            }
+            return true;
+        }
+
+        // Number value, null or another type leaves 'out' unchanged
+        bool readDouble(double& out) {
+            QStringView token;
+            if (!numberToken(token)) return skipValue();
+            bool ok = false;
+            const double value = token.toDouble(&ok);
+            if (!ok) return fail("bad number");
+            out = value;
+            return true;
+        }
+
+        bool readBool(bool& out) {
+            skipWhitespace();
+            const QStringView rest(pos, end);
+            if (rest.startsWith(u"true")) { out = true; pos += 4; return true; }
+            if (rest.startsWith(u"false")) { out = false; pos += 5; return true; }
+            return skipValue(); // null or another type: keep the default
+        }
+
+        bool skipLiteral() {
+            const char16_t* begin = pos;
+            while (pos < end && ((*pos >= u'a' && *pos <= u'z') || (*pos >= u'0' && *pos <= u'9')
+                || *pos == u'-' || *pos == u'+' || *pos == u'.' || *pos == u'E')) {
+                ++pos;
+            }
+            return pos != begin || fail("unexpected character");
+        }
+
+        bool skipValue(int depth = 0) {
+            if (depth > 64) return fail("nesting too deep");
+            skipWhitespace();
+            if (pos >= end) return fail("unexpected end");
+            if (*pos == u'"') {
+                QStringView span;
+                bool escaped;
+                return stringSpan(span, escaped);
+            }
+            if (*pos == u'{' || *pos == u'[') {
+                const char16_t close = *pos == u'{' ? u'}' : u']';
+                const bool isObject = *pos == u'{';
+                ++pos;
+                if (peek(close)) { ++pos; return true; }
+                while (true) {
+                    if (isObject) {
+                        QStringView key;
+                        bool escaped;
+                        if (!stringSpan(key, escaped) || !expect(u':')) return false;
+                    }
+                    if (!skipValue(depth + 1)) return false;
+                    if (peek(u',')) { ++pos; continue; }
+                    return expect(close);
+                }
+            }
+            return skipLiteral();
+        }
+
+        // Iterates the members of an object, calling member(key) positioned on each value.
+        // 'member' must consume the value.
+        template <typename Member>
+        bool forEachMember(Member&& member) {
+            if (!expect(u'{')) return false;
+            if (peek(u'}')) { ++pos; return true; }
+            while (true) {
+                QStringView key;
+                bool escaped;
+                if (!stringSpan(key, escaped) || !expect(u':')) return false;
+                if (!member(key)) return false;
+                if (peek(u',')) { ++pos; continue; }
+                return expect(u'}');
+            }
+        }
+
+        // Decodes a base64 string value straight from the text into 'out'
+        bool readBase64(QByteArray& out) {
+            QStringView span;
+            bool escaped;
+            if (!stringSpan(span, escaped)) return false;
+            const qint64 start = Trace::isEnabled() ? Trace::now() : 0;
+            struct Timer { // Base64 time, excluded from the envelope stage
+                qint64 start; qint64& total;
+                ~Timer() { if (start) total += Trace::now() - start; }
+            } timer{ start, base64Ns };
+            if (escaped) { // "\/" from some encoders
+                QString plain;
+                if (!unescape(span, plain)) return false;
+                return Base64::decode(plain, out) || fail("invalid base64 in 'data_compressed'");
+            }
+            out.resize(Base64::decodedSizeBound(span.size()));
+            const qsizetype size = Base64::decode(span.utf16(), span.size(), out.data());
+            if (size < 0) {
+                out.clear();
+                return fail("invalid base64 in 'data_compressed'");
+            }
+            out.resize(size);
+            return true;
+        }
+    };
+
+} // namespace
+
+bool MessageEnvelope::parse(QStringView text, MessageEnvelope& out, QString* errorMessage) {
+    const qint64 start = Trace::isEnabled() ? Trace::now() : 0;
+    out = MessageEnvelope();
+    Scanner scanner{ text.utf16(), text.utf16() + text.size(), {} };
+
+    auto readMetrics = [&scanner, &out]() {
+        if (!scanner.peek(u'{')) return scanner.skipValue();
+        return scanner.forEachMember([&scanner, &out](QStringView key) {
+            if (key != u"load_time") return scanner.skipValue();
+            double loadTime = 0;
+            if (!scanner.readDouble(loadTime)) return false;
+            // Seconds (e.g. Python time.time()) or milliseconds since epoch
+            out.trace.serverLoadMs = qint64(loadTime < 1e11 ? loadTime * 1000.0 : loadTime);
+            return true;
+        });
+    };
+
+    auto readData = [&scanner, &out]() {
+        scanner.skipWhitespace();
+        if (!scanner.peek(u'{')) return scanner.skipValue();
+        return scanner.forEachMember([&scanner, &out](QStringView key) {
+            if (key == u"symbol_name") return scanner.readString(out.symbol);
+            if (key == u"model_name") return scanner.readString(out.model);
+            return scanner.skipValue();
+        });
+    };
+
+    const bool ok = scanner.forEachMember([&](QStringView key) {
+        if (key == u"type") return scanner.readString(out.type);
+        if (key == u"symbol") return scanner.readString(out.symbol);
+        if (key == u"model") return scanner.readString(out.model);
+        if (key == u"data") return readData();
+        if (key == u"metrics") return readMetrics();
+        if (key == u"data_compressed") {
+            if (!scanner.peek(u'"')) return scanner.skipValue(); // null: reported as missing
+            out.hasPayload = true;
+            return scanner.readBase64(out.payload);
+        }
+        if (key == u"action") return scanner.readString(out.action);
+        if (key == u"success") return scanner.readBool(out.success);
+        if (key == u"error") return scanner.readString(out.error);
+        if (key == u"format") return scanner.readString(out.format);
+        if (key == u"codec") return scanner.readString(out.codec);
+        if (key == u"mode") return scanner.readString(out.mode);
+        if (key == u"date") return scanner.readString(out.date);
+        if (key == u"seq") return scanner.readUnsigned(out.sequence);
+        if (key == u"dict") {
+            quint64 id = 0;
+            if (!scanner.readUnsigned(id)) return false;
+            out.dictId = quint32(id);
+            return true;
+        }
+        return scanner.skipValue();
+    });
+
+    if (ok) {
+        scanner.skipWhitespace();
+        if (scanner.pos == scanner.end) {
+            if (start) {
+                Trace::record(Trace::Stage::Base64, scanner.base64Ns);
+                Trace::record(Trace::Stage::Envelope, Trace::now() - start - scanner.base64Ns);
+            }
+            return true;
+        }
+        scanner.fail("trailing characters");
+    }
+    if (errorMessage) {
+        *errorMessage = QString("%1 at offset %2").arg(scanner.error)
+            .arg(qsizetype(scanner.pos - text.utf16()));
+    }
+    return false;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QByteArray>
+#include <QMetaType>
+#include <QString>
+#include <QStringView>
+
+#include "Glob/Trace.h"
+
+// Envelope of a JSON text message, read without building a QJsonDocument.
+//
+// parseIncomingMessage used to convert the UTF-16 message back to UTF-8, build the whole DOM and
+// copy the QJsonObject into a signal, 'data_compressed' included. The scanner walks the message
+// text once, keeps only the fields the client uses and base64-decodes 'data_compressed' straight
+// from the message into 'payload', the only copy of the payload that is made.
+//
+// Known fields (unknown ones are skipped, key order does not matter):
+//   top level        type, symbol, model, action, success, error, format, codec, dict, seq, mode,
+//                    date, data_compressed
+//   "data" object    symbol_name, model_name (ticker_data / symbol_response)
+//   "metrics" object load_time (ms since epoch; seconds are accepted too)
+struct MessageEnvelope {
+    QString type;
+    QString symbol;      // "symbol", or "data.symbol_name"
+    QString model;       // "model", or "data.model_name"
+    QString action;      // symbol_response
+    QString error;       // symbol_response
+    QString format;      // hello_ack
+    QString codec;       // data_stream ("zlib" when empty)
+    QString mode;        // data_stream: "snapshot" (empty) or "delta"
+    QString date;        // data_stream: expiration date of the payload (ISO), optional
+    quint64 sequence = 0;
+    quint32 dictId = 0;
+    bool success = false;
+
+    bool hasPayload = false; // 'data_compressed' present as a string
+    QByteArray payload;      // Decoded 'data_compressed'
+
+    Trace::Timeline trace;   // receiveNs is set by the receiver, serverLoadMs from metrics.load_time
+
+    // Parses 'text'. Returns false on malformed JSON or invalid base64, with the reason in 'errorMessage'.
+    // Records the Envelope and Base64 trace stages.
+    static bool parse(QStringView text, MessageEnvelope& out, QString* errorMessage = nullptr);
+};
+
+Q_DECLARE_METATYPE(MessageEnvelope)
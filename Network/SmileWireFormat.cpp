@@ -0,0 +1,347 @@
+#include "SmileWireFormat.h"
+#include "Glob/Logger.h"
+#include "libs/Compressor.h"
+#include "Data/OptionSymbolTable.h"
+
+#include <QtEndian>
+#include <cstring>
+
+namespace SmileWire {
+
+namespace {
+
+    // Bounds-checked little-endian cursor over a byte range
+    struct Reader {
+        const char* pos;
+        const char* end;
+
+        bool has(qsizetype n) const { return n >= 0 && end - pos >= n; }
+
+        template <typename T>
+        bool read(T& out) {
+            if (!has(sizeof(T))) return false;
+            out = qFromLittleEndian<T>(pos);
+            pos += sizeof(T);
+            return true;
+        }
+
+        bool skip(qsizetype n) {
+            if (!has(n)) return false;
+            pos += n;
+            return true;
+        }
+    };
+
+    template <typename T>
+    void writeLE(QByteArray& out, T value) {
+        char buf[sizeof(T)];
+        qToLittleEndian<T>(value, buf);
+        out.append(buf, sizeof(T));
+    }
+
+    // Copies 'rows' little-endian doubles into a column (bulk memcpy on little-endian hosts)
+    void readDoubles(const char* src, qsizetype rows, QVector<double>& column) {
+        column.resize(rows);
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        std::memcpy(column.data(), src, rows * sizeof(double));
+#else
+        for (qsizetype i = 0; i < rows; ++i) {
+            const quint64 bits = qFromLittleEndian<quint64>(src + i * sizeof(double));
+            std::memcpy(&column[i], &bits, sizeof(double));
+        }
+#endif
+    }
+
+    void writeDoubles(QByteArray& out, const QVector<double>& column) {
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        out.append(reinterpret_cast<const char*>(column.constData()), column.size() * sizeof(double));
+#else
+        for (double v : column) {
+            quint64 bits;
+            std::memcpy(&bits, &v, sizeof(double));
+            writeLE<quint64>(out, bits);
+        }
+#endif
+    }
+
+    template <typename Data> // PlotDataForDate or const PlotDataForDate
+    auto columnForId(quint8 id, Data& data) -> decltype(&data.strike) {
+        switch (id) {
+        case ColLogMoneyness: return &data.logMoneyness;
+        case ColStrike: return &data.strike;
+        case ColTheoIv: return &data.theoIv;
+        case ColMidIv: return &data.midIv;
+        case ColBidIv: return &data.bidIv;
+        case ColAskIv: return &data.askIv;
+        case ColBidPrice: return &data.bidPrice;
+        case ColAskPrice: return &data.askPrice;
+        default: return nullptr;
+        }
+    }
+
+    struct Header {
+        quint8 version = 0;
+        quint8 flags = 0;
+        quint16 headerSize = 0;
+        quint64 sequence = 0;
+        qint32 julianDay = 0;
+        quint32 rowCount = 0;
+        quint16 columnCount = 0;
+        QString symbol;
+        QString model;
+    };
+
+    bool readHeader(Reader& reader, Header& header) {
+        const char* const start = reader.pos;
+        if (!reader.has(HeaderSize) || std::memcmp(reader.pos, Magic, sizeof(Magic)) != 0) {
+            Log.msg(FNAME + "Not a smile frame (bad magic or too short).", Logger::Level::WARNING);
+            return false;
+        }
+        reader.skip(sizeof(Magic));
+
+        quint16 symbolLen = 0, modelLen = 0, reserved = 0;
+        reader.read(header.version);
+        reader.read(header.flags);
+        reader.read(header.headerSize);
+        reader.read(header.sequence);
+        reader.read(header.julianDay);
+        reader.read(header.rowCount);
+        reader.read(header.columnCount);
+        reader.read(symbolLen);
+        reader.read(modelLen);
+        reader.read(reserved);
+
+        if (header.version != Version) {
+            Log.msg(FNAME + QString("Unsupported smile frame version %1 (expected %2).")
+                .arg(header.version).arg(Version), Logger::Level::WARNING);
+            return false;
+        }
+        if (header.headerSize < HeaderSize || !reader.skip(header.headerSize - (reader.pos - start))) {
+            Log.msg(FNAME + "Invalid smile frame header size.", Logger::Level::WARNING);
+            return false;
+        }
+        if (!reader.has(symbolLen + modelLen)) {
+            Log.msg(FNAME + "Smile frame truncated in symbol/model.", Logger::Level::WARNING);
+            return false;
+        }
+        header.symbol = QString::fromUtf8(reader.pos, symbolLen);
+        reader.skip(symbolLen);
+        header.model = QString::fromUtf8(reader.pos, modelLen);
+        reader.skip(modelLen);
+        return true;
+    }
+
+    bool readColumns(Reader& reader, const Header& header, PlotDataForDate& data, QVector<quint8>& ops) {
+        const qsizetype rows = header.rowCount;
+        bool hasX = false;
+
+        for (quint16 c = 0; c < header.columnCount; ++c) {
+            quint8 id = 0, type = 0;
+            quint16 reserved = 0;
+            quint32 byteLength = 0;
+            if (!reader.read(id) || !reader.read(type) || !reader.read(reserved) || !reader.read(byteLength)
+                || !reader.has(byteLength)) {
+                Log.msg(FNAME + "Smile frame truncated in column block " + QString::number(c), Logger::Level::WARNING);
+                return false;
+            }
+            const char* payload = reader.pos;
+            reader.skip(byteLength);
+
+            if (type == TypeF64) {
+                QVector<double>* column = columnForId(id, data);
+                if (!column) continue; // Unknown numeric column, skipped
+                if (byteLength != static_cast<quint64>(rows) * sizeof(double)) {
+                    Log.msg(FNAME + QString("Column %1 has %2 bytes, expected %3.")
+                        .arg(id).arg(byteLength).arg(rows * sizeof(double)), Logger::Level::WARNING);
+                    return false;
+                }
+                readDoubles(payload, rows, *column);
+                hasX = hasX || (id == ColLogMoneyness);
+            }
+            else if (type == TypeUtf8 && id == ColOptionSymbol) {
+                const qsizetype offsetsBytes = (rows + 1) * sizeof(quint32);
+                if (byteLength < offsetsBytes) {
+                    Log.msg(FNAME + "Option symbol column too short for its offsets.", Logger::Level::WARNING);
+                    return false;
+                }
+                const char* strings = payload + offsetsBytes;
+                const quint32 stringsSize = byteLength - offsetsBytes;
+                OptionSymbolTable& table = OptionSymbolTable::instance();
+                data.symbolId.resize(rows);
+                quint32 begin = qFromLittleEndian<quint32>(payload);
+                for (qsizetype i = 0; i < rows; ++i) {
+                    const quint32 end = qFromLittleEndian<quint32>(payload + (i + 1) * sizeof(quint32));
+                    if (begin > end || end > stringsSize) {
+                        Log.msg(FNAME + "Option symbol offsets out of range at row " + QString::number(i),
+                            Logger::Level::WARNING);
+                        return false;
+                    }
+                    data.symbolId[i] = table.intern(strings + begin, end - begin);
+                    begin = end;
+                }
+            }
+            else if (type == TypeU8 && id == ColOp) {
+                if (byteLength != static_cast<quint64>(rows)) {
+                    Log.msg(FNAME + "Op column size does not match the row count.", Logger::Level::WARNING);
+                    return false;
+                }
+                ops.resize(rows);
+                std::memcpy(ops.data(), payload, rows);
+            }
+            // Other types/ids: unknown to this client, skipped by length
+        }
+
+        if (!hasX) {
+            Log.msg(FNAME + "Smile frame has no log_moneyness column.", Logger::Level::WARNING);
+            return false;
+        }
+
+        // Absent columns are zero-filled so every column has the same row count
+        for (quint8 id = ColLogMoneyness; id <= ColAskPrice; ++id) {
+            QVector<double>* column = columnForId(id, data);
+            if (column->size() != rows) column->fill(0.0, rows);
+        }
+        if (data.symbolId.size() != rows) data.symbolId.fill(OptionSymbolTable::InvalidId, rows);
+        return true;
+    }
+
+} // namespace
+
+bool isSmileFrame(const QByteArray& bytes) {
+    return bytes.size() >= HeaderSize && std::memcmp(bytes.constData(), Magic, sizeof(Magic)) == 0;
+}
+
+bool peekHeader(const QByteArray& bytes, QString& outSymbol, QString& outModel, bool* outDelta, quint64* outSequence,
+    QDate* outDate) {
+    Reader reader{ bytes.constData(), bytes.constData() + bytes.size() };
+    Header header;
+    if (!readHeader(reader, header)) return false;
+    outSymbol = header.symbol;
+    outModel = header.model;
+    if (outDelta) *outDelta = (header.flags & FlagDelta) != 0;
+    if (outSequence) *outSequence = header.sequence;
+    if (outDate) *outDate = QDate::fromJulianDay(header.julianDay);
+    return true;
+}
+
+bool decode(const QByteArray& bytes, Frame& outFrame) {
+    outFrame.data.clear();
+    outFrame.ops.clear();
+
+    Reader reader{ bytes.constData(), bytes.constData() + bytes.size() };
+    Header header;
+    if (!readHeader(reader, header)) return false;
+
+    outFrame.symbol = header.symbol;
+    outFrame.model = header.model;
+    outFrame.sequence = header.sequence;
+    outFrame.delta = (header.flags & FlagDelta) != 0;
+    outFrame.date = QDate::fromJulianDay(header.julianDay);
+    if (!outFrame.date.isValid()) {
+        Log.msg(FNAME + "Smile frame has an invalid snapshot date.", Logger::Level::WARNING);
+        return false;
+    }
+
+    QByteArray inflated; // Owns the body when it was compressed
+    if (header.flags & FlagZlib) {
+        quint32 rawSize = 0;
+        if (!reader.read(rawSize)) {
+            Log.msg(FNAME + "Compressed smile frame is missing its raw size.", Logger::Level::WARNING);
+            return false;
+        }
+        if (qsizetype(rawSize) > Compressor::MaxDecompressedSize) {
+            Log.msg(FNAME + QString("Compressed smile frame claims %1 raw bytes, rejected.").arg(rawSize),
+                Logger::Level::WARNING);
+            return false;
+        }
+        // The raw size is exact, so the pooled buffer is sized once and never grows while inflating
+        inflated = Compressor::Inflater::local().inflate(reader.pos, reader.end - reader.pos, rawSize);
+        if (static_cast<quint32>(inflated.size()) != rawSize) {
+            Log.msg(FNAME + QString("Inflated smile body is %1 bytes, expected %2.")
+                .arg(inflated.size()).arg(rawSize), Logger::Level::WARNING);
+            return false;
+        }
+        reader = Reader{ inflated.constData(), inflated.constData() + inflated.size() };
+    }
+
+    return readColumns(reader, header, outFrame.data, outFrame.ops);
+}
+
+QByteArray encode(const Frame& frame, bool compress) {
+    const PlotDataForDate& data = frame.data;
+    const qsizetype rows = data.size();
+    const QByteArray symbol = frame.symbol.toUtf8();
+    const QByteArray model = frame.model.toUtf8();
+
+    // --- Column blocks ---
+    QByteArray body;
+    body.reserve(rows * (8 * sizeof(double) + 32) + 256);
+    quint16 columnCount = 0;
+
+    auto beginBlock = [&](quint8 id, quint8 type, quint32 byteLength) {
+        writeLE<quint8>(body, id);
+        writeLE<quint8>(body, type);
+        writeLE<quint16>(body, 0);
+        writeLE<quint32>(body, byteLength);
+        ++columnCount;
+    };
+
+    const quint8 numericIds[] = { ColLogMoneyness, ColStrike, ColTheoIv, ColMidIv, ColBidIv, ColAskIv, ColBidPrice, ColAskPrice };
+    for (quint8 id : numericIds) {
+        const QVector<double>* column = columnForId(id, data);
+        beginBlock(id, TypeF64, static_cast<quint32>(rows * sizeof(double)));
+        writeDoubles(body, *column);
+    }
+
+    if (data.symbolId.size() == rows) {
+        OptionSymbolTable& table = OptionSymbolTable::instance();
+        QByteArray strings;
+        QByteArray offsets;
+        writeLE<quint32>(offsets, 0);
+        for (qsizetype i = 0; i < rows; ++i) {
+            strings.append(table.symbol(data.symbolId[i]).toUtf8());
+            writeLE<quint32>(offsets, static_cast<quint32>(strings.size()));
+        }
+        beginBlock(ColOptionSymbol, TypeUtf8, static_cast<quint32>(offsets.size() + strings.size()));
+        body.append(offsets);
+        body.append(strings);
+    }
+
+    if (frame.delta && frame.ops.size() == rows) {
+        beginBlock(ColOp, TypeU8, static_cast<quint32>(rows));
+        body.append(reinterpret_cast<const char*>(frame.ops.constData()), rows);
+    }
+
+    // --- Header ---
+    quint8 flags = frame.delta ? FlagDelta : FlagNone;
+    QByteArray payload = body;
+    if (compress) {
+        QByteArray compressed = Compressor::compressZlib(body);
+        if (!compressed.isEmpty() && compressed.size() + 4 < body.size()) {
+            flags |= FlagZlib;
+            payload.clear();
+            writeLE<quint32>(payload, static_cast<quint32>(body.size()));
+            payload.append(compressed);
+        }
+    }
+
+    QByteArray out;
+    out.reserve(HeaderSize + symbol.size() + model.size() + payload.size());
+    out.append(Magic, sizeof(Magic));
+    writeLE<quint8>(out, Version);
+    writeLE<quint8>(out, flags);
+    writeLE<quint16>(out, HeaderSize);
+    writeLE<quint64>(out, frame.sequence);
+    writeLE<qint32>(out, static_cast<qint32>(frame.date.toJulianDay()));
+    writeLE<quint32>(out, static_cast<quint32>(rows));
+    writeLE<quint16>(out, columnCount);
+    writeLE<quint16>(out, static_cast<quint16>(symbol.size()));
+    writeLE<quint16>(out, static_cast<quint16>(model.size()));
+    writeLE<quint16>(out, 0);
+    out.append(symbol);
+    out.append(model);
+    out.append(payload);
+    return out;
+}
+
+} // namespace SmileWire
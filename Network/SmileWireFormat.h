@@ -0,0 +1,94 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QDate>
+
+#include "Plots/PlotDataForDate.h"
+
+// Binary columnar smile frame ("smile-bin-v1"), sent as a WebSocket binary message.
+//
+// All integers and doubles are little-endian. Layout:
+//
+//   Header (32 bytes)
+//     0  char[4] magic "DASM"
+//     4  u8      version (SmileWire::Version)
+//     5  u8      flags (SmileWire::Flag)
+//     6  u16     header size in bytes (32, larger values are skipped for forward compatibility)
+//     8  u64     sequence number (per symbol/model)
+//     16 i32     snapshot date as Julian day
+//     20 u32     row count
+//     24 u16     column count
+//     26 u16     symbol length (UTF-8 bytes)
+//     28 u16     model length (UTF-8 bytes)
+//     30 u16     reserved
+//   symbol bytes, model bytes
+//   Body (zlib stream prefixed by u32 raw size when FlagZlib is set)
+//     column count x { u8 column id, u8 type, u16 reserved, u32 byte length, payload }
+//       F64  payload: row count doubles
+//       Utf8 payload: u32 offsets[row count + 1] followed by the string bytes
+//       U8   payload: row count bytes
+//
+// With FlagDelta the rows are a delta on top of the previous frame (see Data/SmileDelta.h):
+// the ColOp column holds one SmileDelta::Op per row and the sequence must be contiguous.
+//
+// Unknown column ids are skipped by byte length, so new columns can be added without a version bump.
+namespace SmileWire {
+
+    const char Magic[4] = { 'D', 'A', 'S', 'M' };
+    constexpr quint8 Version = 1;
+    constexpr quint16 HeaderSize = 32;
+
+    // Format names used in the "hello" content negotiation
+    const QString FormatBinary = "smile-bin-v1";
+    const QString FormatJsonCsv = "json-csv";
+
+    enum Flag : quint8 {
+        FlagNone = 0x00,
+        FlagZlib = 0x01, // Body is zlib compressed
+        FlagDelta = 0x02 // Rows are upserts/deletes keyed by option symbol
+    };
+
+    enum ColumnType : quint8 {
+        TypeF64 = 1,
+        TypeUtf8 = 2,
+        TypeU8 = 3
+    };
+
+    enum ColumnId : quint8 {
+        ColLogMoneyness = 1,
+        ColStrike = 2,
+        ColTheoIv = 3,
+        ColMidIv = 4,
+        ColBidIv = 5,
+        ColAskIv = 6,
+        ColBidPrice = 7,
+        ColAskPrice = 8,
+        ColOptionSymbol = 9,
+        ColOp = 10
+    };
+
+    struct Frame {
+        QString symbol;
+        QString model;
+        QDate date;
+        quint64 sequence = 0;
+        bool delta = false;
+        PlotDataForDate data;
+        QVector<quint8> ops; // Delta frames only, one SmileDelta::Op per row
+    };
+
+    // True if the bytes start with the frame magic
+    bool isSmileFrame(const QByteArray& bytes);
+
+    // Reads only the fixed header and symbol/model (cheap, used to route the frame to its ingest worker)
+    bool peekHeader(const QByteArray& bytes, QString& outSymbol, QString& outModel,
+        bool* outDelta = nullptr, quint64* outSequence = nullptr, QDate* outDate = nullptr);
+
+    // Decodes a full frame straight into the smile columns
+    bool decode(const QByteArray& bytes, Frame& outFrame);
+
+    // Encodes a frame (used by the stand-in server and tools)
+    QByteArray encode(const Frame& frame, bool compress = true);
+
+} // namespace SmileWire
@@ -1,304 +1,465 @@
-#include "WebSocketClient.h"
-#include "Glob/Logger.h"
-
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonValue>
-#include <QDebug>
-#include <QAbstractSocket> // SocketError enum
-#include <QTimerEvent>
-
-WebSocketClient::WebSocketClient(QObject* parent) : QObject(parent) {
-    connect(&m_webSocket, &QWebSocket::connected, this, &WebSocketClient::onConnected);
-    connect(&m_webSocket, &QWebSocket::disconnected, this, &WebSocketClient::onDisconnected);
-    connect(&m_webSocket, &QWebSocket::textMessageReceived, this, &WebSocketClient::onTextMessageReceived);
-    // Handle error signal correctly
-    connect(&m_webSocket, QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::errorOccurred),
-        this, &WebSocketClient::onError);
-
-    // Setup reconnect timer
-    m_reconnectTimer.setInterval(RECONNECT_INTERVAL_MS);
-    m_reconnectTimer.setSingleShot(true); // Important: Fire only once per interval
-    connect(&m_reconnectTimer, &QTimer::timeout, this, &WebSocketClient::attemptConnection);
-
-    // Register QVariantMap if passing it through signals/slots
-    qRegisterMetaType<QVariantMap>("QVariantMap");
-    qRegisterMetaType<QJsonObject>("QJsonObject");
-}
-
-WebSocketClient::~WebSocketClient() {
-    disconnectFromServer();
-}
-
-void WebSocketClient::connectToServer(const QUrl& url) {
-    Log.msg(QString("WebSocketClient: Connecting to %1").arg(url.toString()), Logger::Level::INFO);
-
-    if (m_isConnected || m_webSocket.state() == QAbstractSocket::ConnectingState) {
-        Log.msg(FNAME + "WebSocketClient: Already connected or connecting.", Logger::Level::WARNING);
-        return;
-    }
-    m_url = url;
-    m_explicitDisconnect = false; // Reset flag, we intend to connect
-
-    // Stop any previous timer/connection attempts immediately
-    m_reconnectTimer.stop();
-    if (m_webSocket.state() != QAbstractSocket::UnconnectedState) {
-        Log.msg(FNAME + "Aborting previous socket connection.", Logger::Level::DEBUG);
-        m_webSocket.abort(); // Force close immediately
-    }
-    m_isConnected = false; // Ensure state is correct
-
-    // Start connection attempts immediately
-    startConnectionAttempts();
-}
-
-void WebSocketClient::disconnectFromServer() {
-    Log.msg(FNAME + "Explicit disconnect requested.", Logger::Level::DEBUG);
-
-    m_explicitDisconnect = true; // Set flag to prevent automatic reconnect
-    m_reconnectTimer.stop();     // Stop trying to reconnect
-
-    if (m_webSocket.state() != QAbstractSocket::UnconnectedState) {
-        m_webSocket.close(QWebSocketProtocol::CloseCodeNormal, "Client disconnecting");
-    }
-    else {
-        // If already unconnected, ensure state is updated and disconnected signal emitted if needed
-        if (m_isConnected) {
-            m_isConnected = false;
-            emit disconnected(); // Emit signal if we thought we were connected
-        }
-    }
-    // onDisconnected slot will handle setting m_isConnected = false when socket confirms closure
-}
-
-void WebSocketClient::startConnectionAttempts() {
-    if (m_url.isEmpty() || !m_url.isValid()) {
-        Log.msg(FNAME + "Cannot start connection attempts: URL is invalid or empty.", Logger::Level::ERROR);
-        return;
-    }
-    if (m_isConnected) {
-        Log.msg(FNAME + "Already connected.", Logger::Level::DEBUG);
-        return;
-    }
-    if (m_reconnectTimer.isActive()) {
-        Log.msg(FNAME + "Connection attempts already in progress.", Logger::Level::DEBUG);
-        return;
-    }
-    m_explicitDisconnect = false; // We intend to connect
-
-    Log.msg("WebSocketClient: Starting connection attempts to " + m_url.toString(), Logger::Level::DEBUG);
-
-    // Trigger the first attempt immediately
-    attemptConnection();
-}
-
-bool WebSocketClient::isConnected() const {
-    return m_isConnected;
-}
-
-void WebSocketClient::addSymbol(const QString& symbol, const QString& model, const QVariantMap& settings) {
-    Log.msg(FNAME + QString("WebSocketClient: Requesting add symbol[%1/%2]").arg(symbol, model), Logger::Level::DEBUG);
-
-    QJsonObject dataObject;
-    dataObject["symbol_name"] = symbol;
-    dataObject["model_name"] = model;
-    dataObject["model_settings"] = QJsonObject::fromVariantMap(settings); // Assuming settings are simple key-value
-
-    QJsonObject requestObject;
-    requestObject["type"] = "symbol";
-    requestObject["action"] = "add";
-    requestObject["data"] = dataObject;
-
-    sendJsonMessage(requestObject);
-}
-
-void WebSocketClient::removeSymbol(const QString& symbol, const QString& model) {
-    Log.msg(FNAME + QString("WebSocketClient: Requesting remove symbol[%1/%2]").arg(symbol, model), Logger::Level::DEBUG);
-
-    QJsonObject dataObject;
-    dataObject["symbol_name"] = symbol;
-    dataObject["model_name"] = model;
-
-    QJsonObject requestObject;
-    requestObject["type"] = "symbol";
-    requestObject["action"] = "remove";
-    requestObject["data"] = dataObject;
-
-    sendJsonMessage(requestObject);
-}
-
-void WebSocketClient::updateSymbolSettings(const QString& symbol, const QString& model, const QVariantMap& settings) {
-    Log.msg(FNAME + QString("WebSocketClient: Requesting update symbol[%1/%2]").arg(symbol, model), Logger::Level::DEBUG);
-    QJsonObject dataObject;
-    dataObject["symbol_name"] = symbol;
-    dataObject["model_name"] = model;
-    dataObject["model_settings"] = QJsonObject::fromVariantMap(settings);
-
-    QJsonObject requestObject;
-    requestObject["type"] = "symbol";
-    requestObject["action"] = "update";
-    requestObject["data"] = dataObject;
-
-    sendJsonMessage(requestObject);
-}
-
-void WebSocketClient::pauseSymbol(const QString& symbol, const QString& model) {
-    Log.msg(FNAME + QString("WebSocketClient: Requesting pause symbol[%1/%2]").arg(symbol, model), Logger::Level::DEBUG);
-}
-
-void WebSocketClient::resumeSymbol(const QString& symbol, const QString& model) {
-    Log.msg(FNAME + QString("WebSocketClient: Requesting resume symbol[%1/%2]").arg(symbol, model), Logger::Level::DEBUG);
-}
-
-
-// --- Private Slots (Implement later with actual QWebSocket logic) ---
-
-void WebSocketClient::attemptConnection() {
-    if (m_explicitDisconnect || m_isConnected) {
-        Log.msg(FNAME + "WebSocketClient: Skipping connection attempt (explicit disconnect or already connected).", 
-            Logger::Level::DEBUG);
-        return; // Don't attempt if explicitly disconnected or already connected
-    }
-
-    if (m_webSocket.state() == QAbstractSocket::UnconnectedState) {
-        Log.msg("WebSocketClient: Attempting to connect to " + m_url.toString(), Logger::Level::DEBUG);
-        m_webSocket.open(m_url);
-    }
-    else {
-        Log.msg(FNAME + "WebSocketClient: Socket not in UnconnectedState (" + QString::number(m_webSocket.state()) + 
-            "), skipping connection attempt.", Logger::Level::DEBUG);
-        // Maybe schedule another check later if state is Connecting/Closing?
-        // For now, rely on disconnected/error signals to trigger next attempt.
-    }
-}
-
-
-void WebSocketClient::onConnected() {
-    Log.msg("WebSocketClient: WebSocket connected successfully to " + m_url.toString(), Logger::Level::INFO);
-    m_isConnected = true;
-    m_explicitDisconnect = false; // Connection successful, clear flag
-    m_reconnectTimer.stop(); // Stop timer, we are connected
-    emit connected();
-}
-
-void WebSocketClient::onDisconnected() {
-    // This slot is called both for clean disconnects and after errors that close the socket.
-    bool wasConnected = m_isConnected;
-    m_isConnected = false; // Update state regardless of reason
-
-    if (m_explicitDisconnect) {
-        Log.msg(FNAME + "WebSocketClient: WebSocket disconnected (explicitly requested).", Logger::Level::INFO);
-    }
-    else {
-        Log.msg(FNAME + "WebSocketClient: WebSocket disconnected (unexpectedly or after error).", Logger::Level::DEBUG);
-        // Schedule a reconnect attempt only if it wasn't an explicit disconnect
-        scheduleReconnect();
-    }
-
-    // Emit signal only if we were previously connected
-    if (wasConnected) {
-        emit disconnected();
-    }
-}
-
-void WebSocketClient::onTextMessageReceived(const QString& message) {
-    // qInfo() << "WebSocketClient: Message received:" << message; // Can be very verbose
-    parseIncomingMessage(message);
-}
-
-void WebSocketClient::onError(QAbstractSocket::SocketError error) {
-    // Avoid logging "RemoteHostClosedError" as a critical error if it happens during normal disconnect
-    if (error == QAbstractSocket::RemoteHostClosedError && !m_isConnected) {
-        Log.msg(FNAME + QString("WebSocketClient: Connection closed by remote host (expected during disconnect)."), 
-            Logger::Level::INFO);
-    }
-    else {
-        QString errorString = m_webSocket.errorString();
-        Log.msg(FNAME + QString("WebSocketClient: Error occurred: %1").arg(errorString),
-            Logger::Level::ERROR);
-        emit errorOccurred(errorString);
-    }
-}
-
-
-// --- Private Helpers ---
-
-void WebSocketClient::scheduleReconnect() {
-    if (m_explicitDisconnect) {
-        Log.msg(FNAME + "Reconnect suppressed due to explicit disconnect.", Logger::Level::DEBUG);
-        return; // Don't schedule if explicitly disconnected
-    }
-    if (m_reconnectTimer.isActive()) {
-        return; // Already scheduled
-    }
-
-    Log.msg("Scheduling connection attempt in " + QString::number(RECONNECT_INTERVAL_MS / 1000) + " s.", 
-        Logger::Level::INFO);
-    m_reconnectTimer.start(); // Start the single-shot timer
-}
-
-void WebSocketClient::sendJsonMessage(const QJsonObject& json) {
-    if (!m_isConnected) {
-        Log.msg(FNAME + QString("WebSocketClient: Cannot send message, not connected."),Logger::Level::WARNING);
-        return;
-    }
-    QJsonDocument doc(json);
-    QString messageStr = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
-    // qInfo() << "WebSocketClient: Sending:" << messageStr; // For debugging
-    m_webSocket.sendTextMessage(messageStr);
-}
-
-void WebSocketClient::parseIncomingMessage(const QString& message) {
-    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
-    if (doc.isNull() || !doc.isObject()) {
-        Log.msg(FNAME + QString("WebSocketClient: Received invalid JSON: %1").arg(message), Logger::Level::WARNING);
-        return;
-    }
-
-    QJsonObject obj = doc.object();
-    QString type = obj.value("type").toString();
-
-    if (type == "ticker_data") { // Example: receiving ticker data
-        QJsonObject data = obj.value("data").toObject();
-        QString symbol = data.value("symbol_name").toString();
-        QString model = data.value("model_name").toString();
-        // Assuming the rest of 'data' contains the fields for the table
-        QVariantMap tickerFields = data.toVariantMap();
-        // Remove keys we already extracted if they are not needed in the map itself
-        tickerFields.remove("symbol_name");
-        tickerFields.remove("model_name");
-
-        if (!symbol.isEmpty() && !model.isEmpty()) {
-            emit tickerDataReceived(symbol, model, obj);
-        }
-        else {
-            Log.msg(FNAME + QString("WebSocketClient: Received ticker data with missing symbol/model: %1").arg(message), 
-                Logger::Level::WARNING);
-        }
-    }
-    else if (type == "symbol_response") { 
-        QString action = obj.value("action").toString();
-        bool success = obj.value("success").toBool(false); 
-        QJsonObject data = obj.value("data").toObject();
-        QString symbol = data.value("symbol_name").toString();
-        QString model = data.value("model_name").toString();
-        QString errorMsg = obj.value("error").toString();
-
-        if (action == "add") {
-            if (success) emit symbolAddConfirmed(symbol, model);
-            else emit symbolAddFailed(symbol, model, errorMsg.isEmpty() ? "Unknown add error" : errorMsg);
-        }
-        else if (action == "remove") {
-            if (success) emit symbolRemoveConfirmed(symbol, model);
-            // else emit symbolRemoveFailed(symbol, model, errorMsg); // Add if needed
-        }
-        else if (action == "update") {
-            if (success) emit symbolUpdateConfirmed(symbol, model);
-            // else emit symbolUpdateFailed(symbol, model, errorMsg); // Add if needed
-        }
-    }
-    else {
-        Log.msg(FNAME + QString("WebSocketClient: Received unhandled message type: %1").arg(type),
-            Logger::Level::WARNING);
-    }
+#include "WebSocketClient.h"
+#include "Glob/Logger.h"
+#include "Glob/Config.h"
+#include "SmileWireFormat.h"
+#include "libs/CodecRegistry.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QJsonArray>
+#include <QDebug>
+#include <QAbstractSocket> // SocketError enum
+#include <QTimerEvent>
+#include <QThread>
+#include <QDateTime>
+
+WebSocketClient::WebSocketClient()
+    : QObject(nullptr)
+    , m_webSocket(QString(), QWebSocketProtocol::VersionLatest, this)
+    , m_reconnectTimer(this)
+    , m_replayer(this) {
+    connect(&m_webSocket, &QWebSocket::connected, this, &WebSocketClient::onConnected);
+    connect(&m_webSocket, &QWebSocket::disconnected, this, &WebSocketClient::onDisconnected);
+    connect(&m_webSocket, &QWebSocket::textMessageReceived, this, &WebSocketClient::onTextMessageReceived);
+    connect(&m_webSocket, &QWebSocket::binaryMessageReceived, this, &WebSocketClient::onBinaryMessageReceived);
+    // Handle error signal correctly
+    connect(&m_webSocket, QOverload<QAbstractSocket::SocketError>::of(&QWebSocket::errorOccurred),
+        this, &WebSocketClient::onError);
+
+    // Setup reconnect timer
+    m_reconnectTimer.setInterval(RECONNECT_INTERVAL_MS);
+    m_reconnectTimer.setSingleShot(true); // Important: Fire only once per interval
+    connect(&m_reconnectTimer, &QTimer::timeout, this, &WebSocketClient::attemptConnection);
+
+    // Replayed messages take the socket's path (same thread, direct)
+    connect(&m_replayer, &FeedReplayer::textMessage, this, &WebSocketClient::onTextMessageReceived);
+    connect(&m_replayer, &FeedReplayer::binaryMessage, this, &WebSocketClient::onBinaryMessageReceived);
+    connect(&m_replayer, &FeedReplayer::finished, this, &WebSocketClient::replayFinished);
+
+    // Register QVariantMap if passing it through signals/slots
+    qRegisterMetaType<QVariantMap>("QVariantMap");
+    qRegisterMetaType<QJsonObject>("QJsonObject");
+    qRegisterMetaType<MessageEnvelope>("MessageEnvelope");
+}
+
+WebSocketClient::~WebSocketClient() {
+    shutdown();
+    disconnectFromServer();
+}
+
+void WebSocketClient::startNetworkThread() {
+    if (m_networkThread) {
+        return;
+    }
+    m_networkThread = new QThread();
+    m_networkThread->setObjectName("Network");
+    moveToThread(m_networkThread); // Takes the socket and the reconnect timer along
+    m_networkThread->start();
+    Log.msg(FNAME + "WebSocketClient: Running on the network thread.", Logger::Level::INFO);
+}
+
+void WebSocketClient::shutdown() {
+    if (!m_networkThread) {
+        return;
+    }
+    QThread* callerThread = QThread::currentThread();
+    QMetaObject::invokeMethod(this, [this, callerThread]() {
+        disconnectFromServer();
+        m_webSocket.abort(); // Do not wait for the close handshake, the event loop stops next
+        m_replayer.stop();
+        m_recorder.close();
+        moveToThread(callerThread);
+    }, Qt::BlockingQueuedConnection);
+
+    m_networkThread->quit();
+    m_networkThread->wait();
+    delete m_networkThread;
+    m_networkThread = nullptr;
+}
+
+template <typename Call>
+bool WebSocketClient::onNetworkThread(Call&& call) {
+    if (QThread::currentThread() == thread()) {
+        return true;
+    }
+    QMetaObject::invokeMethod(this, std::forward<Call>(call), Qt::QueuedConnection);
+    return false;
+}
+
+void WebSocketClient::connectToServer(const QUrl& url) {
+    if (!onNetworkThread([this, url]() { connectToServer(url); })) return;
+
+    Log.msg(QString("WebSocketClient: Connecting to %1").arg(url.toString()), Logger::Level::INFO);
+
+    if (m_isConnected || m_webSocket.state() == QAbstractSocket::ConnectingState) {
+        Log.msg(FNAME + "WebSocketClient: Already connected or connecting.", Logger::Level::WARNING);
+        return;
+    }
+    m_url = url;
+    m_explicitDisconnect = false; // Reset flag, we intend to connect
+
+    // Stop any previous timer/connection attempts immediately
+    m_reconnectTimer.stop();
+    if (m_webSocket.state() != QAbstractSocket::UnconnectedState) {
+        Log.msg(FNAME + "Aborting previous socket connection.", Logger::Level::DEBUG);
+        m_webSocket.abort(); // Force close immediately
+    }
+    m_isConnected = false; // Ensure state is correct
+
+    // Start connection attempts immediately
+    startConnectionAttempts();
+}
+
+void WebSocketClient::startRecording(const QString& fileName) {
+    if (!onNetworkThread([this, fileName]() { startRecording(fileName); })) return;
+    m_recorder.open(fileName);
+}
+
+void WebSocketClient::stopRecording() {
+    if (!onNetworkThread([this]() { stopRecording(); })) return;
+    m_recorder.close();
+}
+
+void WebSocketClient::startReplay(const QString& fileName, double speed, FeedReplayer::BacklogProbe backlog, int maxBacklog) {
+    if (!onNetworkThread([this, fileName, speed, backlog, maxBacklog]() { startReplay(fileName, speed, backlog, maxBacklog); })) return;
+    if (!m_replayer.start(fileName, speed, std::move(backlog), maxBacklog)) {
+        emit replayFinished(0, 0);
+    }
+}
+
+void WebSocketClient::disconnectFromServer() {
+    if (!onNetworkThread([this]() { disconnectFromServer(); })) return;
+
+    Log.msg(FNAME + "Explicit disconnect requested.", Logger::Level::DEBUG);
+
+    m_explicitDisconnect = true; // Set flag to prevent automatic reconnect
+    m_reconnectTimer.stop();     // Stop trying to reconnect
+
+    if (m_webSocket.state() != QAbstractSocket::UnconnectedState) {
+        m_webSocket.close(QWebSocketProtocol::CloseCodeNormal, "Client disconnecting");
+    }
+    else {
+        // If already unconnected, ensure state is updated and disconnected signal emitted if needed
+        if (m_isConnected) {
+            m_isConnected = false;
+            emit disconnected(); // Emit signal if we thought we were connected
+        }
+    }
+    // onDisconnected slot will handle setting m_isConnected = false when socket confirms closure
+}
+
+void WebSocketClient::startConnectionAttempts() {
+    if (!onNetworkThread([this]() { startConnectionAttempts(); })) return;
+
+    if (m_url.isEmpty() || !m_url.isValid()) {
+        Log.msg(FNAME + "Cannot start connection attempts: URL is invalid or empty.", Logger::Level::ERROR);
+        return;
+    }
+    if (m_isConnected) {
+        Log.msg(FNAME + "Already connected.", Logger::Level::DEBUG);
+        return;
+    }
+    if (m_reconnectTimer.isActive()) {
+        Log.msg(FNAME + "Connection attempts already in progress.", Logger::Level::DEBUG);
+        return;
+    }
+    m_explicitDisconnect = false; // We intend to connect
+
+    Log.msg("WebSocketClient: Starting connection attempts to " + m_url.toString(), Logger::Level::DEBUG);
+
+    // Trigger the first attempt immediately
+    attemptConnection();
+}
+
+bool WebSocketClient::isConnected() const {
+    return m_isConnected;
+}
+
+void WebSocketClient::addSymbol(const QString& symbol, const QString& model, const QVariantMap& settings) {
+    if (!onNetworkThread([this, symbol, model, settings]() { addSymbol(symbol, model, settings); })) return;
+
+    Log.msg(FNAME + QString("WebSocketClient: Requesting add symbol[%1/%2]").arg(symbol, model), Logger::Level::DEBUG);
+
+    QJsonObject dataObject;
+    dataObject["symbol_name"] = symbol;
+    dataObject["model_name"] = model;
+    dataObject["model_settings"] = QJsonObject::fromVariantMap(settings); // Assuming settings are simple key-value
+
+    QJsonObject requestObject;
+    requestObject["type"] = "symbol";
+    requestObject["action"] = "add";
+    requestObject["data"] = dataObject;
+
+    sendJsonMessage(requestObject);
+}
+
+void WebSocketClient::removeSymbol(const QString& symbol, const QString& model) {
+    if (!onNetworkThread([this, symbol, model]() { removeSymbol(symbol, model); })) return;
+
+    Log.msg(FNAME + QString("WebSocketClient: Requesting remove symbol[%1/%2]").arg(symbol, model), Logger::Level::DEBUG);
+
+    QJsonObject dataObject;
+    dataObject["symbol_name"] = symbol;
+    dataObject["model_name"] = model;
+
+    QJsonObject requestObject;
+    requestObject["type"] = "symbol";
+    requestObject["action"] = "remove";
+    requestObject["data"] = dataObject;
+
+    sendJsonMessage(requestObject);
+}
+
+void WebSocketClient::updateSymbolSettings(const QString& symbol, const QString& model, const QVariantMap& settings) {
+    if (!onNetworkThread([this, symbol, model, settings]() { updateSymbolSettings(symbol, model, settings); })) return;
+
+    Log.msg(FNAME + QString("WebSocketClient: Requesting update symbol[%1/%2]").arg(symbol, model), Logger::Level::DEBUG);
+    QJsonObject dataObject;
+    dataObject["symbol_name"] = symbol;
+    dataObject["model_name"] = model;
+    dataObject["model_settings"] = QJsonObject::fromVariantMap(settings);
+
+    QJsonObject requestObject;
+    requestObject["type"] = "symbol";
+    requestObject["action"] = "update";
+    requestObject["data"] = dataObject;
+
+    sendJsonMessage(requestObject);
+}
+
+void WebSocketClient::requestSnapshot(const QString& symbol, const QString& model) {
+    if (!onNetworkThread([this, symbol, model]() { requestSnapshot(symbol, model); })) return;
+
+    Log.msg(FNAME + QString("WebSocketClient: Requesting snapshot symbol[%1/%2]").arg(symbol, model), Logger::Level::INFO);
+
+    QJsonObject dataObject;
+    dataObject["symbol_name"] = symbol;
+    dataObject["model_name"] = model;
+
+    QJsonObject requestObject;
+    requestObject["type"] = "symbol";
+    requestObject["action"] = "snapshot";
+    requestObject["data"] = dataObject;
+
+    sendJsonMessage(requestObject);
+}
+
+void WebSocketClient::pauseSymbol(const QString& symbol, const QString& model) {
+    Log.msg(FNAME + QString("WebSocketClient: Requesting pause symbol[%1/%2]").arg(symbol, model), Logger::Level::DEBUG);
+}
+
+void WebSocketClient::resumeSymbol(const QString& symbol, const QString& model) {
+    Log.msg(FNAME + QString("WebSocketClient: Requesting resume symbol[%1/%2]").arg(symbol, model), Logger::Level::DEBUG);
+}
+
+
+// --- Private Slots (Implement later with actual QWebSocket logic) ---
+
+void WebSocketClient::attemptConnection() {
+    if (m_explicitDisconnect || m_isConnected) {
+        Log.msg(FNAME + "WebSocketClient: Skipping connection attempt (explicit disconnect or already connected).", 
+            Logger::Level::DEBUG);
+        return; // Don't attempt if explicitly disconnected or already connected
+    }
+
+    if (m_webSocket.state() == QAbstractSocket::UnconnectedState) {
+        Log.msg("WebSocketClient: Attempting to connect to " + m_url.toString(), Logger::Level::DEBUG);
+        m_webSocket.open(m_url);
+    }
+    else {
+        Log.msg(FNAME + "WebSocketClient: Socket not in UnconnectedState (" + QString::number(m_webSocket.state()) + 
+            "), skipping connection attempt.", Logger::Level::DEBUG);
+        // Maybe schedule another check later if state is Connecting/Closing?
+        // For now, rely on disconnected/error signals to trigger next attempt.
+    }
+}
+
+
+void WebSocketClient::onConnected() {
+    Log.msg("WebSocketClient: WebSocket connected successfully to " + m_url.toString(), Logger::Level::INFO);
+    m_isConnected = true;
+    m_explicitDisconnect = false; // Connection successful, clear flag
+    m_reconnectTimer.stop(); // Stop timer, we are connected
+    m_streamFormat = SmileWire::FormatJsonCsv; // Until the server acknowledges the hello
+    sendHello();
+    emit connected();
+}
+
+void WebSocketClient::onDisconnected() {
+    // This slot is called both for clean disconnects and after errors that close the socket.
+    bool wasConnected = m_isConnected;
+    m_isConnected = false; // Update state regardless of reason
+
+    if (m_explicitDisconnect) {
+        Log.msg(FNAME + "WebSocketClient: WebSocket disconnected (explicitly requested).", Logger::Level::INFO);
+    }
+    else {
+        Log.msg(FNAME + "WebSocketClient: WebSocket disconnected (unexpectedly or after error).", Logger::Level::DEBUG);
+        // Schedule a reconnect attempt only if it wasn't an explicit disconnect
+        scheduleReconnect();
+    }
+
+    // Emit signal only if we were previously connected
+    if (wasConnected) {
+        emit disconnected();
+    }
+}
+
+void WebSocketClient::onTextMessageReceived(const QString& message) {
+    // qInfo() << "WebSocketClient: Message received:" << message; // Can be very verbose
+    if (m_recorder.isOpen()) {
+        const QByteArray utf8 = message.toUtf8();
+        m_recorder.record(FeedCapture::Kind::Text, utf8.constData(), utf8.size());
+    }
+    parseIncomingMessage(message);
+}
+
+// Binary smile frames (only sent by servers that accepted our hello)
+void WebSocketClient::onBinaryMessageReceived(const QByteArray& message) {
+    if (m_recorder.isOpen()) {
+        m_recorder.record(FeedCapture::Kind::Binary, message.constData(), message.size());
+    }
+    if (!SmileWire::isSmileFrame(message)) {
+        Log.msg(FNAME + QString("WebSocketClient: Received unknown binary message (%1 bytes).").arg(message.size()),
+            Logger::Level::WARNING);
+        return;
+    }
+    emit smileFrameReceived(message);
+}
+
+void WebSocketClient::onError(QAbstractSocket::SocketError error) {
+    // Avoid logging "RemoteHostClosedError" as a critical error if it happens during normal disconnect
+    if (error == QAbstractSocket::RemoteHostClosedError && !m_isConnected) {
+        Log.msg(FNAME + QString("WebSocketClient: Connection closed by remote host (expected during disconnect)."), 
+            Logger::Level::INFO);
+    }
+    else {
+        QString errorString = m_webSocket.errorString();
+        Log.msg(FNAME + QString("WebSocketClient: Error occurred: %1").arg(errorString),
+            Logger::Level::ERROR);
+        emit errorOccurred(errorString);
+    }
+}
+
+
+// --- Private Helpers ---
+
+void WebSocketClient::scheduleReconnect() {
+    if (m_explicitDisconnect) {
+        Log.msg(FNAME + "Reconnect suppressed due to explicit disconnect.", Logger::Level::DEBUG);
+        return; // Don't schedule if explicitly disconnected
+    }
+    if (m_reconnectTimer.isActive()) {
+        return; // Already scheduled
+    }
+
+    Log.msg("Scheduling connection attempt in " + QString::number(RECONNECT_INTERVAL_MS / 1000) + " s.", 
+        Logger::Level::INFO);
+    m_reconnectTimer.start(); // Start the single-shot timer
+}
+
+void WebSocketClient::sendJsonMessage(const QJsonObject& json) {
+    if (!m_isConnected) {
+        Log.msg(FNAME + QString("WebSocketClient: Cannot send message, not connected."),Logger::Level::WARNING);
+        return;
+    }
+    QJsonDocument doc(json);
+    QString messageStr = QString::fromUtf8(doc.toJson(QJsonDocument::Compact));
+    // qInfo() << "WebSocketClient: Sending:" << messageStr; // For debugging
+    m_webSocket.sendTextMessage(messageStr);
+}
+
+// Servers that know the handshake answer with "hello_ack" and switch to the best format we accept.
+// Older servers ignore it and keep sending JSON/CSV, which is always handled.
+void WebSocketClient::sendHello() {
+    QJsonArray accept;
+    if (Config::getAcceptBinaryFrames()) {
+        accept.append(SmileWire::FormatBinary);
+    }
+    accept.append(SmileWire::FormatJsonCsv);
+
+    // Codecs for 'data_compressed', preferred first, and the trained dictionaries we hold per codec
+    QJsonObject dictionaries;
+    for (Compressor::Codec codec : { Compressor::Codec::Zstd, Compressor::Codec::Lz4 }) {
+        const QList<quint32> ids = Compressor::CodecRegistry::instance().dictionaryIds(codec);
+        if (ids.isEmpty()) continue;
+        QJsonArray idArray;
+        for (quint32 id : ids) idArray.append(qint64(id));
+        dictionaries[Compressor::codecName(codec)] = idArray;
+    }
+
+    QJsonObject requestObject;
+    requestObject["type"] = "hello";
+    requestObject["accept"] = accept;
+    requestObject["codecs"] = QJsonArray::fromStringList(Compressor::availableCodecNames());
+    requestObject["dicts"] = dictionaries;
+
+    sendJsonMessage(requestObject);
+}
+
+void WebSocketClient::parseIncomingMessage(const QString& message) {
+    // Envelope scan over the UTF-16 text, no toUtf8() copy and no DOM (see MessageEnvelope.h)
+    const qint64 receivedNs = Trace::isEnabled() ? Trace::now() : 0;
+    MessageEnvelope envelope;
+    QString parseError;
+    if (!MessageEnvelope::parse(message, envelope, &parseError)) {
+        Log.msg(FNAME + QString("WebSocketClient: Received invalid message (%1, %2 chars): %3")
+            .arg(parseError).arg(message.size()).arg(message.left(200)), Logger::Level::WARNING);
+        return;
+    }
+    if (receivedNs) {
+        envelope.trace.receiveNs = receivedNs;
+        if (envelope.trace.serverLoadMs > 0) { // Wall clocks of two hosts, includes their offset
+            Trace::record(Trace::Stage::ServerToReceive,
+                (QDateTime::currentMSecsSinceEpoch() - envelope.trace.serverLoadMs) * 1000000);
+        }
+    }
+
+    const QString& type = envelope.type;
+
+    if (type == "ticker_data") { // Example: receiving ticker data (symbol_name/model_name in 'data')
+        if (!envelope.symbol.isEmpty() && !envelope.model.isEmpty()) {
+            emit tickerDataReceived(envelope);
+        }
+        else {
+            Log.msg(FNAME + "WebSocketClient: Received ticker data with missing symbol/model.", Logger::Level::WARNING);
+        }
+    }
+    else if (type == "data_stream") { // JSON/CSV smile: symbol/model at top level next to 'data_compressed'
+        if (!envelope.symbol.isEmpty() && !envelope.model.isEmpty()) {
+            emit tickerDataReceived(envelope);
+        }
+        else {
+            Log.msg(FNAME + "WebSocketClient: Received data_stream with missing symbol/model.", Logger::Level::WARNING);
+        }
+    }
+    else if (type == "symbol_response") { 
+        const QString& action = envelope.action;
+        const QString& symbol = envelope.symbol;
+        const QString& model = envelope.model;
+        const QString& errorMsg = envelope.error;
+
+        if (action == "add") {
+            if (envelope.success) emit symbolAddConfirmed(symbol, model);
+            else emit symbolAddFailed(symbol, model, errorMsg.isEmpty() ? "Unknown add error" : errorMsg);
+        }
+        else if (action == "remove") {
+            if (envelope.success) emit symbolRemoveConfirmed(symbol, model);
+            // else emit symbolRemoveFailed(symbol, model, errorMsg); // Add if needed
+        }
+        else if (action == "update") {
+            if (envelope.success) emit symbolUpdateConfirmed(symbol, model);
+            // else emit symbolUpdateFailed(symbol, model, errorMsg); // Add if needed
+        }
+    }
+    else if (type == "hello_ack") {
+        m_streamFormat = envelope.format.isEmpty() ? SmileWire::FormatJsonCsv : envelope.format;
+        Log.msg(FNAME + QString("WebSocketClient: Server selected smile format: %1").arg(m_streamFormat),
+            Logger::Level::INFO);
+    }
+    else {
+        Log.msg(FNAME + QString("WebSocketClient: Received unhandled message type: %1").arg(type),
+            Logger::Level::WARNING);
+    }
 }
\ No newline at end of file
@@ -1,76 +1,121 @@
-#pragma once
-
-#include <QObject>
-#include <QString>
-#include <QVariantMap>
-#include <QJsonObject>
-#include <QJsonDocument>
-#include <QWebSocket>
-#include <QUrl>
-#include <QTimer>
-
-class WebSocketClient : public QObject {
-    Q_OBJECT
-
-public:
-    explicit WebSocketClient(QObject* parent = nullptr);
-    ~WebSocketClient() override;
-
-    // Methods to initiate actions (will send JSON requests)
-    void addSymbol(const QString& symbol, const QString& model, const QVariantMap& settings = {});
-    void removeSymbol(const QString& symbol, const QString& model);
-    void updateSymbolSettings(const QString& symbol, const QString& model, const QVariantMap& settings);
-    void pauseSymbol(const QString& symbol, const QString& model); // May need specific API call or just stop processing locally
-    void resumeSymbol(const QString& symbol, const QString& model);// May need specific API call or just start processing locally
-
-    // --- Connection Control ---
-    // Sets the target URL and starts connection attempts immediately
-    void connectToServer(const QUrl& url);
-    // Stops connection attempts and closes the socket if connected
-    void disconnectFromServer();
-    // Call this if you want to manually trigger connection attempts after setting URL separately
-    void startConnectionAttempts();
-
-    bool isConnected() const; // Public method to check status
-
-signals:
-    // Signals data *received* from the WebSocket server
-    void tickerDataReceived(const QString& symbol, const QString& model, const QJsonObject& data);
-    void symbolAddConfirmed(const QString& symbol, const QString& model); // Example confirmation
-    void symbolRemoveConfirmed(const QString& symbol, const QString& model); // Example confirmation
-    void symbolUpdateConfirmed(const QString& symbol, const QString& model); // Example confirmation
-    void symbolAddFailed(const QString& symbol, const QString& model, const QString& error); // Example error
-    // Add more signals for other confirmations/errors as needed
-
-    // Connection status signals
-    void connected();
-    void disconnected();
-    void errorOccurred(const QString& errorString); // General WebSocket errors
-
-
-private slots:
-    // Slots for internal QWebSocket signals (to be implemented later)
-    void onConnected();
-    void onDisconnected();
-    void onTextMessageReceived(const QString& message);
-    void onError(QAbstractSocket::SocketError error);
-
-    void attemptConnection();
-
-private:
-    QWebSocket m_webSocket;
-    QUrl m_url;
-    bool m_isConnected = false;
-    bool m_explicitDisconnect = false; // Flag to prevent reconnect after explicit disconnect call
-    QTimer m_reconnectTimer; // Timer for connection retries
-
-    // Helper to send JSON messages
-    void sendJsonMessage(const QJsonObject& json);
-    // Helper to parse incoming messages
-    void parseIncomingMessage(const QString& message);
-    // Helper to schedule next connection attempt
-    void scheduleReconnect();
-
-    // Define reconnect interval
-    static const int RECONNECT_INTERVAL_MS = 3000; // 3 seconds
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVariantMap>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QWebSocket>
+#include <QUrl>
+#include <QTimer>
+
+#include "MessageEnvelope.h"
+#include "FeedCapture.h"
+#include "FeedReplayer.h"
+
+#include <atomic>
+
+class QThread;
+
+// Runs on its own "Network" thread (startNetworkThread) so socket reads never wait for the GUI:
+// a long repaint or a modal dialog no longer lets the TCP receive window fill up.
+// Public methods may be called from any thread, they post themselves to the network thread.
+// Signals are emitted on the network thread (queued to receivers living on other threads).
+class WebSocketClient : public QObject {
+    Q_OBJECT
+
+public:
+    // No parent: the client is moved to its network thread
+    WebSocketClient();
+    ~WebSocketClient() override;
+
+    // Moves the client to a dedicated thread. Call once, before connectToServer.
+    void startNetworkThread();
+    // Closes the socket and stops the network thread; the client is back on the caller's thread afterwards.
+    // Call before application exit.
+    void shutdown();
+
+    // Methods to initiate actions (will send JSON requests)
+    void addSymbol(const QString& symbol, const QString& model, const QVariantMap& settings = {});
+    void removeSymbol(const QString& symbol, const QString& model);
+    void updateSymbolSettings(const QString& symbol, const QString& model, const QVariantMap& settings);
+    void pauseSymbol(const QString& symbol, const QString& model); // May need specific API call or just stop processing locally
+    void resumeSymbol(const QString& symbol, const QString& model);// May need specific API call or just start processing locally
+    // Asks the server for a full snapshot of symbol/model (after a delta sequence gap)
+    void requestSnapshot(const QString& symbol, const QString& model);
+
+    // --- Connection Control ---
+    // Sets the target URL and starts connection attempts immediately
+    void connectToServer(const QUrl& url);
+    // Stops connection attempts and closes the socket if connected
+    void disconnectFromServer();
+    // Call this if you want to manually trigger connection attempts after setting URL separately
+    void startConnectionAttempts();
+
+    bool isConnected() const; // Public method to check status
+
+    // --- Record / replay (see FeedCapture.h) ---
+    // Appends every received text/binary message with its receive time to 'fileName'
+    void startRecording(const QString& fileName);
+    void stopRecording();
+    // Feeds a capture through the same path as socket messages. speed: 1 = recorded pace, N = N times faster, 0 = max.
+    // At max speed 'backlog' (ingest messages still queued) pauses the replay above 'maxBacklog' (see FeedReplayer.h).
+    // Use instead of connectToServer.
+    void startReplay(const QString& fileName, double speed,
+        FeedReplayer::BacklogProbe backlog = FeedReplayer::BacklogProbe(), int maxBacklog = 0);
+
+signals:
+    // Signals data *received* from the WebSocket server ('data_compressed' already base64-decoded into envelope.payload)
+    void tickerDataReceived(const MessageEnvelope& envelope);
+    // Raw binary smile frame (see SmileWireFormat.h), decoded by the receiver on its ingest workers
+    void smileFrameReceived(const QByteArray& frame);
+    void symbolAddConfirmed(const QString& symbol, const QString& model); // Example confirmation
+    void symbolRemoveConfirmed(const QString& symbol, const QString& model); // Example confirmation
+    void symbolUpdateConfirmed(const QString& symbol, const QString& model); // Example confirmation
+    void symbolAddFailed(const QString& symbol, const QString& model, const QString& error); // Example error
+    // Add more signals for other confirmations/errors as needed
+
+    // Connection status signals
+    void connected();
+    void disconnected();
+    void errorOccurred(const QString& errorString); // General WebSocket errors
+    // The capture passed to startReplay was played to its end (or could not be opened: 0 messages)
+    void replayFinished(quint64 messages, qint64 elapsedMs);
+
+
+private slots:
+    // Slots for internal QWebSocket signals (to be implemented later)
+    void onConnected();
+    void onDisconnected();
+    void onTextMessageReceived(const QString& message);
+    void onBinaryMessageReceived(const QByteArray& message);
+    void onError(QAbstractSocket::SocketError error);
+
+    void attemptConnection();
+
+private:
+    QWebSocket m_webSocket; // Child of this (follows it to the network thread)
+    QUrl m_url;
+    std::atomic<bool> m_isConnected{ false }; // Read from any thread by isConnected()
+    bool m_explicitDisconnect = false; // Flag to prevent reconnect after explicit disconnect call
+    QTimer m_reconnectTimer; // Timer for connection retries (child of this)
+    QThread* m_networkThread = nullptr;
+    QString m_streamFormat; // Smile format agreed with the server ("json-csv" until the server acks the hello)
+    FeedCapture::Recorder m_recorder; // Open while recording
+    FeedReplayer m_replayer; // Child of this
+
+    // Helper to send JSON messages
+    void sendJsonMessage(const QJsonObject& json);
+    // Announces the smile formats this client accepts (content negotiation)
+    void sendHello();
+    // Helper to parse incoming messages
+    void parseIncomingMessage(const QString& message);
+    // Helper to schedule next connection attempt
+    void scheduleReconnect();
+    // True on the network thread. Otherwise queues 'call' to it and returns false.
+    template <typename Call>
+    bool onNetworkThread(Call&& call);
+
+    // Define reconnect interval
+    static const int RECONNECT_INTERVAL_MS = 3000; // 3 seconds
 };
\ No newline at end of file
@@ -1,13 +1,68 @@
 #pragma once
 
 #include <QVector>
+#include <QList>
 #include <QPointF>
 #include "SmilePointData.h"
+#include "Data/OptionSymbolTable.h"
 
+// Columnar (struct-of-arrays) smile of one snapshot date.
+// Row i of every column describes the same option. All plotted series share the
+// logMoneyness column as x, so x is stored once. Columns are contiguous doubles,
+// ready for vectorised analytics; QVector implicit sharing keeps copies shallow.
 struct PlotDataForDate {
-    QVector<QPointF> theoPoints;
-    QVector<QPointF> midPoints;
-    QVector<QPointF> bidPoints;
-    QVector<QPointF> askPoints;
-    QVector<SmilePointData> pointDetails; // Matching details for points
+    QVector<double> logMoneyness;
+    QVector<double> strike;
+    QVector<double> theoIv;
+    QVector<double> midIv;
+    QVector<double> bidIv;
+    QVector<double> askIv;
+    QVector<double> bidPrice;
+    QVector<double> askPrice;
+    QVector<quint32> symbolId; // Interned option symbol, see OptionSymbolTable
+
+    qsizetype size() const { return logMoneyness.size(); }
+    bool isEmpty() const { return logMoneyness.isEmpty(); }
+
+    void clear() {
+        logMoneyness.clear(); strike.clear();
+        theoIv.clear(); midIv.clear(); bidIv.clear(); askIv.clear();
+        bidPrice.clear(); askPrice.clear();
+        symbolId.clear();
+    }
+
+    void reserve(qsizetype rows) {
+        logMoneyness.reserve(rows); strike.reserve(rows);
+        theoIv.reserve(rows); midIv.reserve(rows); bidIv.reserve(rows); askIv.reserve(rows);
+        bidPrice.reserve(rows); askPrice.reserve(rows);
+        symbolId.reserve(rows);
+    }
+
+    // Series adapter: (logMoneyness[i], yColumn[i]) points for QXYSeries::replace()
+    QList<QPointF> points(const QVector<double>& yColumn) const {
+        QList<QPointF> result;
+        const qsizetype n = qMin(logMoneyness.size(), yColumn.size());
+        result.reserve(n);
+        const double* x = logMoneyness.constData();
+        const double* y = yColumn.constData();
+        for (qsizetype i = 0; i < n; ++i) {
+            result.append(QPointF(x[i], y[i]));
+        }
+        return result;
+    }
+
+    // Row view for tooltips/clicks: only this one row is materialised
+    SmilePointData pointAt(qsizetype row) const {
+        SmilePointData details;
+        if (row < 0 || row >= size()) return details;
+        details.symbol = OptionSymbolTable::instance().symbol(symbolId.value(row, OptionSymbolTable::InvalidId));
+        details.strike = strike.value(row);
+        details.mid_iv = midIv.value(row);
+        details.theo_iv = theoIv.value(row);
+        details.bid_iv = bidIv.value(row);
+        details.ask_iv = askIv.value(row);
+        details.bid_price = bidPrice.value(row);
+        details.ask_price = askPrice.value(row);
+        return details;
+    }
 };
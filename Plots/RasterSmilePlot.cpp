@@ -0,0 +1,455 @@
+#include "RasterSmilePlot.h"
+#include "SmileDecimator.h"
+#include "Glob/Logger.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QRubberBand>
+#include <QtMath>
+#include <QToolTip>
+#include <QWheelEvent>
+
+#include <cmath>
+#include <limits>
+
+namespace {
+    // Same look as SmilePlot's Qt Charts setup
+    const QColor THEO_COLOR = Qt::darkGreen;
+    const QColor ASK_COLOR = Qt::blue;
+    const QColor BID_COLOR = Qt::red;
+    const QColor GRID_COLOR(220, 220, 220);
+    constexpr int X_TICKS = 11;
+    constexpr int Y_TICKS = 6;
+    constexpr int MARGIN_LEFT = 72;
+    constexpr int MARGIN_RIGHT = 24;
+    constexpr int MARGIN_TOP = 36;
+    constexpr int MARGIN_BOTTOM = 72; // Labels, axis title and legend
+
+    // One marker, drawn once per render and blitted at every point
+    QImage markerSprite(const QColor& color, bool circle, double size, qreal dpr) {
+        const int pixels = qCeil(size * dpr);
+        QImage sprite(pixels, pixels, QImage::Format_ARGB32_Premultiplied);
+        sprite.fill(Qt::transparent);
+        sprite.setDevicePixelRatio(dpr);
+        QPainter painter(&sprite);
+        painter.setRenderHint(QPainter::Antialiasing, circle);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(color);
+        const QRectF rect(0, 0, size, size);
+        if (circle) painter.drawEllipse(rect);
+        else painter.drawRect(rect);
+        return sprite;
+    }
+}
+
+RasterSmilePlot::RasterSmilePlot(QWidget* parent)
+    : QWidget(parent)
+{
+    setMouseTracking(true); // Hover without a pressed button
+    setAttribute(Qt::WA_OpaquePaintEvent); // The cached image covers the whole widget
+    setMinimumSize(200, 150);
+    setCurrentMode(pmPan);
+}
+
+void RasterSmilePlot::setCurrentMode(PlotMode mode) {
+    m_mode = mode;
+    setCursor(mode == pmPan ? Qt::ArrowCursor : Qt::CrossCursor);
+}
+
+void RasterSmilePlot::setTrace(const Trace::Timeline& trace) {
+    m_pendingTrace = trace;
+}
+
+void RasterSmilePlot::updateData(const PlotDataForDate& data) {
+    Trace::Scope scope(Trace::Stage::PlotUpdate);
+    Log.msg(FNAME + QString("Updating raster plot data. Points received: %1").arg(data.size()), Logger::Level::DEBUG);
+
+    m_data = data; // Implicitly shared columns, no deep copy
+    m_hitIndex.rebuild(m_data.logMoneyness);
+    fitToData();
+    if (m_hoveredRow >= m_data.size()) clearHover();
+    invalidate();
+}
+
+void RasterSmilePlot::updateRows(const PlotDataForDate& data, const QVector<qsizetype>& changedRows) {
+    if (data.size() != m_data.size() || changedRows.isEmpty()) {
+        updateData(data);
+        return;
+    }
+    Trace::Scope scope(Trace::Stage::PlotUpdate);
+    m_data = data;
+    m_hitIndex.update(m_data.logMoneyness, changedRows);
+    fitToData();
+    invalidate();
+}
+
+void RasterSmilePlot::clearPlot() {
+    m_data.clear();
+    m_hitIndex.clear();
+    m_fitRange = Range();
+    m_view = Range();
+    m_followData = true;
+    clearHover();
+    invalidate();
+}
+
+void RasterSmilePlot::resetZoom() {
+    m_followData = true;
+    m_view = m_fitRange;
+    invalidate();
+}
+
+// Same fit as SmilePlot::adjustAxes: y from 0, 5% x padding, 10% y padding
+void RasterSmilePlot::fitToData() {
+    double minX = std::numeric_limits<double>::max(), maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+    const qsizetype rows = m_data.size();
+    for (qsizetype i = 0; i < rows; ++i) {
+        const double x = m_data.logMoneyness[i];
+        if (!std::isfinite(x)) continue;
+        minX = qMin(minX, x); maxX = qMax(maxX, x);
+        for (double y : { m_data.theoIv[i], m_data.askIv[i], m_data.bidIv[i] }) {
+            if (std::isfinite(y)) maxY = qMax(maxY, y);
+        }
+    }
+
+    Range fit;
+    if (minX <= maxX && maxY > std::numeric_limits<double>::lowest()) {
+        const double xRange = maxX - minX;
+        const double yRange = maxY;
+        const double xPadding = (xRange < 1e-9) ? 1.0 : xRange * 0.05;
+        const double yPadding = (yRange < 1e-9) ? 0.1 : yRange * 0.1;
+        fit.minX = minX - xPadding; fit.maxX = maxX + xPadding;
+        fit.minY = 0.0; fit.maxY = qMax(maxY, 0.0) + yPadding;
+    }
+    m_fitRange = fit;
+    if (m_followData || !m_view.isValid()) {
+        m_view = m_fitRange;
+    }
+}
+
+void RasterSmilePlot::invalidate() {
+    m_cacheValid = false;
+    update();
+}
+
+QRect RasterSmilePlot::plotRect() const {
+    return rect().adjusted(MARGIN_LEFT, MARGIN_TOP, -MARGIN_RIGHT, -MARGIN_BOTTOM);
+}
+
+QPointF RasterSmilePlot::toPixel(double x, double y, const QRect& plot) const {
+    return QPointF(plot.left() + (x - m_view.minX) * plot.width() / (m_view.maxX - m_view.minX),
+        plot.bottom() - (y - m_view.minY) * plot.height() / (m_view.maxY - m_view.minY));
+}
+
+QPointF RasterSmilePlot::toValue(const QPointF& pixel, const QRect& plot) const {
+    return QPointF(m_view.minX + (pixel.x() - plot.left()) * (m_view.maxX - m_view.minX) / plot.width(),
+        m_view.minY + (plot.bottom() - pixel.y()) * (m_view.maxY - m_view.minY) / plot.height());
+}
+
+void RasterSmilePlot::renderCache() {
+    const qreal dpr = devicePixelRatioF();
+    const QSize pixels = size() * dpr;
+    if (m_cache.size() != pixels) {
+        m_cache = QImage(pixels, QImage::Format_ARGB32_Premultiplied);
+    }
+    m_cache.setDevicePixelRatio(dpr);
+    m_cache.fill(Qt::white);
+    m_cacheValid = true;
+
+    const QRect plot = plotRect();
+    if (plot.width() < 2 || plot.height() < 2 || !m_view.isValid()) return;
+
+    QPainter painter(&m_cache);
+    QFont titleFont = font();
+    titleFont.setBold(true);
+    painter.setFont(titleFont);
+    painter.drawText(QRect(0, 0, width(), MARGIN_TOP), Qt::AlignCenter, "Implied Volatility Smile");
+    painter.setFont(font());
+
+    paintAxes(painter, plot);
+    painter.save();
+    painter.setClipRect(plot);
+    paintSeries(painter, plot);
+    painter.restore();
+    paintLegend(painter);
+}
+
+void RasterSmilePlot::paintAxes(QPainter& painter, const QRect& plot) const {
+    const QFontMetrics metrics = painter.fontMetrics();
+    painter.setPen(QPen(GRID_COLOR, 1, Qt::DotLine));
+    for (int i = 0; i < X_TICKS; ++i) {
+        const double x = plot.left() + plot.width() * double(i) / (X_TICKS - 1);
+        painter.drawLine(QPointF(x, plot.top()), QPointF(x, plot.bottom()));
+    }
+    for (int i = 0; i < Y_TICKS; ++i) {
+        const double y = plot.bottom() - plot.height() * double(i) / (Y_TICKS - 1);
+        painter.drawLine(QPointF(plot.left(), y), QPointF(plot.right(), y));
+    }
+
+    painter.setPen(Qt::black);
+    painter.drawRect(plot);
+    for (int i = 0; i < X_TICKS; ++i) {
+        const double value = m_view.minX + (m_view.maxX - m_view.minX) * i / (X_TICKS - 1);
+        const double x = plot.left() + plot.width() * double(i) / (X_TICKS - 1);
+        const QString label = QString::number(value, 'f', 2);
+        painter.drawText(QPointF(x - metrics.horizontalAdvance(label) / 2.0, plot.bottom() + 4 + metrics.ascent()), label);
+    }
+    for (int i = 0; i < Y_TICKS; ++i) {
+        const double value = m_view.minY + (m_view.maxY - m_view.minY) * i / (Y_TICKS - 1);
+        const double y = plot.bottom() - plot.height() * double(i) / (Y_TICKS - 1);
+        const QString label = QString::number(value, 'f', 4);
+        painter.drawText(QPointF(plot.left() - 6 - metrics.horizontalAdvance(label), y + metrics.ascent() / 2.0 - 1), label);
+    }
+
+    // Axis titles, as in SmilePlot
+    painter.drawText(QRect(plot.left(), plot.bottom() + 4 + metrics.height(), plot.width(), metrics.height()),
+        Qt::AlignCenter, "Strike");
+    painter.save();
+    painter.translate(metrics.height(), plot.center().y());
+    painter.rotate(-90);
+    painter.drawText(QRect(-plot.height() / 2, -metrics.height(), plot.height(), metrics.height()),
+        Qt::AlignCenter, "Implied Volatility (IV)");
+    painter.restore();
+}
+
+// Decimated to the plot's pixel columns: the cost follows the widget width, not the chain width
+void RasterSmilePlot::paintSeries(QPainter& painter, const QRect& plot) const {
+    if (m_data.isEmpty()) return;
+    const int buckets = qMax(1, plot.width());
+
+    auto toPixels = [this, &plot](const QList<QPointF>& values) {
+        QVector<QPointF> pixels;
+        pixels.reserve(values.size());
+        for (const QPointF& value : values) {
+            pixels.append(toPixel(value.x(), value.y(), plot));
+        }
+        return pixels;
+    };
+
+    const QVector<QPointF> theo = toPixels(SmileDecimator::minMaxPerBucket(m_hitIndex, m_data.theoIv,
+        m_view.minX, m_view.maxX, buckets));
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setPen(QPen(THEO_COLOR, 2));
+    painter.drawPolyline(theo.constData(), int(theo.size()));
+    painter.setRenderHint(QPainter::Antialiasing, false);
+
+    const qreal dpr = m_cache.devicePixelRatio();
+    const QPointF offset(MARKER_SIZE / 2.0, MARKER_SIZE / 2.0);
+    struct MarkerSeries {
+        const QVector<double>* column;
+        QImage sprite;
+    };
+    const MarkerSeries markers[] = {
+        { &m_data.askIv, markerSprite(ASK_COLOR, false, MARKER_SIZE, dpr) },
+        { &m_data.bidIv, markerSprite(BID_COLOR, true, MARKER_SIZE, dpr) },
+    };
+    for (const MarkerSeries& series : markers) {
+        const QVector<QPointF> points = toPixels(SmileDecimator::minMaxPerBucket(m_hitIndex, *series.column,
+            m_view.minX, m_view.maxX, buckets));
+        for (const QPointF& point : points) {
+            painter.drawImage(point - offset, series.sprite);
+        }
+    }
+}
+
+void RasterSmilePlot::paintLegend(QPainter& painter) const {
+    const QFontMetrics metrics = painter.fontMetrics();
+    const struct { const char* name; QColor color; int shape; } entries[] = {
+        { "Theo IVs", THEO_COLOR, 0 }, { "Ask IV", ASK_COLOR, 1 }, { "Bid IV", BID_COLOR, 2 },
+    };
+    constexpr int swatch = 12;
+    constexpr int spacing = 16;
+    int total = 0;
+    for (const auto& entry : entries) {
+        total += swatch + 4 + metrics.horizontalAdvance(entry.name) + spacing;
+    }
+    int x = (width() - total + spacing) / 2;
+    const int y = height() - metrics.height() - 6;
+
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    for (const auto& entry : entries) {
+        const QRectF box(x, y + (metrics.height() - swatch) / 2.0, swatch, swatch);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(entry.color);
+        if (entry.shape == 0) painter.fillRect(QRectF(box.left(), box.center().y() - 1, swatch, 2), entry.color);
+        else if (entry.shape == 1) painter.drawRect(box);
+        else painter.drawEllipse(box);
+        painter.setPen(Qt::black);
+        painter.drawText(QPointF(x + swatch + 4, y + metrics.ascent()), entry.name);
+        x += swatch + 4 + metrics.horizontalAdvance(entry.name) + spacing;
+    }
+    painter.setBrush(Qt::NoBrush);
+}
+
+void RasterSmilePlot::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    {
+        Trace::Scope scope(Trace::Stage::Paint);
+        if (!m_cacheValid || m_cache.size() != size() * devicePixelRatioF()) {
+            renderCache();
+        }
+        QPainter painter(this);
+        painter.drawImage(QPointF(0, 0), m_cache);
+
+        // Hover highlight over the cache, so moving the mouse never re-renders the series
+        if (m_hoveredRow >= 0) {
+            painter.setRenderHint(QPainter::Antialiasing, true);
+            painter.setPen(QPen(Qt::black, 1.5));
+            painter.setBrush(Qt::NoBrush);
+            painter.drawEllipse(hoveredPixel(), MARKER_SIZE, MARKER_SIZE);
+        }
+    }
+    if (m_pendingTrace.isValid()) {
+        // First paint after the update: the message reached the screen
+        Trace::recordSince(Trace::Stage::EndToEnd, m_pendingTrace.receiveNs);
+        m_pendingTrace = Trace::Timeline();
+    }
+}
+
+void RasterSmilePlot::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    invalidate();
+}
+
+// --- Mouse ---
+
+void RasterSmilePlot::mousePressEvent(QMouseEvent* event) {
+    if (event->button() != Qt::LeftButton) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    m_pressPos = event->pos();
+    if (m_mode == pmPan) {
+        m_isPanning = true;
+        m_panLastPos = event->pos();
+    }
+    else {
+        if (!m_rubberBand) m_rubberBand = new QRubberBand(QRubberBand::Rectangle, this);
+        m_rubberBand->setGeometry(QRect(m_pressPos, QSize()));
+        m_rubberBand->show();
+    }
+    event->accept();
+}
+
+void RasterSmilePlot::mouseMoveEvent(QMouseEvent* event) {
+    if (m_isPanning) {
+        const QRect plot = plotRect();
+        const QPoint delta = event->pos() - m_panLastPos;
+        m_panLastPos = event->pos();
+        if (plot.width() > 0 && plot.height() > 0 && !delta.isNull()) {
+            const double dx = delta.x() * (m_view.maxX - m_view.minX) / plot.width();
+            const double dy = delta.y() * (m_view.maxY - m_view.minY) / plot.height();
+            m_view.minX -= dx; m_view.maxX -= dx;
+            m_view.minY += dy; m_view.maxY += dy;
+            m_followData = false;
+            clearHover();
+            invalidate();
+        }
+        event->accept();
+    }
+    else if (m_rubberBand && m_rubberBand->isVisible()) {
+        m_rubberBand->setGeometry(QRect(m_pressPos, event->pos()).normalized());
+        event->accept();
+    }
+    else {
+        updateHover(event->pos());
+    }
+}
+
+void RasterSmilePlot::mouseReleaseEvent(QMouseEvent* event) {
+    if (event->button() != Qt::LeftButton) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+    const bool isClick = (event->pos() - m_pressPos).manhattanLength() < CLICK_SLOP_PX;
+    m_isPanning = false;
+
+    if (m_rubberBand && m_rubberBand->isVisible()) {
+        const QRect plot = plotRect();
+        const QRect band = m_rubberBand->geometry().intersected(plot);
+        m_rubberBand->hide();
+        if (!isClick && band.width() > CLICK_SLOP_PX && band.height() > CLICK_SLOP_PX) {
+            const QPointF topLeft = toValue(band.topLeft(), plot);
+            const QPointF bottomRight = toValue(band.bottomRight(), plot);
+            m_view.minX = topLeft.x(); m_view.maxX = bottomRight.x();
+            m_view.minY = bottomRight.y(); m_view.maxY = topLeft.y();
+            m_followData = false;
+            clearHover();
+            invalidate();
+        }
+    }
+
+    if (isClick) {
+        updateHover(event->pos());
+        if (m_hoveredRow >= 0 && m_hoveredRow < m_data.size()) {
+            Log.msg(FNAME + "Click on row: " + QString::number(m_hoveredRow), Logger::Level::DEBUG);
+            emit pointClicked(m_data.pointAt(m_hoveredRow));
+        }
+    }
+    event->accept();
+}
+
+void RasterSmilePlot::wheelEvent(QWheelEvent* event) {
+    const qreal delta = event->angleDelta().y();
+    if (qFuzzyIsNull(delta) || !m_view.isValid()) {
+        event->accept();
+        return;
+    }
+    // Centred, same factor as SmilePlot (QChart::zoom)
+    const double factor = delta > 0 ? 1.0 / 1.15 : 1.15;
+    const double centerX = (m_view.minX + m_view.maxX) / 2.0;
+    const double centerY = (m_view.minY + m_view.maxY) / 2.0;
+    const double halfX = (m_view.maxX - m_view.minX) / 2.0 * factor;
+    const double halfY = (m_view.maxY - m_view.minY) / 2.0 * factor;
+    m_view.minX = centerX - halfX; m_view.maxX = centerX + halfX;
+    m_view.minY = centerY - halfY; m_view.maxY = centerY + halfY;
+    m_followData = false;
+    clearHover();
+    invalidate();
+    event->accept();
+}
+
+void RasterSmilePlot::leaveEvent(QEvent* event) {
+    Q_UNUSED(event);
+    clearHover();
+}
+
+// --- Hover ---
+
+void RasterSmilePlot::updateHover(const QPoint& pos) {
+    const QRect plot = plotRect();
+    const int margin = qCeil(HIT_RADIUS_PX);
+    SmileHitIndex::Hit hit;
+    if (!m_data.isEmpty() && m_view.isValid() && plot.width() > 0 && plot.height() > 0
+        && plot.adjusted(-margin, -margin, margin, margin).contains(pos)) {
+        const QVector<const QVector<double>*> columns = { &m_data.theoIv, &m_data.askIv, &m_data.bidIv };
+        hit = m_hitIndex.nearest(toValue(pos, plot), columns,
+            plot.width() / (m_view.maxX - m_view.minX), plot.height() / (m_view.maxY - m_view.minY), HIT_RADIUS_PX);
+    }
+    if (!hit.isValid()) {
+        clearHover();
+        return;
+    }
+    if (hit.row == m_hoveredRow && hit.column == m_hoveredColumn) return; // Tooltip already shown
+
+    m_hoveredRow = hit.row;
+    m_hoveredColumn = hit.column;
+    QToolTip::showText(mapToGlobal(pos), m_data.pointAt(m_hoveredRow).formatForTooltip(), this, rect());
+    update(); // Highlight only, the cache stays valid
+}
+
+void RasterSmilePlot::clearHover() {
+    if (m_hoveredRow < 0) return;
+    m_hoveredRow = -1;
+    m_hoveredColumn = -1;
+    QToolTip::hideText();
+    update();
+}
+
+QPointF RasterSmilePlot::hoveredPixel() const {
+    const QVector<double>* columns[] = { &m_data.theoIv, &m_data.askIv, &m_data.bidIv };
+    if (m_hoveredRow < 0 || m_hoveredRow >= m_data.size() || m_hoveredColumn < 0 || m_hoveredColumn > 2) return QPointF();
+    return toPixel(m_data.logMoneyness[m_hoveredRow], (*columns[m_hoveredColumn])[m_hoveredRow], plotRect());
+}
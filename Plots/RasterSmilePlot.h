@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QImage>
+#include <QPointer>
+#include <QWidget>
+
+#include "SmileHitIndex.h"
+#include "SmilePlotView.h"
+#include "SmilePointData.h"
+
+class QRubberBand;
+
+// QPainter renderer of SmilePlotView, for wide chains and many open windows.
+//
+// Qt Charts keeps a graphics item per marker and walks its scene graph on every repaint. Here the
+// axes, the theo line and the bid/ask markers are painted into a cached QImage, rebuilt only when
+// the data, the visible range or the size changed; hover only paints its highlight over the cache.
+// Series are reduced to the plot's pixel columns (SmileDecimator) and hover/click resolve through
+// SmileHitIndex on the full-resolution rows, like SmilePlot.
+//
+// The view follows the data until the user pans or zooms; resetZoom() goes back to following it.
+class RasterSmilePlot : public QWidget, public SmilePlotView
+{
+    Q_OBJECT
+
+public:
+    explicit RasterSmilePlot(QWidget* parent = nullptr);
+    ~RasterSmilePlot() override = default;
+
+    QWidget* widget() override { return this; }
+    PlotMode currentMode() const override { return m_mode; }
+    void setCurrentMode(PlotMode mode) override;
+    void setTrace(const Trace::Timeline& trace) override;
+
+signals:
+    void pointClicked(const SmilePointData& pointData);
+
+public slots:
+    void updateData(const PlotDataForDate& data) override;
+    void updateRows(const PlotDataForDate& data, const QVector<qsizetype>& changedRows) override;
+    void clearPlot() override;
+    void resetZoom() override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void leaveEvent(QEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+
+private:
+    struct Range {
+        double minX = 0.0, maxX = 100.0;
+        double minY = 0.0, maxY = 1.0;
+        bool isValid() const { return maxX > minX && maxY > minY; }
+    };
+
+    PlotDataForDate m_data; // Shallow copy of the snapshot columns
+    SmileHitIndex m_hitIndex;
+    Range m_fitRange;   // Axes fitted to m_data (same padding as SmilePlot::adjustAxes)
+    Range m_view;       // Visible range
+    bool m_followData = true; // false after pan/zoom, until resetZoom()
+
+    QImage m_cache;
+    bool m_cacheValid = false;
+    Trace::Timeline m_pendingTrace; // Not painted yet
+
+    PlotMode m_mode = pmPan;
+    bool m_isPanning = false;
+    QPoint m_pressPos;
+    QPoint m_panLastPos;
+    QPointer<QRubberBand> m_rubberBand;
+
+    qsizetype m_hoveredRow = -1;
+    int m_hoveredColumn = -1; // 0 theo, 1 ask, 2 bid
+
+    static constexpr double HIT_RADIUS_PX = 8.0;
+    static constexpr int CLICK_SLOP_PX = 3; // Press/release closer than this is a click, not a drag
+    static constexpr double MARKER_SIZE = 7.0;
+
+    QRect plotRect() const;
+    QPointF toPixel(double x, double y, const QRect& plot) const;
+    QPointF toValue(const QPointF& pixel, const QRect& plot) const;
+
+    void fitToData();
+    void invalidate();
+    void renderCache();
+    void paintAxes(QPainter& painter, const QRect& plot) const;
+    void paintSeries(QPainter& painter, const QRect& plot) const;
+    void paintLegend(QPainter& painter) const;
+
+    void updateHover(const QPoint& pos);
+    void clearHover();
+    QPointF hoveredPixel() const;
+};
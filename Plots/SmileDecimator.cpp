@@ -0,0 +1,64 @@
+#include "SmileDecimator.h"
+#include "SmileHitIndex.h"
+
+#include <cmath>
+
+namespace SmileDecimator {
+
+QList<QPointF> minMaxPerBucket(const SmileHitIndex& index, const QVector<double>& y,
+    double minX, double maxX, int buckets) {
+    QList<QPointF> points;
+    if (index.size() == 0 || buckets < 1 || !(maxX > minX)) return points;
+
+    const qsizetype first = qMax<qsizetype>(0, index.lowerBound(minX) - 1);
+    const qsizetype last = qMin(index.size(), index.upperBound(maxX) + 1);
+    points.reserve(qMin(last - first, qsizetype(buckets) * 2 + 4));
+
+    struct Extreme {
+        qsizetype pos = 0;
+        double y = 0.0;
+    };
+    Extreme low, high;
+    qint64 bucket = 0;
+    bool open = false;
+
+    auto flush = [&]() {
+        if (!open) return;
+        if (low.pos == high.pos) {
+            points.append(QPointF(index.xAt(low.pos), low.y));
+            return;
+        }
+        const Extreme& left = low.pos < high.pos ? low : high;
+        const Extreme& right = low.pos < high.pos ? high : low;
+        points.append(QPointF(index.xAt(left.pos), left.y));
+        points.append(QPointF(index.xAt(right.pos), right.y));
+    };
+
+    // Buckets -1 and 'buckets' hold the rows beyond the edges
+    const double scale = buckets / (maxX - minX);
+    for (qsizetype pos = first; pos < last; ++pos) {
+        const double x = index.xAt(pos);
+        const qsizetype row = index.rowAt(pos);
+        if (!std::isfinite(x) || row >= y.size()) continue;
+        const double value = y[row];
+        if (!std::isfinite(value)) continue;
+
+        const qint64 b = x < minX ? -1 : x > maxX ? buckets : qMin<qint64>(buckets - 1, qint64((x - minX) * scale));
+        if (!open || b != bucket) {
+            flush();
+            bucket = b;
+            low = high = Extreme{ pos, value };
+            open = true;
+        }
+        else if (value < low.y) {
+            low = Extreme{ pos, value };
+        }
+        else if (value > high.y) {
+            high = Extreme{ pos, value };
+        }
+    }
+    flush();
+    return points;
+}
+
+} // namespace SmileDecimator
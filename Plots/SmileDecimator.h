@@ -0,0 +1,23 @@
+#pragma once
+
+#include <QList>
+#include <QPointF>
+#include <QVector>
+
+class SmileHitIndex;
+
+// Level-of-detail reduction of a smile series for SmilePlot.
+//
+// A QScatterSeries draws every marker as its own graphics item, so a 20k-row chain makes zoom, pan
+// and repaint crawl although at most a few points per pixel column can be told apart. The visible
+// x range is split into one bucket per pixel and each bucket keeps its lowest and highest point,
+// in x order: outliers and the envelope of the line stay exactly where they were.
+// Hover/click keep using the full-resolution rows through SmileHitIndex.
+namespace SmileDecimator {
+
+    // Points (x, y[row]) of the rows with x in [minX, maxX] plus one row beyond each edge (so lines
+    // run off the plot), at most two per bucket. Rows with a non-finite x or y are skipped.
+    QList<QPointF> minMaxPerBucket(const SmileHitIndex& index, const QVector<double>& y,
+        double minX, double maxX, int buckets);
+
+} // namespace SmileDecimator
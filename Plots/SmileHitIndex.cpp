@@ -0,0 +1,104 @@
+#include "SmileHitIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+    double sortKey(double x) {
+        return std::isfinite(x) ? x : std::numeric_limits<double>::infinity();
+    }
+}
+
+void SmileHitIndex::rebuild(const QVector<double>& x) {
+    const qsizetype rows = x.size();
+    m_order.resize(rows);
+    std::iota(m_order.begin(), m_order.end(), qsizetype(0));
+    std::stable_sort(m_order.begin(), m_order.end(), [&x](qsizetype a, qsizetype b) {
+        return sortKey(x[a]) < sortKey(x[b]);
+    });
+
+    m_sortedX.resize(rows);
+    m_positionOf.resize(rows);
+    for (qsizetype pos = 0; pos < rows; ++pos) {
+        m_sortedX[pos] = sortKey(x[m_order[pos]]);
+        m_positionOf[m_order[pos]] = pos;
+    }
+}
+
+void SmileHitIndex::update(const QVector<double>& x, const QVector<qsizetype>& changedRows) {
+    const qsizetype rows = x.size();
+    if (rows != m_order.size() || changedRows.size() > rows / 4) {
+        rebuild(x);
+        return;
+    }
+
+    // Strikes rarely move, so a changed row usually stays where it is; otherwise it shifts a few places
+    for (qsizetype row : changedRows) {
+        if (row < 0 || row >= rows) continue;
+        qsizetype pos = m_positionOf[row];
+        const double key = sortKey(x[row]);
+        m_sortedX[pos] = key;
+        while (pos > 0 && m_sortedX[pos - 1] > key) {
+            swapPositions(pos - 1, pos);
+            --pos;
+        }
+        while (pos + 1 < rows && m_sortedX[pos + 1] < key) {
+            swapPositions(pos, pos + 1);
+            ++pos;
+        }
+    }
+}
+
+void SmileHitIndex::clear() {
+    m_sortedX.clear();
+    m_order.clear();
+    m_positionOf.clear();
+}
+
+qsizetype SmileHitIndex::lowerBound(double x) const {
+    return std::lower_bound(m_sortedX.cbegin(), m_sortedX.cend(), x) - m_sortedX.cbegin();
+}
+
+qsizetype SmileHitIndex::upperBound(double x) const {
+    return std::upper_bound(m_sortedX.cbegin(), m_sortedX.cend(), x) - m_sortedX.cbegin();
+}
+
+void SmileHitIndex::swapPositions(qsizetype a, qsizetype b) {
+    std::swap(m_sortedX[a], m_sortedX[b]);
+    std::swap(m_order[a], m_order[b]);
+    m_positionOf[m_order[a]] = a;
+    m_positionOf[m_order[b]] = b;
+}
+
+SmileHitIndex::Hit SmileHitIndex::nearest(const QPointF& target, const QVector<const QVector<double>*>& yColumns,
+    double pxPerUnitX, double pxPerUnitY, double radiusPx) const {
+    Hit best;
+    if (m_order.isEmpty() || !(pxPerUnitX > 0.0) || !(pxPerUnitY > 0.0) || !std::isfinite(target.x())) return best;
+
+    // Only rows within the radius horizontally can be within it at all
+    const double halfWidth = radiusPx / pxPerUnitX;
+    const auto first = std::lower_bound(m_sortedX.cbegin(), m_sortedX.cend(), target.x() - halfWidth);
+    const auto last = std::upper_bound(first, m_sortedX.cend(), target.x() + halfWidth);
+
+    double bestSquared = radiusPx * radiusPx;
+    for (auto it = first; it != last; ++it) {
+        const qsizetype pos = it - m_sortedX.cbegin();
+        const qsizetype row = m_order[pos];
+        const double dx = (*it - target.x()) * pxPerUnitX;
+        for (int c = 0; c < yColumns.size(); ++c) {
+            const QVector<double>* column = yColumns[c];
+            if (!column || row >= column->size()) continue;
+            const double dy = ((*column)[row] - target.y()) * pxPerUnitY;
+            const double squared = dx * dx + dy * dy;
+            if (squared <= bestSquared) { // NaN y compares false and is skipped
+                bestSquared = squared;
+                best.row = row;
+                best.column = c;
+            }
+        }
+    }
+    if (best.isValid()) best.distancePx = std::sqrt(bestSquared);
+    return best;
+}
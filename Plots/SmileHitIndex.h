@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QPointF>
+#include <QVector>
+
+// Rows of a smile sorted by x (log-moneyness), for hover/click hit-testing in SmilePlot.
+//
+// Every series of a smile shares the x column, so one index serves all of them: a lookup
+// binary-searches the x window of the pixel radius and measures the screen distance of the
+// candidates only, O(log n + candidates) instead of a scan over every point.
+// Non-finite x values sort last and are never hit.
+class SmileHitIndex {
+public:
+    struct Hit {
+        qsizetype row = -1;
+        int column = -1;         // Index into the yColumns passed to nearest()
+        double distancePx = 0.0;
+        bool isValid() const { return row >= 0; }
+    };
+
+    void rebuild(const QVector<double>& x);
+    // Same row layout, only 'changedRows' were written: each of them is moved to its new sorted
+    // position. Falls back to rebuild() when the row count differs or most rows changed.
+    void update(const QVector<double>& x, const QVector<qsizetype>& changedRows);
+    void clear();
+
+    qsizetype size() const { return m_order.size(); }
+
+    // Sorted positions: [lowerBound(a), upperBound(b)) holds the rows with a <= x <= b
+    qsizetype lowerBound(double x) const;
+    qsizetype upperBound(double x) const;
+    qsizetype rowAt(qsizetype pos) const { return m_order[pos]; }
+    double xAt(qsizetype pos) const { return m_sortedX[pos]; }
+
+    // Nearest (x, yColumns[c][row]) point to 'target' within 'radiusPx' pixels, null columns skipped.
+    // pxPerUnitX/Y convert data distances to pixels (plot area size / axis range).
+    Hit nearest(const QPointF& target, const QVector<const QVector<double>*>& yColumns,
+        double pxPerUnitX, double pxPerUnitY, double radiusPx) const;
+
+private:
+    QVector<double> m_sortedX;       // Keys in ascending order
+    QVector<qsizetype> m_order;      // Row at each sorted position
+    QVector<qsizetype> m_positionOf; // Sorted position of each row
+
+    void swapPositions(qsizetype a, qsizetype b);
+};
@@ -1,398 +1,568 @@
-#include "SmilePlot.h"
-#include "Glob/Logger.h"
-
-#include <QVBoxLayout>
-#include <QToolButton>
-#include <QButtonGroup>
-#include <QIcon>
-#include <QRubberBand>
-#include <QMouseEvent>
-#include <QToolTip>
-#include <QChartView>
-#include <QtCharts/QChart>
-#include <QtCharts/QLineSeries>
-#include <QtCharts/QScatterSeries>
-#include <QtCharts/QValueAxis>
-#include <QApplication>
-#include <QToolTip>
-#include <QDebug>
-#include <limits>
-#include <cmath> // For std::isnan, std::isinf
-
-
-//----------------------------------------------------------------------------
-// Constructor and Setup (No changes needed here)
-//----------------------------------------------------------------------------
-SmilePlot::SmilePlot(QWidget* parent)
-    : QChartView(new QChart(), parent)
-{
-    m_CurrentMode = SmilePlot::PlotMode::pmPan;
-    m_chart = chart();
-    setupChart();
-
-    // Enable mouse tracking to receive mouseMoveEvents even when no button is pressed (for hover)
-    this->setMouseTracking(true);
-    m_chart->setAcceptHoverEvents(true); // Ensure chart processes hover
-}
-
-void SmilePlot::setupChart()
-{
-    m_chart->setTitle("Implied Volatility Smile");
-    m_chart->legend()->setVisible(true); 
-    m_chart->legend()->setAlignment(Qt::AlignBottom);
-    m_theoSeries = new QLineSeries(m_chart); 
-    m_askSeries = new QScatterSeries(m_chart); 
-    m_bidSeries = new QScatterSeries(m_chart);
-    m_theoSeries->setName("Theo IVs"); 
-    m_theoSeries->setColor(Qt::darkGreen); 
-    m_theoSeries->setPen(QPen(Qt::darkGreen, 2));
-    m_askSeries->setName("Ask IV"); 
-    m_askSeries->setColor(Qt::blue); 
-    m_askSeries->setMarkerShape(QScatterSeries::MarkerShapeRectangle);
-    m_askSeries->setMarkerSize(7.0); 
-    m_askSeries->setBorderColor(Qt::transparent);
-    m_bidSeries->setName("Bid IV"); 
-    m_bidSeries->setColor(Qt::red); 
-    m_bidSeries->setMarkerShape(QScatterSeries::MarkerShapeCircle);
-    m_bidSeries->setMarkerSize(7.0); 
-    m_bidSeries->setBorderColor(Qt::transparent);
-    m_chart->addSeries(m_theoSeries); 
-    m_chart->addSeries(m_askSeries); 
-    m_chart->addSeries(m_bidSeries);
-    m_chart->createDefaultAxes();
-    m_axisX = qobject_cast<QValueAxis*>(m_chart->axes(Qt::Horizontal, m_theoSeries).first());
-    m_axisY = qobject_cast<QValueAxis*>(m_chart->axes(Qt::Vertical, m_theoSeries).first());
-    if (m_axisX && m_axisY) { // Axis configuration (same as before)
-        m_axisX->setTitleText("Strike"); 
-        m_axisY->setTitleText("Implied Volatility (IV)");
-        m_axisY->setLabelFormat("%.4f"); 
-        m_axisX->setLabelFormat("%.2f");
-        m_axisY->setMin(0); 
-        m_axisX->setTickCount(11); 
-        m_axisY->setTickCount(6);
-        m_axisX->setGridLineVisible(true); 
-        m_axisY->setGridLineVisible(true); 
-        m_axisX->setMinorGridLineVisible(true); 
-        m_axisY->setMinorGridLineVisible(true);
-        QPen gridPen(QColor(220, 220, 220), 1, Qt::DotLine); 
-        QPen minorGridPen(QColor(240, 240, 240), 1, Qt::DotLine);
-        m_axisX->setGridLinePen(gridPen); 
-        m_axisY->setGridLinePen(gridPen); 
-        m_axisX->setMinorGridLinePen(minorGridPen); 
-        m_axisY->setMinorGridLinePen(minorGridPen);
-    }
-
-    setRubberBand(QChartView::RectangleRubberBand); 
-    setDragMode(QChartView::ScrollHandDrag); 
-    setRenderHint(QPainter::Antialiasing);
-    setCursor(Qt::ArrowCursor);
-
-    //connect(m_askSeries, &QScatterSeries::clicked, this, &SmilePlot::handleAskClick);
-    //connect(m_bidSeries, &QScatterSeries::clicked, this, &SmilePlot::handleBidClick);
-
-    connect(m_askSeries, &QScatterSeries::hovered, this, &SmilePlot::handleAskHover);
-    connect(m_bidSeries, &QScatterSeries::hovered, this, &SmilePlot::handleBidHover);
-}
-
-//----------------------------------------------------------------------------
-// Public Slots (No changes to updatePlot signature, change happens inside)
-//----------------------------------------------------------------------------
-void SmilePlot::updateData(const QVector<QPointF>& strikes,
-    const QVector<QPointF>& theoPoints,
-    const QVector<QPointF>& askPoints,
-    const QVector<QPointF>& bidPoints,
-    const QVector<SmilePointData>& pointDetails)
-{
-    Log.msg(FNAME + QString("Updating plot data. Points received: %1").arg(strikes.size()), Logger::Level::DEBUG);
-
-    m_pointDetails = pointDetails;
-
-    // Basic size check (optional but recommended)
-    if (!theoPoints.isEmpty() && m_pointDetails.size() != theoPoints.size()) {
-        Log.msg(FNAME + "Warning: Point details size mismatch with Theo series size. Tooltips might be incorrect.", 
-            Logger::Level::WARNING);
-    }
-
-    // Update Series Data (same as before)
-    m_theoSeries->replace(theoPoints);
-    m_askSeries->replace(askPoints);
-    m_bidSeries->replace(bidPoints);
-
-    // Adjust Axes Ranges (same as before)
-    if (!strikes.isEmpty()) {
-        if (m_axisX && m_axisY) { /* ... manual bounds calculation and setRange ... */
-            double minX = std::numeric_limits<double>::max(), maxX = std::numeric_limits<double>::lowest();
-            double minY = 0, maxY = std::numeric_limits<double>::lowest(); bool dataFound = false;
-            auto findBounds = [&](const QList<QPointF>& pts) { /* ... find bounds logic ... */
-                for (const QPointF& p : pts) { minX = qMin(minX, p.x()); maxX = qMax(maxX, p.x()); maxY = qMax(maxY, p.y()); dataFound = true; }
-                };
-            findBounds(theoPoints); findBounds(askPoints); findBounds(bidPoints);
-            if (dataFound) {
-                double xRange = maxX - minX; double yRange = maxY - minY;
-                double xPadding = (xRange < 1e-9) ? 1.0 : xRange * 0.05;
-                double yPadding = (yRange < 1e-9) ? 0.1 : yRange * 0.1;
-                m_axisX->setRange(minX - xPadding, maxX + xPadding); m_axisY->setRange(minY, maxY + yPadding);
-            }
-            else { m_axisX->setRange(0, 100); m_axisY->setRange(0, 1); }
-        }
-        else {
-            /* Log Warning */
-        }
-    }
-    else { clearPlot(); }
-    Log.msg(FNAME + QString("Plot data updated and axes adjusted."), Logger::Level::DEBUG);
-}
-
-void SmilePlot::clearPlot()
-{
-    m_theoSeries->clear(); m_askSeries->clear(); m_bidSeries->clear();
-    if (m_axisX && m_axisY) { m_axisX->setRange(0, 100); m_axisY->setRange(0, 1); }
-}
-
-void SmilePlot::resetZoom()
-{
-    if (m_chart) {
-        m_chart->zoomReset();
-        // Note: This resets zoom/pan applied via mouse interactions.
-        // It does NOT necessarily rescale axes to fit data if the underlying
-        // data hasn't changed. If you want to force a rescale AND reset zoom,
-        // you might need to call the axis adjustment logic from updatePlot again.
-        // However, zoomReset() is usually what users expect from a "Reset Zoom" button.
-    }
-    else {
-        Log.msg(FNAME + QString("Cannot reset zoom: Chart object is null."), Logger::Level::WARNING);
-    }
-}
-
-//----------------------------------------------------------------------------
-// Private Slots (Click Handlers - Use QPoint for lookup)
-//----------------------------------------------------------------------------
-/*
-void SmilePlot::handleAskClick(const QPointF& point) {
-    Log.msg(FNAME + QString("Ask IV point clicked - Strike: %1, IV: %2").arg(point.x()).arg(point.y()), Logger::Level::INFO);
-
-    int dataIndex = findDataIndexForPoint(point, m_bidSeries);
-    if (dataIndex >= 0) {
-        const SmilePointData& pointData = m_pointDetails[dataIndex];
-        QString tooltipText = pointData.formatForTooltip();
-    }
-
-    emit pointClicked(AskIV, point.x(), point.y(), mapFromGlobal(QCursor::pos()));
-}
-
-void SmilePlot::handleBidClick(const QPointF& point) {
-    Log.msg(FNAME + QString("Bid IV point clicked - Strike: %1, IV: %2").arg(point.x()).arg(point.y()), Logger::Level::INFO);
-    
-    int dataIndex = findDataIndexForPoint(point, m_bidSeries);
-    if (dataIndex >= 0) {
-        const SmilePointData& pointData = m_pointDetails[dataIndex];
-        QString tooltipText = pointData.formatForTooltip();
-    }
-
-    emit pointClicked(BidIV, point.x(), point.y(), mapFromGlobal(QCursor::pos()));
-}*/
-
-void SmilePlot::handleAskHover(const QPointF& point, bool state) {
-    if (state) {
-        m_hoveredSeries = m_askSeries;
-        mHoveredDataIndex = findDataIndexForPoint(point, m_askSeries);
-        if (mHoveredDataIndex >= 0) {
-            showPointTooltip(mHoveredDataIndex, QCursor::pos());
-        }
-    }
-    else {
-        if (m_hoveredSeries == m_askSeries) {
-            m_hoveredSeries = nullptr;
-            mHoveredDataIndex = -1;
-            QToolTip::hideText();
-        }
-    }
-}
-void SmilePlot::handleBidHover(const QPointF& point, bool state) {
-    if (state) {
-        m_hoveredSeries = m_bidSeries;
-        mHoveredDataIndex = findDataIndexForPoint(point, m_bidSeries);
-        if (mHoveredDataIndex >= 0) {
-            showPointTooltip(mHoveredDataIndex, QCursor::pos());
-        }   
-    }
-    else {
-        if (m_hoveredSeries == m_bidSeries) {
-            m_hoveredSeries = nullptr;
-            mHoveredDataIndex = -1;
-            QToolTip::hideText();
-        }
-    }
-}
-
-QChartView* SmilePlot::chartView() {
-    return reinterpret_cast<QChartView*>(this);
-}
-
-
-SmilePlot::PlotMode SmilePlot::currentMode() const
-{
-    return m_CurrentMode;
-}
-
-void SmilePlot::setCurrentMode(SmilePlot::PlotMode mode)
-{
-    m_CurrentMode = mode;
-}
-
-// --- Reimplemented Mouse Event Handlers ---
-
-void SmilePlot::mousePressEvent(QMouseEvent* event) {
-    if (m_CurrentMode == pmPan && event->button() == Qt::LeftButton) {
-        m_panLastPos = event->pos(); // Record position relative to this widget
-        m_isPanning = true;
-        this->setCursor(Qt::ArrowCursor);
-        event->accept(); // Indicate we handled this
-    }
-    else if (m_CurrentMode == pmZoom) {
-        // Let QChartView handle the start of rubber band selection
-        QChartView::mousePressEvent(event);
-    }
-    else {
-        // Pass event to base class if not panning/zooming
-        QChartView::mousePressEvent(event);
-    }
-}
-
-void SmilePlot::mouseMoveEvent(QMouseEvent* event) {
-    if (m_isPanning) { // Check if we are in a panning drag
-        // Calculate delta and scroll the chart's axes
-        QPoint delta = event->pos() - m_panLastPos;
-        m_chart->scroll(-delta.x(), delta.y());
-        m_panLastPos = event->pos(); // Update position for next move
-        event->accept(); // Indicate we handled this
-    }
-    else {
-        QChartView::mouseMoveEvent(event);
-    }
-}
-
-void SmilePlot::mouseReleaseEvent(QMouseEvent* event) {
-    if (m_isPanning && event->button() == Qt::LeftButton) {
-        m_isPanning = false;
-        event->accept();
-    }
-    else if (m_CurrentMode == pmZoom && event->button() == Qt::LeftButton) {
-        // Let base class handle zoom first
-        QChartView::mouseReleaseEvent(event);
-    }
-    else if (event->button() == Qt::LeftButton) {
-        // --- Check for Click Confirmation via Hover ---
-        // If mouse is released AND a point was being hovered over
-        if (m_hoveredSeries && mHoveredDataIndex != -1) {
-            Log.msg(FNAME + "Click confirmed via hover for index: " + 
-                QString::number(mHoveredDataIndex), Logger::Level::DEBUG);
-            if (mHoveredDataIndex >= 0 && mHoveredDataIndex < m_pointDetails.size()) {
-                // Emit the signal with the data of the hovered point
-                emit pointClicked(m_pointDetails[mHoveredDataIndex]);
-            }
-            else {
-                Log.msg(FNAME + "Hovered index " + QString::number(mHoveredDataIndex) + 
-                    " out of bounds for details.", Logger::Level::WARNING);
-            }
-            // Optionally hide tooltip after click?
-            //QToolTip::hideText();
-            event->accept(); // Event handled
-        }
-        else {
-            // Mouse released, but not over a known point, pass to base
-            QChartView::mouseReleaseEvent(event);
-        }
-        // --- End Click Confirmation ---
-    }
-    else {
-        // Other mouse buttons
-        QChartView::mouseReleaseEvent(event);
-    }
-}
-
-void SmilePlot::wheelEvent(QWheelEvent* event) {
-    // Get the angle delta to determine direction and magnitude
-    // Positive delta usually means scrolling UP (zoom in), negative means DOWN (zoom out)
-    const qreal delta = event->angleDelta().y(); // Use vertical delta
-
-    if (qFuzzyIsNull(delta)) { // Check if delta is effectively zero
-        event->accept(); // Accept the event but do nothing
-        return;
-    }
-
-    // Define zoom factor (adjust sensitivity as needed)
-    const qreal factor = 1.15; // Zoom factor > 1 for zooming in
-
-    if (delta > 0) {
-        // Zoom In
-        m_chart->zoom(factor); // Zoom the chart by the factor (centered)
-    }
-    else {
-        // Zoom Out
-        m_chart->zoom(1.0 / factor); // Zoom out by the inverse factor
-    }
-
-    event->accept(); // Indicate we handled the wheel event
-}
-
-// Optional: Clear hover state if mouse leaves the plot widget
-void SmilePlot::leaveEvent(QEvent *event) {
-    Q_UNUSED(event);
-    if (m_hoveredSeries) {
-        m_hoveredSeries = nullptr;
-        mHoveredDataIndex = -1;
-        QToolTip::hideText();
-    }
-}
-
-// --- Tooltip Helper ---
-void SmilePlot::showPointTooltip(int dataIndex, const QPoint& globalPos) {
-    if (dataIndex >= 0) {
-        const SmilePointData& pointData = m_pointDetails[dataIndex];
-        QString tooltipText = pointData.formatForTooltip();
-        QToolTip::showText(globalPos, tooltipText, this, this->rect());
-    }
-    else {
-        QToolTip::hideText();
-    }
-}
-
-// Helper to find the index in mPointDetails corresponding to a clicked/hovered point
-int SmilePlot::findDataIndexForPoint(const QPointF& seriesPoint, QAbstractSeries* series) const {
-    if (!series) return -1;
-    QList<QPointF> points;
-    if (auto* lineSeries = qobject_cast<QLineSeries*>(series)) { points = lineSeries->points(); }
-    else if (auto* scatterSeries = qobject_cast<QScatterSeries*>(series)) { points = scatterSeries->points(); }
-    else { return -1; }
-
-    if (points.isEmpty()) return -1;
-
-    constexpr qreal tolerance = 1e-9; // Tolerance for float comparison
-    int foundIndex = -1;
-
-    for (int i = 0; i < points.size(); ++i) {
-        if (std::fabs(points[i].x() - seriesPoint.x()) < tolerance &&
-            std::fabs(points[i].y() - seriesPoint.y()) < tolerance) {
-            foundIndex = i;
-            break;
-        }
-    }
-
-    if (foundIndex != -1) {
-        // Check against the MEMBER variable mPointDetails bounds
-        if (foundIndex < m_pointDetails.size()) {
-            return foundIndex;
-        }
-        else {
-            Log.msg(FNAME + "Series index " + QString::number(foundIndex) + 
-                " out of bounds for details vector size " + 
-                QString::number(m_pointDetails.size()), Logger::Level::WARNING);
-            return -1;
-        }
-    }
-    // Log.msg(FNAME + "Could not find exact matching point in series.", Logger::Level::TRACE);
-    return -1;
-}
-
-// --- End Mouse Event Handlers ---
+#include "SmilePlot.h"
+#include "SmileDecimator.h"
+#include "Glob/Logger.h"
+
+#include <QVBoxLayout>
+#include <QToolButton>
+#include <QButtonGroup>
+#include <QIcon>
+#include <QRubberBand>
+#include <QMouseEvent>
+#include <QToolTip>
+#include <QChartView>
+#include <QtCharts/QChart>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QScatterSeries>
+#include <QtCharts/QValueAxis>
+#include <QApplication>
+#include <QToolTip>
+#include <QDebug>
+#include <limits>
+#include <cmath> // For std::isnan, std::isinf
+
+
+//----------------------------------------------------------------------------
+// Constructor and Setup (No changes needed here)
+//----------------------------------------------------------------------------
+SmilePlot::SmilePlot(QWidget* parent)
+    : QChartView(new QChart(), parent)
+{
+    m_CurrentMode = SmilePlot::PlotMode::pmPan;
+    m_chart = chart();
+    setupChart();
+
+    // Enable mouse tracking to receive mouseMoveEvents even when no button is pressed (for hover)
+    this->setMouseTracking(true);
+    m_chart->setAcceptHoverEvents(true); // Ensure chart processes hover
+}
+
+void SmilePlot::setupChart()
+{
+    m_chart->setTitle("Implied Volatility Smile");
+    m_chart->legend()->setVisible(true); 
+    m_chart->legend()->setAlignment(Qt::AlignBottom);
+    m_theoSeries = new QLineSeries(m_chart); 
+    m_askSeries = new QScatterSeries(m_chart); 
+    m_bidSeries = new QScatterSeries(m_chart);
+    m_theoSeries->setName("Theo IVs"); 
+    m_theoSeries->setColor(Qt::darkGreen); 
+    m_theoSeries->setPen(QPen(Qt::darkGreen, 2));
+    m_askSeries->setName("Ask IV"); 
+    m_askSeries->setColor(Qt::blue); 
+    m_askSeries->setMarkerShape(QScatterSeries::MarkerShapeRectangle);
+    m_askSeries->setMarkerSize(7.0); 
+    m_askSeries->setBorderColor(Qt::transparent);
+    m_bidSeries->setName("Bid IV"); 
+    m_bidSeries->setColor(Qt::red); 
+    m_bidSeries->setMarkerShape(QScatterSeries::MarkerShapeCircle);
+    m_bidSeries->setMarkerSize(7.0); 
+    m_bidSeries->setBorderColor(Qt::transparent);
+    m_chart->addSeries(m_theoSeries); 
+    m_chart->addSeries(m_askSeries); 
+    m_chart->addSeries(m_bidSeries);
+    m_chart->createDefaultAxes();
+    m_axisX = qobject_cast<QValueAxis*>(m_chart->axes(Qt::Horizontal, m_theoSeries).first());
+    m_axisY = qobject_cast<QValueAxis*>(m_chart->axes(Qt::Vertical, m_theoSeries).first());
+    if (m_axisX && m_axisY) { // Axis configuration (same as before)
+        m_axisX->setTitleText("Strike"); 
+        m_axisY->setTitleText("Implied Volatility (IV)");
+        m_axisY->setLabelFormat("%.4f"); 
+        m_axisX->setLabelFormat("%.2f");
+        m_axisY->setMin(0); 
+        m_axisX->setTickCount(11); 
+        m_axisY->setTickCount(6);
+        m_axisX->setGridLineVisible(true); 
+        m_axisY->setGridLineVisible(true); 
+        m_axisX->setMinorGridLineVisible(true); 
+        m_axisY->setMinorGridLineVisible(true);
+        QPen gridPen(QColor(220, 220, 220), 1, Qt::DotLine); 
+        QPen minorGridPen(QColor(240, 240, 240), 1, Qt::DotLine);
+        m_axisX->setGridLinePen(gridPen); 
+        m_axisY->setGridLinePen(gridPen); 
+        m_axisX->setMinorGridLinePen(minorGridPen); 
+        m_axisY->setMinorGridLinePen(minorGridPen);
+    }
+
+    setRubberBand(QChartView::RectangleRubberBand); 
+    setDragMode(QChartView::ScrollHandDrag); 
+    setRenderHint(QPainter::Antialiasing);
+    setCursor(Qt::ArrowCursor);
+
+    // Hover and click are hit-tested in mouseMoveEvent through m_hitIndex (see findDataIndexAt)
+
+    // Zoom, pan and wheel all end up changing the x range (buckets do not depend on y)
+    m_decimationTimer.setSingleShot(true);
+    m_decimationTimer.setInterval(0);
+    connect(&m_decimationTimer, &QTimer::timeout, this, &SmilePlot::replaceSeries);
+    if (m_axisX) {
+        connect(m_axisX, &QValueAxis::rangeChanged, this, &SmilePlot::scheduleDecimation);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Public Slots (No changes to updatePlot signature, change happens inside)
+//----------------------------------------------------------------------------
+void SmilePlot::updateData(const PlotDataForDate& data)
+{
+    Trace::Scope scope(Trace::Stage::PlotUpdate);
+    Log.msg(FNAME + QString("Updating plot data. Points received: %1").arg(data.size()), Logger::Level::DEBUG);
+
+    // Same row layout as the plotted data: only the rows that differ from it are updated
+    QVector<qsizetype> changedRows;
+    if (canUpdateInPlace(data) && diffRows(data, changedRows)) {
+        if (changedRows.isEmpty()) {
+            m_data = data; // Nothing to redraw
+        }
+        else {
+            applyChangedRows(data, changedRows);
+        }
+        return;
+    }
+    replaceAll(data);
+    Log.msg(FNAME + QString("Plot data updated and axes adjusted."), Logger::Level::DEBUG);
+}
+
+// Applies a delta: only the changed points are replaced, the series keep their other points
+void SmilePlot::updateRows(const PlotDataForDate& data, const QVector<qsizetype>& changedRows)
+{
+    Trace::Scope scope(Trace::Stage::PlotUpdate);
+    // Fall back to a full refresh when the layout differs or most points changed anyway
+    if (!canUpdateInPlace(data) || changedRows.isEmpty() || changedRows.size() > data.size() / 4) {
+        replaceAll(data);
+        return;
+    }
+    applyChangedRows(data, changedRows);
+}
+
+bool SmilePlot::canUpdateInPlace(const PlotDataForDate& data) const
+{
+    return !m_data.isEmpty() && data.size() == m_data.size()
+        && (m_decimated || data.size() == m_theoSeries->count());
+}
+
+// Rows of 'data' whose x or plotted y differ from m_data. Columns still shared with m_data (the
+// untouched columns of a delta) are skipped without reading them. Returns false as soon as more
+// than a quarter of the rows differ: a full replace is cheaper then.
+bool SmilePlot::diffRows(const PlotDataForDate& data, QVector<qsizetype>& changedRows) const
+{
+    const qsizetype rows = data.size();
+    const qsizetype limit = rows / 4;
+    const QVector<double>* before[] = { &m_data.logMoneyness, &m_data.theoIv, &m_data.askIv, &m_data.bidIv };
+    const QVector<double>* after[] = { &data.logMoneyness, &data.theoIv, &data.askIv, &data.bidIv };
+
+    const double* a[4];
+    const double* b[4];
+    int columns = 0;
+    for (int c = 0; c < 4; ++c) {
+        if (before[c]->constData() == after[c]->constData()) continue;
+        if (before[c]->size() != rows || after[c]->size() != rows) return false;
+        a[columns] = before[c]->constData();
+        b[columns] = after[c]->constData();
+        ++columns;
+    }
+    if (columns == 0) return true;
+
+    // NaN == NaN counts as unchanged
+    auto differs = [](double x, double y) { return x != y && !(std::isnan(x) && std::isnan(y)); };
+    for (qsizetype row = 0; row < rows; ++row) {
+        for (int c = 0; c < columns; ++c) {
+            if (differs(a[c][row], b[c][row])) {
+                if (changedRows.size() >= limit) return false;
+                changedRows.append(row);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+void SmilePlot::applyChangedRows(const PlotDataForDate& data, const QVector<qsizetype>& changedRows)
+{
+    Log.msg(FNAME + QString("Updating %1 changed points.").arg(changedRows.size()), Logger::Level::DEBUG);
+    const PlotDataForDate previous = m_data; // Shallow: old values for the incremental bounds
+    m_data = data;
+    m_hitIndex.update(m_data.logMoneyness, changedRows);
+    updateBounds(previous, changedRows);
+    applyAxisRange();
+
+    if (m_decimated) {
+        // Series index != row: decimate the visible range again (bounded by the plot width, not the chain)
+        replaceSeries();
+        return;
+    }
+
+    const double* x = m_data.logMoneyness.constData();
+    for (qsizetype row : changedRows) {
+        if (row < 0 || row >= m_data.size()) continue;
+        const int index = static_cast<int>(row);
+        m_theoSeries->replace(index, QPointF(x[row], m_data.theoIv[row]));
+        m_askSeries->replace(index, QPointF(x[row], m_data.askIv[row]));
+        m_bidSeries->replace(index, QPointF(x[row], m_data.bidIv[row]));
+    }
+}
+
+void SmilePlot::replaceAll(const PlotDataForDate& data)
+{
+    m_data = data; // Implicitly shared columns, no deep copy
+    m_hitIndex.rebuild(m_data.logMoneyness);
+
+    // Axes first: a decimated view depends on the visible range
+    adjustAxes();
+    replaceSeries();
+}
+
+// Fits the axes to the plotted columns (full scan)
+void SmilePlot::adjustAxes()
+{
+    if (m_data.isEmpty()) {
+        clearPlot();
+        return;
+    }
+    recomputeBounds();
+    applyAxisRange();
+}
+
+namespace {
+    // Highest finite IV of a row over the plotted series, lowest() if none
+    double rowMaxY(const PlotDataForDate& data, qsizetype row) {
+        double maxY = std::numeric_limits<double>::lowest();
+        for (const QVector<double>* column : { &data.theoIv, &data.askIv, &data.bidIv }) {
+            const double y = column->value(row, std::numeric_limits<double>::quiet_NaN());
+            if (std::isfinite(y)) maxY = qMax(maxY, y);
+        }
+        return maxY;
+    }
+}
+
+void SmilePlot::recomputeBounds()
+{
+    m_bounds = Bounds();
+    const qsizetype rows = m_data.size();
+    const double* x = m_data.logMoneyness.constData();
+    for (qsizetype i = 0; i < rows; ++i) {
+        if (std::isfinite(x[i])) {
+            m_bounds.minX = qMin(m_bounds.minX, x[i]);
+            m_bounds.maxX = qMax(m_bounds.maxX, x[i]);
+        }
+        m_bounds.maxY = qMax(m_bounds.maxY, rowMaxY(m_data, i));
+    }
+}
+
+// O(changed): a changed row can only push a bound out, unless it was the row holding that bound
+// and moved inwards; only then are all rows scanned again.
+void SmilePlot::updateBounds(const PlotDataForDate& previous, const QVector<qsizetype>& changedRows)
+{
+    for (qsizetype row : changedRows) {
+        if (row < 0 || row >= m_data.size()) continue;
+        const double oldX = previous.logMoneyness.value(row, std::numeric_limits<double>::quiet_NaN());
+        const double newX = m_data.logMoneyness[row];
+        const double oldY = rowMaxY(previous, row);
+        const double newY = rowMaxY(m_data, row);
+
+        const bool xFinite = std::isfinite(newX);
+        if ((oldX == m_bounds.minX && !(xFinite && newX <= oldX))
+            || (oldX == m_bounds.maxX && !(xFinite && newX >= oldX))
+            || (oldY == m_bounds.maxY && newY < oldY)) {
+            recomputeBounds();
+            return;
+        }
+        if (xFinite) {
+            m_bounds.minX = qMin(m_bounds.minX, newX);
+            m_bounds.maxX = qMax(m_bounds.maxX, newX);
+        }
+        m_bounds.maxY = qMax(m_bounds.maxY, newY);
+    }
+}
+
+// Padded range of m_bounds. setRange (axis relayout, full series repaint) is skipped when the
+// range did not change, which also keeps a user zoom across steady-state updates.
+void SmilePlot::applyAxisRange()
+{
+    if (!m_axisX || !m_axisY) return;
+
+    double minX = 0, maxX = 100, minY = 0, maxY = 1;
+    if (m_bounds.minX <= m_bounds.maxX && m_bounds.maxY > std::numeric_limits<double>::lowest()) {
+        const double xRange = m_bounds.maxX - m_bounds.minX;
+        const double yRange = m_bounds.maxY - minY;
+        const double xPadding = (xRange < 1e-9) ? 1.0 : xRange * 0.05;
+        const double yPadding = (yRange < 1e-9) ? 0.1 : yRange * 0.1;
+        minX = m_bounds.minX - xPadding; maxX = m_bounds.maxX + xPadding;
+        maxY = m_bounds.maxY + yPadding;
+    }
+    const AxisRange range{ minX, maxX, minY, maxY };
+    if (range == m_appliedRange) return;
+    m_appliedRange = range;
+    m_axisX->setRange(minX, maxX);
+    m_axisY->setRange(minY, maxY);
+}
+
+void SmilePlot::replaceSeries()
+{
+    m_decimationTimer.stop();
+    m_decimated = m_data.size() > FULL_RESOLUTION_POINTS && m_axisX;
+    if (!m_decimated) {
+        // Update Series Data: x is the shared logMoneyness column
+        m_theoSeries->replace(m_data.points(m_data.theoIv));
+        m_askSeries->replace(m_data.points(m_data.askIv));
+        m_bidSeries->replace(m_data.points(m_data.bidIv));
+        return;
+    }
+
+    const double minX = m_axisX->min();
+    const double maxX = m_axisX->max();
+    const int buckets = qMax(1, qRound(m_chart->plotArea().width()));
+    m_theoSeries->replace(SmileDecimator::minMaxPerBucket(m_hitIndex, m_data.theoIv, minX, maxX, buckets));
+    m_askSeries->replace(SmileDecimator::minMaxPerBucket(m_hitIndex, m_data.askIv, minX, maxX, buckets));
+    m_bidSeries->replace(SmileDecimator::minMaxPerBucket(m_hitIndex, m_data.bidIv, minX, maxX, buckets));
+}
+
+void SmilePlot::scheduleDecimation()
+{
+    if (m_decimated && !m_decimationTimer.isActive()) {
+        m_decimationTimer.start();
+    }
+}
+
+void SmilePlot::clearPlot()
+{
+    m_data.clear();
+    m_hitIndex.clear();
+    m_decimated = false;
+    m_decimationTimer.stop();
+    clearHover();
+    m_theoSeries->clear(); m_askSeries->clear(); m_bidSeries->clear();
+    m_bounds = Bounds();
+    applyAxisRange(); // Back to 0..100 x 0..1
+}
+
+void SmilePlot::resetZoom()
+{
+    if (m_chart) {
+        m_chart->zoomReset();
+        // Note: This resets zoom/pan applied via mouse interactions.
+        // It does NOT necessarily rescale axes to fit data if the underlying
+        // data hasn't changed. If you want to force a rescale AND reset zoom,
+        // you might need to call the axis adjustment logic from updatePlot again.
+        // However, zoomReset() is usually what users expect from a "Reset Zoom" button.
+    }
+    else {
+        Log.msg(FNAME + QString("Cannot reset zoom: Chart object is null."), Logger::Level::WARNING);
+    }
+}
+
+QChartView* SmilePlot::chartView() {
+    return reinterpret_cast<QChartView*>(this);
+}
+
+
+SmilePlot::PlotMode SmilePlot::currentMode() const
+{
+    return m_CurrentMode;
+}
+
+void SmilePlot::setCurrentMode(SmilePlot::PlotMode mode)
+{
+    m_CurrentMode = mode;
+    // Panning is done in mouseMoveEvent, zooming by the chart view's rubber band
+    setDragMode(QGraphicsView::NoDrag);
+    if (mode == pmPan) {
+        setRubberBand(QChartView::NoRubberBand);
+        setCursor(Qt::ArrowCursor);
+    }
+    else {
+        setRubberBand(QChartView::RectangleRubberBand);
+        setCursor(Qt::CrossCursor);
+    }
+}
+
+void SmilePlot::setTrace(const Trace::Timeline& trace) {
+    m_pendingTrace = trace;
+}
+
+void SmilePlot::paintEvent(QPaintEvent* event) {
+    {
+        Trace::Scope scope(Trace::Stage::Paint);
+        QChartView::paintEvent(event);
+    }
+    if (m_pendingTrace.isValid()) {
+        // First paint after the update: the message reached the screen
+        Trace::recordSince(Trace::Stage::EndToEnd, m_pendingTrace.receiveNs);
+        m_pendingTrace = Trace::Timeline();
+    }
+}
+
+void SmilePlot::resizeEvent(QResizeEvent* event) {
+    QChartView::resizeEvent(event);
+    scheduleDecimation(); // One bucket per pixel column of the new plot area
+}
+
+// --- Reimplemented Mouse Event Handlers ---
+
+void SmilePlot::mousePressEvent(QMouseEvent* event) {
+    if (m_CurrentMode == pmPan && event->button() == Qt::LeftButton) {
+        m_panLastPos = event->pos(); // Record position relative to this widget
+        m_isPanning = true;
+        this->setCursor(Qt::ArrowCursor);
+        event->accept(); // Indicate we handled this
+    }
+    else if (m_CurrentMode == pmZoom) {
+        // Let QChartView handle the start of rubber band selection
+        QChartView::mousePressEvent(event);
+    }
+    else {
+        // Pass event to base class if not panning/zooming
+        QChartView::mousePressEvent(event);
+    }
+}
+
+void SmilePlot::mouseMoveEvent(QMouseEvent* event) {
+    if (m_isPanning) { // Check if we are in a panning drag
+        // Calculate delta and scroll the chart's axes
+        QPoint delta = event->pos() - m_panLastPos;
+        m_chart->scroll(-delta.x(), delta.y());
+        m_panLastPos = event->pos(); // Update position for next move
+        event->accept(); // Indicate we handled this
+    }
+    else {
+        QChartView::mouseMoveEvent(event);
+        updateHover(event->pos());
+    }
+}
+
+void SmilePlot::mouseReleaseEvent(QMouseEvent* event) {
+    if (m_isPanning && event->button() == Qt::LeftButton) {
+        m_isPanning = false;
+        event->accept();
+    }
+    else if (m_CurrentMode == pmZoom && event->button() == Qt::LeftButton) {
+        // Let base class handle zoom first
+        QChartView::mouseReleaseEvent(event);
+    }
+    else if (event->button() == Qt::LeftButton) {
+        // --- Check for Click Confirmation via Hover ---
+        // If mouse is released AND a point was being hovered over
+        if (m_hoveredSeries && mHoveredDataIndex != -1) {
+            Log.msg(FNAME + "Click confirmed via hover for index: " + 
+                QString::number(mHoveredDataIndex), Logger::Level::DEBUG);
+            if (mHoveredDataIndex >= 0 && mHoveredDataIndex < m_data.size()) {
+                // Emit the signal with the data of the hovered point
+                emit pointClicked(m_data.pointAt(mHoveredDataIndex));
+            }
+            else {
+                Log.msg(FNAME + "Hovered index " + QString::number(mHoveredDataIndex) + 
+                    " out of bounds for details.", Logger::Level::WARNING);
+            }
+            // Optionally hide tooltip after click?
+            //QToolTip::hideText();
+            event->accept(); // Event handled
+        }
+        else {
+            // Mouse released, but not over a known point, pass to base
+            QChartView::mouseReleaseEvent(event);
+        }
+        // --- End Click Confirmation ---
+    }
+    else {
+        // Other mouse buttons
+        QChartView::mouseReleaseEvent(event);
+    }
+}
+
+void SmilePlot::wheelEvent(QWheelEvent* event) {
+    // Get the angle delta to determine direction and magnitude
+    // Positive delta usually means scrolling UP (zoom in), negative means DOWN (zoom out)
+    const qreal delta = event->angleDelta().y(); // Use vertical delta
+
+    if (qFuzzyIsNull(delta)) { // Check if delta is effectively zero
+        event->accept(); // Accept the event but do nothing
+        return;
+    }
+
+    // Define zoom factor (adjust sensitivity as needed)
+    const qreal factor = 1.15; // Zoom factor > 1 for zooming in
+
+    if (delta > 0) {
+        // Zoom In
+        m_chart->zoom(factor); // Zoom the chart by the factor (centered)
+    }
+    else {
+        // Zoom Out
+        m_chart->zoom(1.0 / factor); // Zoom out by the inverse factor
+    }
+
+    event->accept(); // Indicate we handled the wheel event
+}
+
+// Optional: Clear hover state if mouse leaves the plot widget
+void SmilePlot::leaveEvent(QEvent *event) {
+    Q_UNUSED(event);
+    clearHover();
+}
+
+// --- Tooltip Helper ---
+void SmilePlot::showPointTooltip(int dataIndex, const QPoint& globalPos) {
+    if (dataIndex >= 0 && dataIndex < m_data.size()) {
+        const SmilePointData pointData = m_data.pointAt(dataIndex);
+        QString tooltipText = pointData.formatForTooltip();
+        QToolTip::showText(globalPos, tooltipText, this, this->rect());
+    }
+    else {
+        QToolTip::hideText();
+    }
+}
+
+// Column holding the y values of a series (x is always m_data.logMoneyness)
+const QVector<double>* SmilePlot::columnForSeries(QAbstractSeries* series) const {
+    if (series == m_theoSeries) return &m_data.theoIv;
+    if (series == m_askSeries) return &m_data.askIv;
+    if (series == m_bidSeries) return &m_data.bidIv;
+    return nullptr;
+}
+
+// Nearest point of any series to the cursor, in screen distance: the hit index narrows the search
+// to the rows whose x is within HIT_RADIUS_PX, so the cost does not grow with the chain width.
+int SmilePlot::findDataIndexAt(const QPoint& pos, QAbstractSeries** series) const {
+    if (m_data.isEmpty() || !m_axisX || !m_axisY) return -1;
+    const QRectF plotArea = m_chart->plotArea();
+    const QPointF chartPos = m_chart->mapFromScene(mapToScene(pos));
+    if (!plotArea.adjusted(-HIT_RADIUS_PX, -HIT_RADIUS_PX, HIT_RADIUS_PX, HIT_RADIUS_PX).contains(chartPos)) return -1;
+
+    const double rangeX = m_axisX->max() - m_axisX->min();
+    const double rangeY = m_axisY->max() - m_axisY->min();
+    if (rangeX <= 0.0 || rangeY <= 0.0) return -1;
+
+    const QPointF value = m_chart->mapToValue(chartPos, m_theoSeries);
+    QAbstractSeries* const candidates[] = { m_theoSeries, m_askSeries, m_bidSeries };
+    QVector<const QVector<double>*> columns;
+    for (QAbstractSeries* candidate : candidates) {
+        columns.append(candidate->isVisible() ? columnForSeries(candidate) : nullptr);
+    }
+    const SmileHitIndex::Hit hit = m_hitIndex.nearest(value, columns,
+        plotArea.width() / rangeX, plotArea.height() / rangeY, HIT_RADIUS_PX);
+    if (!hit.isValid()) return -1;
+    if (series) *series = candidates[hit.column];
+    return static_cast<int>(hit.row);
+}
+
+void SmilePlot::updateHover(const QPoint& pos) {
+    QAbstractSeries* series = nullptr;
+    const int dataIndex = findDataIndexAt(pos, &series);
+    if (dataIndex < 0) {
+        clearHover();
+        return;
+    }
+    if (dataIndex == mHoveredDataIndex && series == m_hoveredSeries) return; // Same point, tooltip already shown
+    m_hoveredSeries = series;
+    mHoveredDataIndex = dataIndex;
+    showPointTooltip(mHoveredDataIndex, mapToGlobal(pos));
+}
+
+void SmilePlot::clearHover() {
+    if (m_hoveredSeries || mHoveredDataIndex != -1) {
+        m_hoveredSeries = nullptr;
+        mHoveredDataIndex = -1;
+        QToolTip::hideText();
+    }
+}
+
+// --- End Mouse Event Handlers ---
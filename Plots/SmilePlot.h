@@ -1,99 +1,144 @@
-#pragma once
-
-#include <QtCharts/QChartView>
-#include <QtCharts/qchartglobal.h>
-
-//QT_CHARTS_BEGIN_NAMESPACE
-class QChartView;
-class QChart;
-class QLineSeries;
-class QScatterSeries;
-class QValueAxis;
-//QT_CHARTS_END_NAMESPACE
-
-#include <QVector>
-#include <QStringList>
-#include <QHash>
-#include <QPoint>
-#include <QPointF> // Needed for QMap key
-#include <QMouseEvent>
-#include <QWheelEvent>
-#include <QPointer>
-
-#include "SmilePointData.h"
-
-class SmilePlot : public QChartView
-{
-    Q_OBJECT
-
-public:
-    explicit SmilePlot(QWidget* parent = nullptr);
-    ~SmilePlot() override = default;
-
-    enum ScatterType { AskIV, BidIV };
-    Q_ENUM(ScatterType)
-
-        // Enum for interaction modes
-    enum PlotMode {
-        pmPan, // Drag to move
-        pmZoom // Drag to zoom region
-    };
-    Q_ENUM(PlotMode)
-
-    QChartView* chartView();
-    PlotMode currentMode() const;
-    void setCurrentMode(PlotMode);
-
-protected:
-    void mousePressEvent(QMouseEvent* event) override;
-    void mouseMoveEvent(QMouseEvent* event) override;
-    void mouseReleaseEvent(QMouseEvent* event) override;
-    void leaveEvent(QEvent* event) override;
-    void wheelEvent(QWheelEvent* event) override;
-
-signals:
-    void pointClicked(const SmilePointData& pointData);
-
-public slots:
-    void updateData(const QVector<QPointF>& strikes,
-        const QVector<QPointF>& theoIvs,
-        const QVector<QPointF>& askIvs,
-        const QVector<QPointF>& bidIvs,
-        const QVector<SmilePointData>& pointDetails);
-    void clearPlot();
-    void resetZoom();
-
-private slots:
-    //void handleAskClick(const QPointF& point);
-    //void handleBidClick(const QPointF& point);
-
-    void handleAskHover(const QPointF& point, bool state);
-    void handleBidHover(const QPointF& point, bool state);
-
-private:
-    QChart* m_chart = nullptr;
-    QLineSeries* m_theoSeries = nullptr;
-    QScatterSeries* m_askSeries = nullptr;
-    QScatterSeries* m_bidSeries = nullptr;
-    QValueAxis* m_axisX = nullptr;
-    QValueAxis* m_axisY = nullptr;
-
-    void setupChart();
-
-    PlotMode m_CurrentMode;
-    // Panning State
-    bool m_isPanning = false;
-    QPoint m_panLastPos;
-
-    // Stores details for the currently plotted points
-    QVector<SmilePointData> m_pointDetails;
-
-    // --- Hover/Click State ---
-    QPointer<QAbstractSeries> m_hoveredSeries = nullptr; // Store pointer to hovered series
-    int mHoveredDataIndex = -1; // Store index of the point within mPointDetails
-    // --- End Hover/Click State ---
-
-    int findDataIndexForPoint(const QPointF& seriesPoint, QAbstractSeries* series) const;
-    // Helper to show tooltip (can be called by hover handlers)
-    void showPointTooltip(int dataIndex, const QPoint& globalPos);
+#pragma once
+
+#include <QtCharts/QChartView>
+#include <QtCharts/qchartglobal.h>
+
+//QT_CHARTS_BEGIN_NAMESPACE
+class QChartView;
+class QChart;
+class QLineSeries;
+class QScatterSeries;
+class QValueAxis;
+//QT_CHARTS_END_NAMESPACE
+
+#include <QVector>
+#include <QStringList>
+#include <QHash>
+#include <QPoint>
+#include <QPointF> // Needed for QMap key
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QPointer>
+#include <QTimer>
+
+#include <limits>
+
+#include "SmilePointData.h"
+#include "PlotDataForDate.h"
+#include "SmileHitIndex.h"
+#include "SmilePlotView.h"
+#include "Glob/Trace.h"
+
+// Qt Charts renderer of SmilePlotView
+class SmilePlot : public QChartView, public SmilePlotView
+{
+    Q_OBJECT
+
+public:
+    explicit SmilePlot(QWidget* parent = nullptr);
+    ~SmilePlot() override = default;
+
+    enum ScatterType { AskIV, BidIV };
+    Q_ENUM(ScatterType)
+
+    QWidget* widget() override { return this; }
+    QChartView* chartView();
+    PlotMode currentMode() const override;
+    void setCurrentMode(PlotMode) override;
+    // Timeline of the data passed to the next update; its end-to-end latency is recorded when painted
+    void setTrace(const Trace::Timeline& trace) override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void leaveEvent(QEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+
+signals:
+    void pointClicked(const SmilePointData& pointData);
+
+public slots:
+    void updateData(const PlotDataForDate& data) override;
+    // Same row layout as the plotted data, only 'changedRows' differ (delta update)
+    void updateRows(const PlotDataForDate& data, const QVector<qsizetype>& changedRows) override;
+    void clearPlot() override;
+    void resetZoom() override;
+
+private:
+    QChart* m_chart = nullptr;
+    QLineSeries* m_theoSeries = nullptr;
+    QScatterSeries* m_askSeries = nullptr;
+    QScatterSeries* m_bidSeries = nullptr;
+    QValueAxis* m_axisX = nullptr;
+    QValueAxis* m_axisY = nullptr;
+
+    void setupChart();
+    void adjustAxes();
+
+    // --- Incremental updates ---
+    // Data bounds of m_data (x over logMoneyness, y = highest plotted IV; the y axis starts at 0)
+    struct Bounds {
+        double minX = std::numeric_limits<double>::max();
+        double maxX = std::numeric_limits<double>::lowest();
+        double maxY = std::numeric_limits<double>::lowest();
+    };
+    Bounds m_bounds;
+    struct AxisRange {
+        double minX = std::numeric_limits<double>::quiet_NaN();
+        double maxX = std::numeric_limits<double>::quiet_NaN();
+        double minY = std::numeric_limits<double>::quiet_NaN();
+        double maxY = std::numeric_limits<double>::quiet_NaN();
+        bool operator==(const AxisRange&) const = default; // Never true before the first setRange (NaN)
+    };
+    AxisRange m_appliedRange; // Last range set on the axes
+
+    // Same row count as m_data and series in sync with it (per-row replace possible)
+    bool canUpdateInPlace(const PlotDataForDate& data) const;
+    bool diffRows(const PlotDataForDate& data, QVector<qsizetype>& changedRows) const;
+    void applyChangedRows(const PlotDataForDate& data, const QVector<qsizetype>& changedRows);
+    void replaceAll(const PlotDataForDate& data);
+    void recomputeBounds();
+    void updateBounds(const PlotDataForDate& previous, const QVector<qsizetype>& changedRows);
+    void applyAxisRange();
+    // Fills the series from m_data: every point up to FULL_RESOLUTION_POINTS rows, otherwise
+    // the visible range decimated to at most two points per pixel column (SmileDecimator)
+    void replaceSeries();
+    // Re-decimates after zoom/pan/resize, coalesced to once per event loop pass
+    void scheduleDecimation();
+
+    PlotMode m_CurrentMode;
+    // Panning State
+    bool m_isPanning = false;
+    QPoint m_panLastPos;
+
+    // Columns of the currently plotted smile (shallow copy of the snapshot data).
+    // Tooltip/click details are built from one row on demand via pointAt().
+    PlotDataForDate m_data;
+    Trace::Timeline m_pendingTrace; // Not painted yet
+
+    // --- Level of detail ---
+    bool m_decimated = false; // The series hold a decimated view of m_data (series index != row)
+    QTimer m_decimationTimer; // Single shot, 0 ms
+    static constexpr qsizetype FULL_RESOLUTION_POINTS = 2000;
+
+    // --- Hover/Click State ---
+    // Rows of m_data sorted by x: hover and click look up the nearest point of any series (theo line
+    // included) within HIT_RADIUS_PX, instead of relying on per-marker hover events
+    SmileHitIndex m_hitIndex;
+    QPointer<QAbstractSeries> m_hoveredSeries = nullptr; // Store pointer to hovered series
+    int mHoveredDataIndex = -1; // Store index of the point (row) within m_data
+    static constexpr double HIT_RADIUS_PX = 8.0;
+    // --- End Hover/Click State ---
+
+    // Nearest plotted point to the widget position 'pos': its row in m_data, and its series in 'series'. -1 if none.
+    int findDataIndexAt(const QPoint& pos, QAbstractSeries** series) const;
+    // Updates the hovered point and its tooltip for the cursor at 'pos'
+    void updateHover(const QPoint& pos);
+    void clearHover();
+    const QVector<double>* columnForSeries(QAbstractSeries* series) const;
+    // Helper to show tooltip (can be called by hover handlers)
+    void showPointTooltip(int dataIndex, const QPoint& globalPos);
 };
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QVector>
+
+#include "PlotDataForDate.h"
+#include "Glob/Trace.h"
+
+class QWidget;
+
+// What a chart window needs from a smile plot, independent of the renderer, so each window can
+// pick one: SmilePlot (Qt Charts scene graph) or RasterSmilePlot (QPainter into a cached QImage).
+// Both emit pointClicked(const SmilePointData&); connect it on the concrete class.
+class SmilePlotView {
+public:
+    // Interaction modes
+    enum PlotMode {
+        pmPan, // Drag to move
+        pmZoom // Drag to zoom region
+    };
+
+    virtual ~SmilePlotView() = default;
+
+    virtual QWidget* widget() = 0;
+
+    virtual PlotMode currentMode() const = 0;
+    // Also applies the mode's cursor and drag behaviour
+    virtual void setCurrentMode(PlotMode mode) = 0;
+    // Timeline of the data passed to the next update; its end-to-end latency is recorded when painted
+    virtual void setTrace(const Trace::Timeline& trace) = 0;
+
+    virtual void updateData(const PlotDataForDate& data) = 0;
+    // Same row layout as the plotted data, only 'changedRows' differ (delta update)
+    virtual void updateRows(const PlotDataForDate& data, const QVector<qsizetype>& changedRows) = 0;
+    virtual void clearPlot() = 0;
+    virtual void resetZoom() = 0;
+};
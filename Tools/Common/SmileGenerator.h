@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDate>
+#include <QRandomGenerator>
+#include <QString>
+#include <QtMath>
+
+// Synthetic smile chains shared by the tools (SmileServer, IngestBench).
+// Same CSV layout as the backend's 'data_compressed' payload.
+namespace SmileGenerator {
+
+    // SSVI total variance w(k) = theta/2 * (1 + rho*phi*k + sqrt((phi*k + rho)^2 + 1 - rho^2))
+    struct SsviParams {
+        double theta = 0.02; // ATM total variance (sigma_atm^2 * T)
+        double rho = -0.4;   // Skew
+        double phi = 1.2;    // Curvature
+        double T = 0.5;      // Years to expiry
+        double spot = 100.0;
+    };
+
+    // Power-law SSVI parameters for one expiry: phi = eta / sqrt(theta), so short expiries get the steeper smiles
+    inline SsviParams ssviForExpiry(double atmVol, double rho, double eta, double T, double spot) {
+        SsviParams params;
+        params.T = qMax(1.0 / 365.0, T);
+        params.theta = atmVol * atmVol * params.T;
+        params.rho = rho;
+        params.phi = eta / qSqrt(params.theta);
+        params.spot = spot;
+        return params;
+    }
+
+    // 'rows' strikes over log-moneyness [-0.5, 0.5], with bid/ask noise around the SSVI curve
+    inline QByteArray generateSmileCsv(const QString& symbol, const QDate& expiry, int rows, const SsviParams& params) {
+        const double theta = params.theta;
+        const double rho = params.rho;
+        const double phi = params.phi;
+        const double T = params.T;
+        const double spot = params.spot;
+
+        QByteArray csv = "snap_shot_dates,log_moneyness,theo_ivs,mid_iv,bid_iv,ask_iv,strikes,symbol,bid_prices,ask_prices\n";
+        csv.reserve(rows * 96 + csv.size());
+        const QString date = expiry.toString(Qt::ISODate);
+        for (int i = 0; i < rows; ++i) {
+            const double k = -0.5 + (rows > 1 ? i / double(rows - 1) : 0.5);
+            const double w = theta / 2.0 * (1.0 + rho * phi * k + qSqrt((phi * k + rho) * (phi * k + rho) + 1.0 - rho * rho));
+            const double theo = qSqrt(w / T);
+            const double noise = 0.002 * (QRandomGenerator::global()->generateDouble() - 0.5);
+            const double mid = theo + noise;
+            const double spread = 0.004 + 0.01 * qAbs(k);
+            const double strike = spot * qExp(k);
+            const double bidPrice = qMax(0.01, 10.0 * mid * qExp(-qAbs(k) * 3.0));
+            const QString optionSymbol = QString("%1%2%3%4").arg(symbol, date)
+                .arg(strike, 0, 'f', 1).arg(k < 0 ? "p" : "c");
+            csv += QString("%1,%2,%3,%4,%5,%6,%7,%8,%9,%10\n")
+                .arg(date)
+                .arg(k, 0, 'f', 6)
+                .arg(theo, 0, 'f', 6)
+                .arg(mid, 0, 'f', 6)
+                .arg(mid - spread / 2, 0, 'f', 6)
+                .arg(mid + spread / 2, 0, 'f', 6)
+                .arg(strike, 0, 'f', 2)
+                .arg(optionSymbol)
+                .arg(bidPrice, 0, 'f', 2)
+                .arg(bidPrice * 1.03, 0, 'f', 2).toUtf8();
+        }
+        return csv;
+    }
+
+    // Fixed skew/curvature, ATM variance jittered by up to 10% per call
+    inline QByteArray generateSmileCsv(const QString& symbol, const QDate& expiry, int rows) {
+        SsviParams params;
+        params.theta = 0.04 * (1.0 + 0.1 * QRandomGenerator::global()->generateDouble());
+        return generateSmileCsv(symbol, expiry, rows, params);
+    }
+
+} // namespace SmileGenerator
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <QtGlobal>
+
+// Process-wide heap allocation counter. The benchmarks read it before and after a measured loop.
+//
+// glibc: malloc, calloc and realloc are interposed, so Qt containers and operator new are both counted.
+// Other runtimes (MSVC): only C++ operator new is replaced; QByteArray/QVector storage (malloc) is not counted.
+namespace AllocCounter {
+
+    // Allocations since process start
+    quint64 count();
+
+    // What count() covers, for the report
+    const char* scope();
+
+} // namespace AllocCounter
@@ -0,0 +1,174 @@
+#include "PipelineBench.h"
+#include "AllocCounter.h"
+#include "Data/SmileCsvParser.h"
+#include "Data/SnapshotStore.h"
+#include "Glob/ProcessStats.h"
+#include "libs/Base64.h"
+#include "libs/CodecRegistry.h"
+#include "libs/Compressor.h"
+#include "Network/MessageEnvelope.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <functional>
+
+namespace PipelineBench {
+
+double Result::nsPerRow() const {
+    const qint64 totalRows = qint64(rows) * messages;
+    return totalRows > 0 ? double(ns) / double(totalRows) : 0.0;
+}
+
+double Result::mbPerSec() const {
+    return ns > 0 ? (double(bytes) / (1024.0 * 1024.0)) / (double(ns) / 1e9) : 0.0;
+}
+
+double Result::allocationsPerMessage() const {
+    return messages > 0 ? double(allocations) / double(messages) : 0.0;
+}
+
+QJsonObject Result::toJson() const {
+    QJsonObject json;
+    json["stage"] = stage;
+    json["source"] = source;
+    json["rows"] = rows;
+    json["messages"] = messages;
+    json["bytes"] = bytes;
+    json["ns"] = ns;
+    json["ns_per_row"] = nsPerRow();
+    json["mb_per_s"] = mbPerSec();
+    json["allocs_per_msg"] = allocationsPerMessage();
+    json["peak_rss_bytes"] = peakRssBytes;
+    json["ok"] = ok;
+    return json;
+}
+
+QString Result::key() const {
+    return QString("%1/%2/%3").arg(stage, source).arg(rows);
+}
+
+namespace {
+
+    // Inputs of every stage, built once per chain
+    struct Message {
+        QString symbol;
+        QByteArray csv;
+        QByteArray compressed;
+        QString base64;
+        QString text;          // Whole 'data_stream' JSON message
+        qint64 textBytes = 0;  // UTF-8 size, as received on the socket
+        PlotDataForDate parsed;
+        QDate date;
+        int rows = 0;
+    };
+
+    // Runs 'body' for message 0..messages-1 and fills timing, allocation and RSS fields
+    Result measure(const QString& stage, const QString& source, int rows, int messages,
+        const std::function<bool(int)>& body, const std::function<qint64(int)>& inputBytes) {
+        Result result;
+        result.stage = stage;
+        result.source = source;
+        result.rows = rows;
+        result.messages = messages;
+        for (int i = 0; i < messages; ++i) {
+            result.bytes += inputBytes(i);
+        }
+
+        QElapsedTimer timer;
+        const quint64 allocationsBefore = AllocCounter::count();
+        timer.start();
+        for (int i = 0; i < messages; ++i) {
+            if (!body(i)) result.ok = false;
+        }
+        result.ns = timer.nsecsElapsed();
+        result.allocations = AllocCounter::count() - allocationsBefore;
+        result.peakRssBytes = ProcessStats::peakResidentBytes();
+        return result;
+    }
+
+} // namespace
+
+QList<Result> run(const QList<QByteArray>& chains, const QString& source, int messages) {
+    QList<Result> results;
+    if (chains.isEmpty() || messages < 1) return results;
+
+    QList<Message> inputs;
+    qint64 totalRows = 0;
+    for (int c = 0; c < chains.size(); ++c) {
+        Message message;
+        message.symbol = QString("SYM%1").arg(c);
+        message.csv = chains[c];
+        message.compressed = Compressor::compressZlib(message.csv);
+        message.base64 = QString::fromLatin1(message.compressed.toBase64());
+        message.text = QString("{\"type\":\"data_stream\",\"symbol\":\"%1\",\"model\":\"bench\",\"data_compressed\":\"%2\"}")
+            .arg(message.symbol, message.base64);
+        message.textBytes = message.text.toUtf8().size();
+        if (!SmileCsvParser::parse(message.csv, message.date, message.parsed)) {
+            qWarning() << "Chain" << c << "does not parse, skipped.";
+            continue;
+        }
+        message.rows = int(message.parsed.size());
+        totalRows += message.rows;
+        inputs.append(message);
+    }
+    if (inputs.isEmpty()) return results;
+
+    const int rows = int(totalRows / inputs.size());
+    auto at = [&inputs](int i) -> const Message& { return inputs[i % inputs.size()]; };
+    auto csvBytes = [&at](int i) { return qint64(at(i).csv.size()); };
+
+    results.append(measure("compress_zlib", source, rows, messages,
+        [&at](int i) { return !Compressor::compressZlib(at(i).csv).isEmpty(); }, csvBytes));
+
+    results.append(measure("decompress_zlib", source, rows, messages,
+        [&at](int i) { return Compressor::decompressZlib(at(i).compressed).size() == at(i).csv.size(); }, csvBytes));
+
+    QByteArray buffer;
+    results.append(measure("base64_decode", source, rows, messages,
+        [&at, &buffer](int i) { return Base64::decode(at(i).base64, buffer) && buffer.size() == at(i).compressed.size(); },
+        [&at](int i) { return qint64(at(i).base64.size()); }));
+
+    results.append(measure("envelope", source, rows, messages,
+        [&at](int i) {
+            MessageEnvelope envelope;
+            return MessageEnvelope::parse(at(i).text, envelope) && envelope.payload.size() == at(i).compressed.size();
+        },
+        [&at](int i) { return at(i).textBytes; }));
+
+    results.append(measure("parse", source, rows, messages,
+        [&at](int i) {
+            PlotDataForDate data;
+            QDate date;
+            return SmileCsvParser::parse(at(i).csv, date, data) && data.size() == at(i).rows;
+        }, csvBytes));
+
+    // Shallow copies of the parsed chains stand in for freshly parsed data: moving them in costs the same
+    SnapshotStore publishStore;
+    results.append(measure("publish", source, rows, messages,
+        [&at, &publishStore](int i) {
+            const Message& message = at(i);
+            PlotDataForDate data = message.parsed;
+            return !publishStore.publish(message.symbol, "bench", message.date, std::move(data)).isNull();
+        }, csvBytes));
+
+    SnapshotStore endToEndStore;
+    results.append(measure("end_to_end", source, rows, messages,
+        [&at, &endToEndStore](int i) {
+            MessageEnvelope envelope;
+            if (!MessageEnvelope::parse(at(i).text, envelope)) return false;
+            PlotDataForDate data;
+            QDate date;
+            SmileCsvParser parser(data);
+            const bool inflated = Compressor::CodecRegistry::instance().decompress(Compressor::Codec::Zlib,
+                envelope.payload.constData(), envelope.payload.size(), 0,
+                [&parser](const char* chunk, qsizetype size) { return parser.feed(chunk, size); });
+            if (!inflated || !parser.finish(date)) return false;
+            return !endToEndStore.publish(envelope.symbol, envelope.model, date, std::move(data)).isNull();
+        },
+        [&at](int i) { return at(i).textBytes; }));
+
+    return results;
+}
+
+} // namespace PipelineBench
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+// Pipeline suite: times each hot-path stage of a 'data_stream' message on its own, then the whole
+// worker path, over one set of chains (all with about the same row count):
+//
+//   compress_zlib    Compressor::compressZlib of the CSV (the backend's side, for reference)
+//   decompress_zlib  Compressor::decompressZlib into one QByteArray
+//   base64_decode    Base64::decode of 'data_compressed' from the message QString
+//   envelope         MessageEnvelope::parse of the whole JSON message (scan + base64)
+//   parse            SmileCsvParser::parse of the CSV
+//   publish          SnapshotStore::publish (snapshot build + SmileDelta::buildIndex + store), as in ClientReceiver
+//   end_to_end       envelope, streaming inflate into the parser, publish (ClientReceiver::decodeDataStream)
+//
+// Every stage processes 'messages' messages, cycling through the chains. Inputs of a stage are
+// prepared outside its timed loop.
+namespace PipelineBench {
+
+    struct Result {
+        QString stage;
+        QString source;        // "synthetic" or "recorded"
+        int rows = 0;          // Average rows per message
+        int messages = 0;
+        qint64 bytes = 0;      // Input bytes of the stage over all messages (CSV, compressed, base64 or message)
+        qint64 ns = 0;
+        quint64 allocations = 0;
+        qint64 peakRssBytes = 0; // Process peak RSS after the stage
+        bool ok = true;
+
+        double nsPerRow() const;
+        double mbPerSec() const;
+        double allocationsPerMessage() const;
+
+        QJsonObject toJson() const;
+        // "stage/source/rows": the identity a baseline result is matched on
+        QString key() const;
+    };
+
+    QList<Result> run(const QList<QByteArray>& chains, const QString& source, int messages);
+
+} // namespace PipelineBench
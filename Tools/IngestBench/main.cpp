@@ -0,0 +1,468 @@
+// IngestBench: headless benchmark of the smile ingest path.
+//
+// Codec benchmark: compresses every chain with each compiled-in codec (zlib, zstd, LZ4; with
+// and without a trained dictionary) and reports ratio, compress/decode MB/s and decode+parse
+// MB/s (decode feeding SmileCsvParser, as ClientReceiver does). Chains are recorded CSV files
+// (positional arguments, files or directories) or generated ones.
+//
+// Base64 benchmark: decodes the base64 of the zlib-compressed chains (the 'data_compressed'
+// field) with QByteArray::fromBase64 and with Base64::decode from the QString and from UTF-8.
+//
+// Pipeline suite (--suite, see PipelineBench.h): ns/row, MB/s, allocations per message and peak
+// RSS of every hot-path stage over generated chains of each --suite-rows size, plus the recorded
+// chains when given. --json writes the results; --baseline compares them with an earlier --json
+// file and exits with 2 when a stage got slower by more than --max-regression percent.
+//
+// Recorded chains are CSV files, or FeedCapture files (*.cap, from DataAlpha --record) whose
+// zlib 'data_stream' snapshots are extracted.
+//
+// Usage: IngestBench [--iterations 20] [--chains 16] [--rows 2000] [--dicts dir]
+//                    [--train-dict zstd-1.dict] [--dict-size 65536] [chain.csv|capture.cap|dir ...]
+//        IngestBench --suite [--suite-rows 1000,10000,100000] [--suite-total-rows 1000000]
+//                    [--json results.json] [--baseline previous.json] [--max-regression 10] [chain.csv|capture.cap|dir ...]
+
+#include "AllocCounter.h"
+#include "PipelineBench.h"
+#include "Data/SmileCsvParser.h"
+#include "Glob/ProcessStats.h"
+#include "libs/Base64.h"
+#include "libs/Compressor.h"
+#include "libs/CodecRegistry.h"
+#include "Network/FeedCapture.h"
+#include "Network/MessageEnvelope.h"
+#include "Tools/Common/SmileGenerator.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSysInfo>
+#include <QTextStream>
+
+#if DA_HAVE_ZSTD
+#include <zdict.h>
+#endif
+
+namespace {
+
+    QTextStream& out() {
+        static QTextStream stream(stdout);
+        return stream;
+    }
+
+    // Full zlib 'data_stream' snapshots of a capture, inflated back to CSV (binary frames and deltas are skipped)
+    void loadCapture(const QString& fileName, QList<QByteArray>& chains) {
+        FeedCapture::Reader reader;
+        if (!reader.open(fileName)) {
+            qWarning() << "Cannot open capture:" << fileName;
+            return;
+        }
+        FeedCapture::Record record;
+        while (reader.next(record)) {
+            if (record.kind != FeedCapture::Kind::Text) continue;
+            MessageEnvelope envelope;
+            if (!MessageEnvelope::parse(QString::fromUtf8(record.payload), envelope)) continue;
+            if (envelope.type != "data_stream" || envelope.mode == "delta" || !envelope.hasPayload) continue;
+            if (!envelope.codec.isEmpty() && envelope.codec != "zlib") continue;
+            const QByteArray csv = Compressor::decompressZlib(envelope.payload);
+            if (!csv.isEmpty()) chains.append(csv);
+        }
+    }
+
+    QList<QByteArray> loadChains(const QStringList& paths) {
+        QList<QByteArray> chains;
+        for (const QString& path : paths) {
+            QStringList files;
+            if (QFileInfo(path).isDir()) {
+                QDir dir(path);
+                for (const QString& name : dir.entryList({ "*.csv", "*.cap" }, QDir::Files, QDir::Name)) {
+                    files.append(dir.filePath(name));
+                }
+            }
+            else {
+                files.append(path);
+            }
+            for (const QString& fileName : files) {
+                if (fileName.endsWith(".cap", Qt::CaseInsensitive)) {
+                    loadCapture(fileName, chains);
+                    continue;
+                }
+                QFile file(fileName);
+                if (!file.open(QIODevice::ReadOnly)) {
+                    qWarning() << "Cannot open chain:" << fileName;
+                    continue;
+                }
+                chains.append(file.readAll());
+            }
+        }
+        return chains;
+    }
+
+    QList<QByteArray> generateChains(int count, int rows) {
+        static const QStringList symbols = { "AAPL", "MSFT", "NVDA", "AMZN", "META", "TSLA", "SPY", "QQQ" };
+        QList<QByteArray> chains;
+        const QDate expiry = QDate::currentDate().addMonths(1);
+        for (int i = 0; i < count; ++i) {
+            chains.append(SmileGenerator::generateSmileCsv(symbols[i % symbols.size()], expiry.addDays(7 * (i / symbols.size())), rows));
+        }
+        return chains;
+    }
+
+    double mbPerSec(qint64 bytes, qint64 nsecs) {
+        return nsecs > 0 ? (double(bytes) / (1024.0 * 1024.0)) / (double(nsecs) / 1e9) : 0.0;
+    }
+
+    struct CodecResult {
+        qint64 rawBytes = 0;
+        qint64 compressedBytes = 0;
+        qint64 compressNs = 0;
+        qint64 decodeNs = 0;
+        qint64 decodeParseNs = 0;
+        bool ok = true;
+    };
+
+    CodecResult benchCodec(Compressor::Codec codec, quint32 dictId, const QList<QByteArray>& chains, int iterations) {
+        Compressor::CodecRegistry& registry = Compressor::CodecRegistry::instance();
+        CodecResult result;
+        QElapsedTimer timer;
+
+        QList<QByteArray> compressed;
+        timer.start();
+        for (const QByteArray& chain : chains) {
+            compressed.append(registry.compress(codec, chain, -1, dictId));
+        }
+        result.compressNs = timer.nsecsElapsed();
+
+        for (int i = 0; i < chains.size(); ++i) {
+            result.rawBytes += chains[i].size();
+            result.compressedBytes += compressed[i].size();
+            if (compressed[i].isEmpty()) result.ok = false;
+        }
+        if (!result.ok) return result;
+
+        // Decode only (whole payload into the pooled buffer)
+        timer.restart();
+        for (int it = 0; it < iterations; ++it) {
+            for (const QByteArray& payload : compressed) {
+                QByteArray raw = registry.decompress(codec, payload.constData(), payload.size(), dictId);
+                if (raw.isNull()) result.ok = false;
+            }
+        }
+        result.decodeNs = timer.nsecsElapsed();
+
+        // Decode + parse, the way ClientReceiver consumes a data_stream message
+        timer.restart();
+        for (int it = 0; it < iterations; ++it) {
+            for (const QByteArray& payload : compressed) {
+                PlotDataForDate data;
+                QDate date;
+                SmileCsvParser parser(data);
+                const bool decoded = registry.decompress(codec, payload.constData(), payload.size(), dictId,
+                    [&parser](const char* chunk, qsizetype size) { return parser.feed(chunk, size); });
+                if (!decoded || !parser.finish(date)) result.ok = false;
+            }
+        }
+        result.decodeParseNs = timer.nsecsElapsed();
+        return result;
+    }
+
+    struct Base64Result {
+        qint64 encodedBytes = 0;
+        qint64 fromBase64Ns = 0;
+        qint64 decodeStringNs = 0;
+        qint64 decodeUtf8Ns = 0;
+        bool ok = true;
+    };
+
+    Base64Result benchBase64(const QList<QByteArray>& chains, int iterations) {
+        Compressor::CodecRegistry& registry = Compressor::CodecRegistry::instance();
+        Base64Result result;
+        QList<QByteArray> expected;
+        QList<QByteArray> utf8;
+        QList<QString> strings;
+        for (const QByteArray& chain : chains) {
+            expected.append(registry.compress(Compressor::Codec::Zlib, chain));
+            utf8.append(expected.last().toBase64());
+            strings.append(QString::fromLatin1(utf8.last()));
+            result.encodedBytes += utf8.last().size();
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int it = 0; it < iterations; ++it) {
+            for (int i = 0; i < strings.size(); ++i) {
+                // What ClientReceiver did before: Latin-1 copy, then decode
+                const QByteArray decoded = QByteArray::fromBase64(strings[i].toLatin1());
+                if (decoded.size() != expected[i].size()) result.ok = false;
+            }
+        }
+        result.fromBase64Ns = timer.nsecsElapsed();
+
+        QByteArray buffer;
+        timer.restart();
+        for (int it = 0; it < iterations; ++it) {
+            for (int i = 0; i < strings.size(); ++i) {
+                if (!Base64::decode(strings[i], buffer) || buffer != expected[i]) result.ok = false;
+            }
+        }
+        result.decodeStringNs = timer.nsecsElapsed();
+
+        timer.restart();
+        for (int it = 0; it < iterations; ++it) {
+            for (int i = 0; i < utf8.size(); ++i) {
+                if (!Base64::decode(utf8[i].constData(), utf8[i].size(), buffer) || buffer != expected[i]) result.ok = false;
+            }
+        }
+        result.decodeUtf8Ns = timer.nsecsElapsed();
+        return result;
+    }
+
+    bool trainDictionary(const QList<QByteArray>& chains, const QString& fileName, int dictSize) {
+#if DA_HAVE_ZSTD
+        QByteArray samples;
+        QVector<size_t> sampleSizes;
+        for (const QByteArray& chain : chains) {
+            samples.append(chain);
+            sampleSizes.append(size_t(chain.size()));
+        }
+        QByteArray dictionary(dictSize, Qt::Uninitialized);
+        const size_t size = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(),
+            samples.constData(), sampleSizes.constData(), unsigned(sampleSizes.size()));
+        if (ZDICT_isError(size)) {
+            qCritical() << "Dictionary training failed:" << ZDICT_getErrorName(size)
+                << "(more or smaller samples may be needed)";
+            return false;
+        }
+        dictionary.resize(qsizetype(size));
+
+        QFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly) || file.write(dictionary) != dictionary.size()) {
+            qCritical() << "Cannot write dictionary:" << fileName;
+            return false;
+        }
+        out() << "Trained " << size << " byte zstd dictionary from " << chains.size() << " chains -> " << fileName << Qt::endl;
+        return true;
+#else
+        Q_UNUSED(chains); Q_UNUSED(fileName); Q_UNUSED(dictSize);
+        qCritical() << "Dictionary training needs zstd (DA_HAVE_ZSTD).";
+        return false;
+#endif
+    }
+
+    void printSuiteResult(const PipelineBench::Result& r) {
+        out() << QString("%1 %2 %3 %4 %5 %6 %7 %8%9")
+            .arg(r.stage, -16).arg(r.source, -10).arg(r.rows, 7).arg(r.messages, 6)
+            .arg(r.nsPerRow(), 10, 'f', 1)
+            .arg(r.mbPerSec(), 10, 'f', 1)
+            .arg(r.allocationsPerMessage(), 12, 'f', 1)
+            .arg(double(r.peakRssBytes) / (1024.0 * 1024.0), 10, 'f', 1)
+            .arg(r.ok ? "" : "  FAILED") << Qt::endl;
+    }
+
+    bool writeSuiteJson(const QString& fileName, const QList<PipelineBench::Result>& results) {
+        QJsonArray array;
+        for (const PipelineBench::Result& r : results) {
+            array.append(r.toJson());
+        }
+        QJsonObject root;
+        root["tool"] = "IngestBench";
+        root["format"] = 1;
+        root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        root["host"] = QSysInfo::machineHostName();
+        root["cpu_arch"] = QSysInfo::currentCpuArchitecture();
+        root["base64"] = Base64::implementationName();
+        root["alloc_scope"] = AllocCounter::scope();
+        root["peak_rss_bytes"] = ProcessStats::peakResidentBytes();
+        root["results"] = array;
+
+        QFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical() << "Cannot write results:" << fileName;
+            return false;
+        }
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+        return true;
+    }
+
+    // Stages whose ns/row grew by more than 'maxRegressionPct' over the baseline file. -1 if it cannot be read.
+    int compareWithBaseline(const QString& fileName, const QList<PipelineBench::Result>& results, double maxRegressionPct) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "Cannot open baseline:" << fileName;
+            return -1;
+        }
+        const QJsonArray baseline = QJsonDocument::fromJson(file.readAll()).object().value("results").toArray();
+        QHash<QString, double> baselineNsPerRow;
+        for (const QJsonValue& value : baseline) {
+            const QJsonObject entry = value.toObject();
+            const QString key = QString("%1/%2/%3").arg(entry.value("stage").toString(), entry.value("source").toString())
+                .arg(entry.value("rows").toInt());
+            baselineNsPerRow.insert(key, entry.value("ns_per_row").toDouble());
+        }
+
+        int regressions = 0;
+        out() << Qt::endl << "Baseline " << fileName << " (max regression " << maxRegressionPct << "%)" << Qt::endl;
+        for (const PipelineBench::Result& r : results) {
+            const double before = baselineNsPerRow.value(r.key(), 0.0);
+            if (before <= 0.0) continue; // New stage or size: nothing to compare with
+            const double changePct = (r.nsPerRow() - before) / before * 100.0;
+            const bool regressed = changePct > maxRegressionPct;
+            if (regressed) ++regressions;
+            out() << QString("%1 %2 -> %3 ns/row %4%5%")
+                .arg(r.key(), -34).arg(before, 9, 'f', 1).arg(r.nsPerRow(), 9, 'f', 1)
+                .arg(changePct >= 0 ? "+" : "").arg(changePct, 0, 'f', 1)
+                << (regressed ? "  REGRESSION" : "") << Qt::endl;
+        }
+        return regressions;
+    }
+
+    int runSuite(const QCommandLineParser& parser, const QList<QByteArray>& recorded) {
+        const qint64 totalRows = qMax<qint64>(1, parser.value("suite-total-rows").toLongLong());
+        const int chainCount = qMax(1, parser.value("chains").toInt());
+        QList<PipelineBench::Result> results;
+
+        out() << "Allocations counted: " << AllocCounter::scope() << Qt::endl;
+        out() << QString("%1 %2 %3 %4 %5 %6 %7 %8")
+            .arg("stage", -16).arg("source", -10).arg("rows", 7).arg("msgs", 6)
+            .arg("ns/row", 10).arg("MB/s", 10).arg("allocs/msg", 12).arg("peak MB", 10) << Qt::endl;
+
+        // Enough messages for about 'totalRows' rows per stage, at least 3 so one slow call does not dominate
+        auto messagesFor = [totalRows](int rows) {
+            return int(qBound<qint64>(3, totalRows / qMax(1, rows), 10000));
+        };
+
+        for (const QString& value : parser.value("suite-rows").split(',', Qt::SkipEmptyParts)) {
+            const int rows = value.trimmed().toInt();
+            if (rows < 1) continue;
+            const int messages = messagesFor(rows);
+            const QList<QByteArray> chains = generateChains(qMin(chainCount, messages), rows);
+            for (const PipelineBench::Result& r : PipelineBench::run(chains, "synthetic", messages)) {
+                printSuiteResult(r);
+                results.append(r);
+            }
+        }
+
+        if (!recorded.isEmpty()) {
+            qint64 bytes = 0;
+            for (const QByteArray& chain : recorded) bytes += chain.size();
+            // Row count is only known after parsing: size the run from the average CSV bytes per row instead
+            const int approxRows = int(qMax<qint64>(1, bytes / recorded.size() / 96));
+            for (const PipelineBench::Result& r : PipelineBench::run(recorded, "recorded", qMax(int(recorded.size()), messagesFor(approxRows)))) {
+                printSuiteResult(r);
+                results.append(r);
+            }
+        }
+
+        bool ok = !results.isEmpty();
+        for (const PipelineBench::Result& r : results) {
+            if (!r.ok) ok = false;
+        }
+        out() << "Peak RSS: " << QString::number(double(ProcessStats::peakResidentBytes()) / (1024.0 * 1024.0), 'f', 1)
+            << " MB" << Qt::endl;
+
+        if (parser.isSet("json") && !writeSuiteJson(parser.value("json"), results)) {
+            ok = false;
+        }
+        if (parser.isSet("baseline")) {
+            const int regressions = compareWithBaseline(parser.value("baseline"), results, parser.value("max-regression").toDouble());
+            if (regressions < 0) return 1;
+            if (regressions > 0) {
+                out() << regressions << " stage(s) regressed" << Qt::endl;
+                return 2;
+            }
+        }
+        return ok ? 0 : 1;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("IngestBench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless benchmark of the smile ingest path (codecs, decode, parse, publish).");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "iterations", "Decode passes over all chains.", "count", "20" },
+        { "chains", "Generated chains when no CSV is given.", "count", "16" },
+        { "rows", "Rows per generated chain.", "count", "2000" },
+        { "dicts", "Directory of trained dictionaries (<codec>-<id>.dict).", "dir" },
+        { "train-dict", "Train a zstd dictionary from the chains and write it to this file.", "file" },
+        { "dict-size", "Size of the trained dictionary in bytes.", "bytes", "65536" },
+        { "suite", "Run the pipeline suite (stage ns/row, MB/s, allocations, peak RSS) instead of the codec benchmark." },
+        { "suite-rows", "Comma-separated rows per generated chain for the suite.", "rows", "1000,10000,100000" },
+        { "suite-total-rows", "Rows each suite stage processes per chain size (sets the message count).", "rows", "1000000" },
+        { "json", "Write the suite results to this file as JSON.", "file" },
+        { "baseline", "Compare the suite results with this earlier --json file; exit code 2 on regression.", "file" },
+        { "max-regression", "Allowed ns/row increase over the baseline, in percent.", "percent", "10" },
+    });
+    parser.addPositionalArgument("chains", "Recorded chain CSV files, capture files (.cap) or directories.", "[chain.csv|capture.cap|dir ...]");
+    parser.process(app);
+
+    const int iterations = qMax(1, parser.value("iterations").toInt());
+    QList<QByteArray> chains = loadChains(parser.positionalArguments());
+    if (parser.isSet("suite")) {
+        if (!chains.isEmpty()) out() << "Using " << chains.size() << " recorded chains" << Qt::endl;
+        return runSuite(parser, chains);
+    }
+    if (chains.isEmpty()) {
+        chains = generateChains(qMax(1, parser.value("chains").toInt()), qMax(1, parser.value("rows").toInt()));
+        out() << "Using " << chains.size() << " generated chains" << Qt::endl;
+    }
+    else {
+        out() << "Using " << chains.size() << " recorded chains" << Qt::endl;
+    }
+
+    if (parser.isSet("train-dict")) {
+        return trainDictionary(chains, parser.value("train-dict"), qMax(1024, parser.value("dict-size").toInt())) ? 0 : 1;
+    }
+    if (parser.isSet("dicts")) {
+        Compressor::CodecRegistry::instance().loadDictionaries(parser.value("dicts"));
+    }
+
+    // Throughputs are MB/s of raw (uncompressed) CSV
+    out() << QString("%1 %2 %3 %4 %5")
+        .arg("codec", -12).arg("ratio", 8).arg("comp MB/s", 11).arg("dec MB/s", 11).arg("parse MB/s", 11) << Qt::endl;
+
+    for (Compressor::Codec codec : { Compressor::Codec::Zlib, Compressor::Codec::Zstd, Compressor::Codec::Lz4 }) {
+        if (!Compressor::isCodecAvailable(codec)) {
+            out() << QString("%1 not compiled in").arg(Compressor::codecName(codec), -12) << Qt::endl;
+            continue;
+        }
+
+        QList<quint32> dictIds = { 0 };
+        dictIds += Compressor::CodecRegistry::instance().dictionaryIds(codec);
+        for (quint32 dictId : dictIds) {
+            const CodecResult r = benchCodec(codec, dictId, chains, iterations);
+            const QString name = Compressor::codecName(codec) + (dictId ? QString("+d%1").arg(dictId) : QString());
+            if (!r.ok) {
+                out() << QString("%1 FAILED").arg(name, -12) << Qt::endl;
+                continue;
+            }
+            const qint64 decodedBytes = r.rawBytes * iterations;
+            out() << QString("%1 %2 %3 %4 %5")
+                .arg(name, -12)
+                .arg(double(r.rawBytes) / double(qMax<qint64>(1, r.compressedBytes)), 8, 'f', 2)
+                .arg(mbPerSec(r.rawBytes, r.compressNs), 11, 'f', 1)
+                .arg(mbPerSec(decodedBytes, r.decodeNs), 11, 'f', 1)
+                .arg(mbPerSec(decodedBytes, r.decodeParseNs), 11, 'f', 1) << Qt::endl;
+        }
+    }
+
+    // Throughputs are MB/s of base64 text
+    const Base64Result b64 = benchBase64(chains, iterations);
+    const qint64 encodedBytes = b64.encodedBytes * iterations;
+    out() << Qt::endl << "base64 (" << Base64::implementationName() << ")"
+        << (b64.ok ? "" : " MISMATCH") << Qt::endl;
+    out() << QString("%1 %2").arg("fromBase64", -22).arg(mbPerSec(encodedBytes, b64.fromBase64Ns), 11, 'f', 1) << Qt::endl;
+    out() << QString("%1 %2").arg("Base64::decode QString", -22).arg(mbPerSec(encodedBytes, b64.decodeStringNs), 11, 'f', 1) << Qt::endl;
+    out() << QString("%1 %2").arg("Base64::decode UTF-8", -22).arg(mbPerSec(encodedBytes, b64.decodeUtf8Ns), 11, 'f', 1) << Qt::endl;
+    return b64.ok ? 0 : 1;
+}
@@ -0,0 +1,451 @@
+// SmileServer: local stand-in for the data server, and load generator.
+//
+// Streams synthetic SSVI smiles (or a CSV file) for N symbols x M expiries x K strikes to every
+// connected client, either as the legacy JSON "data_stream" message (base64 zlib CSV) or as binary
+// columnar frames ("smile-bin-v1", see Network/SmileWireFormat.h). The format of each client is
+// agreed through the "hello" handshake, so old and new clients can be tested side by side.
+//
+// JSON payloads are compressed with the best codec both sides support (zstd > lz4 > zlib,
+// see libs/CodecRegistry.h), with a trained dictionary when the client holds the same one.
+//
+// Speaks the subscription protocol of WebSocketClient: "symbol" requests (add, remove, update,
+// snapshot) are answered with "symbol_response" acks, and each client only receives the streams
+// it is subscribed to (every --symbols stream unless --no-broadcast).
+//
+// Robustness and scaling: --burst-every/--burst-size send extra ticks back-to-back, --drop-every
+// aborts every connection (clients reconnect), --malformed replaces a share of the messages with
+// broken ones (truncated JSON, bad base64, corrupt payload, unknown type, bad binary frame).
+// Clients that do not keep up are skipped (--max-backlog) instead of growing the send buffer.
+//
+// Usage: SmileServer [--port 8765] [--interval 1000] [--symbols AAPL,MSFT | --symbol-count 50]
+//                    [--expiries 1] [--rows 200] [--model SSVI] [--csv smile.csv]
+//                    [--format auto|json|binary] [--codec auto|zlib|zstd|lz4] [--dicts dir]
+//                    [--no-broadcast] [--burst-every 0] [--burst-size 10] [--drop-every 0]
+//                    [--malformed 0] [--max-backlog 64] [--stats 5]
+
+#include "Data/SmileCsvParser.h"
+#include "Network/SmileWireFormat.h"
+#include "libs/Compressor.h"
+#include "libs/CodecRegistry.h"
+#include "Tools/Common/SmileGenerator.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QWebSocketServer>
+#include <QWebSocket>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTimer>
+#include <QHash>
+#include <QSet>
+#include <QRandomGenerator>
+
+namespace {
+
+    struct ClientState {
+        QString format = SmileWire::FormatJsonCsv; // Until the client says hello
+        Compressor::Codec codec = Compressor::Codec::Zlib;
+        quint32 dictId = 0;
+        QSet<QString> subscriptions; // symbol_model
+        QHash<QString, quint64> sequences; // Binary frame sequence per symbol_model
+    };
+
+    // One symbol of the universe: its SSVI shape drifts a little every tick
+    struct SymbolState {
+        QString name;
+        double spot = 100.0;
+        double atmVol = 0.25;
+        double rho = -0.4;
+        double eta = 1.0;
+    };
+
+    struct SendStats {
+        quint64 messages = 0;
+        quint64 bytes = 0;
+        quint64 malformed = 0;
+        quint64 skipped = 0; // Client send buffer over --max-backlog
+    };
+
+    QString streamKey(const QString& symbol, const QString& model) {
+        return symbol + "_" + model;
+    }
+
+    // First codec of the client's preference list that we have too (or the forced one if the client has it)
+    void negotiateCodec(const QJsonObject& hello, const QString& forcedCodec, ClientState& state) {
+        state.codec = Compressor::Codec::Zlib;
+        state.dictId = 0;
+
+        const QJsonArray offered = hello.value("codecs").toArray();
+        for (const QJsonValue& value : offered) {
+            Compressor::Codec codec;
+            if (!Compressor::codecFromName(value.toString(), codec) || !Compressor::isCodecAvailable(codec)) continue;
+            if (forcedCodec != "auto" && Compressor::codecName(codec) != forcedCodec) continue;
+            state.codec = codec;
+            break;
+        }
+
+        // Highest dictionary id both sides hold
+        const QJsonArray clientDicts = hello.value("dicts").toObject().value(Compressor::codecName(state.codec)).toArray();
+        for (const QJsonValue& value : clientDicts) {
+            const quint32 id = static_cast<quint32>(value.toInteger());
+            if (id > state.dictId && Compressor::CodecRegistry::instance().hasDictionary(state.codec, id)) {
+                state.dictId = id;
+            }
+        }
+    }
+
+    // Same shape as the messages produced by the production server
+    // 'expiry' lets the client coalesce pending snapshots per expiration date (omitted when unknown)
+    QByteArray jsonMessage(const QString& symbol, const QString& model, const QDate& expiry, const QByteArray& csv,
+        Compressor::Codec codec, quint32 dictId) {
+        QJsonObject message;
+        message["type"] = "data_stream";
+        message["symbol"] = symbol;
+        message["model"] = model;
+        if (expiry.isValid()) message["date"] = expiry.toString(Qt::ISODate);
+        message["metrics"] = QJsonObject{ {"load_time", QDateTime::currentMSecsSinceEpoch()} };
+        if (codec != Compressor::Codec::Zlib) message["codec"] = Compressor::codecName(codec); // zlib is implied
+        if (dictId != 0) message["dict"] = qint64(dictId);
+        const QByteArray compressed = Compressor::CodecRegistry::instance().compress(codec, csv, -1, dictId);
+        message["data_compressed"] = QString::fromLatin1(compressed.toBase64());
+        return QJsonDocument(message).toJson(QJsonDocument::Compact);
+    }
+
+    QByteArray symbolResponse(const QString& action, const QString& symbol, const QString& model,
+        bool success, const QString& error = QString()) {
+        QJsonObject message;
+        message["type"] = "symbol_response";
+        message["action"] = action;
+        message["success"] = success;
+        if (!error.isEmpty()) message["error"] = error;
+        message["data"] = QJsonObject{ {"symbol_name", symbol}, {"model_name", model} };
+        return QJsonDocument(message).toJson(QJsonDocument::Compact);
+    }
+
+    // A broken variant of a valid message, cycling through the failure modes the client must survive
+    QByteArray malformedJson(const QByteArray& valid, const QString& symbol, const QString& model, quint64 counter) {
+        switch (counter % 5) {
+        case 0: // Truncated JSON
+            return valid.left(valid.size() / 2);
+        case 1: { // Invalid base64
+            QByteArray broken = valid;
+            const qsizetype at = broken.indexOf("\"data_compressed\":\"");
+            if (at >= 0 && at + 25 < broken.size()) broken[at + 22] = '$';
+            return broken;
+        }
+        case 2: { // Valid base64 of a corrupt payload
+            QJsonObject message = QJsonDocument::fromJson(valid).object();
+            message["data_compressed"] = QString::fromLatin1(QByteArray("not a compressed stream").toBase64());
+            return QJsonDocument(message).toJson(QJsonDocument::Compact);
+        }
+        case 3: // Unknown type
+            return QJsonDocument(QJsonObject{ {"type", "unknown_stream"}, {"symbol", symbol}, {"model", model} })
+                .toJson(QJsonDocument::Compact);
+        default: { // Missing symbol
+            QJsonObject message = QJsonDocument::fromJson(valid).object();
+            message.remove("symbol");
+            return QJsonDocument(message).toJson(QJsonDocument::Compact);
+        }
+        }
+    }
+
+    QByteArray malformedFrame(const QByteArray& valid, quint64 counter) {
+        if (counter % 2 == 0) return valid.left(qMax<qsizetype>(4, valid.size() / 3)); // Truncated
+        QByteArray broken = valid;
+        if (broken.size() > SmileWire::HeaderSize + 16) broken[broken.size() - 8] ^= 0x5A; // Corrupt body (zlib stream)
+        return broken;
+    }
+
+    bool parseFrame(const QString& symbol, const QString& model, const QByteArray& csv, SmileWire::Frame& frame) {
+        frame.symbol = symbol;
+        frame.model = model;
+        return SmileCsvParser::parse(csv, frame.date, frame.data);
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("SmileServer");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Local stand-in server and load generator streaming smiles as JSON/CSV or binary frames.");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "port", "Listen port.", "port", "8765" },
+        { "interval", "Publish interval in ms (one message per stream and expiry per tick).", "ms", "1000" },
+        { "symbols", "Comma separated symbols.", "list", "AAPL" },
+        { "symbol-count", "Generate this many symbols (SYM0000...) instead of --symbols.", "count" },
+        { "expiries", "Expiries per symbol (monthly).", "count", "1" },
+        { "model", "Model name.", "name", "SSVI" },
+        { "rows", "Strikes per generated smile.", "count", "200" },
+        { "csv", "Send this CSV file instead of generated smiles.", "file" },
+        { "format", "auto (negotiated), json or binary.", "format", "auto" },
+        { "codec", "JSON payload codec: auto (negotiated), zlib, zstd or lz4.", "codec", "auto" },
+        { "dicts", "Directory of trained dictionaries (<codec>-<id>.dict).", "dir" },
+        { "no-broadcast", "Only stream what a client subscribed to with 'symbol' add requests." },
+        { "burst-every", "Every N seconds send --burst-size ticks back-to-back (0 = off).", "s", "0" },
+        { "burst-size", "Ticks per burst.", "count", "10" },
+        { "drop-every", "Every N seconds abort all client connections (0 = off).", "s", "0" },
+        { "malformed", "Share of messages replaced by malformed ones (0..1).", "ratio", "0" },
+        { "max-backlog", "Skip a client while more than this many MB wait in its send buffer.", "MB", "64" },
+        { "stats", "Print send statistics every N seconds (0 = off).", "s", "5" },
+    });
+    parser.process(app);
+
+    const quint16 port = parser.value("port").toUShort();
+    const int intervalMs = qMax(1, parser.value("interval").toInt());
+    const QString model = parser.value("model");
+    const int expiries = qMax(1, parser.value("expiries").toInt());
+    const int rows = qMax(1, parser.value("rows").toInt());
+    const QString forcedFormat = parser.value("format");
+    const QString forcedCodec = parser.value("codec").toLower();
+    const bool broadcast = !parser.isSet("no-broadcast");
+    const int burstEverySec = qMax(0, parser.value("burst-every").toInt());
+    const int burstSize = qMax(1, parser.value("burst-size").toInt());
+    const int dropEverySec = qMax(0, parser.value("drop-every").toInt());
+    const double malformedRatio = qBound(0.0, parser.value("malformed").toDouble(), 1.0);
+    const qint64 maxBacklogBytes = qMax(1LL, parser.value("max-backlog").toLongLong()) * 1024 * 1024;
+    const int statsEverySec = qMax(0, parser.value("stats").toInt());
+
+    QStringList symbolNames = parser.value("symbols").split(',', Qt::SkipEmptyParts);
+    if (parser.isSet("symbol-count")) {
+        symbolNames.clear();
+        const int count = qMax(1, parser.value("symbol-count").toInt());
+        for (int i = 0; i < count; ++i) symbolNames.append(QString("SYM%1").arg(i, 4, 10, QChar('0')));
+    }
+
+    // Per symbol SSVI shape, varied across the universe
+    QHash<QString, SymbolState> universe;
+    QRandomGenerator* random = QRandomGenerator::global();
+    for (const QString& name : std::as_const(symbolNames)) {
+        SymbolState symbol;
+        symbol.name = name;
+        symbol.spot = 20.0 + 480.0 * random->generateDouble();
+        symbol.atmVol = 0.15 + 0.35 * random->generateDouble();
+        symbol.rho = -0.2 - 0.5 * random->generateDouble();
+        symbol.eta = 0.6 + 0.8 * random->generateDouble();
+        universe.insert(name, symbol);
+    }
+
+    if (parser.isSet("dicts")) {
+        Compressor::CodecRegistry::instance().loadDictionaries(parser.value("dicts"));
+    }
+    qInfo() << "Codecs compiled in:" << Compressor::availableCodecNames();
+
+    QByteArray fileCsv;
+    if (parser.isSet("csv")) {
+        QFile file(parser.value("csv"));
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "Cannot open CSV file:" << file.fileName();
+            return 1;
+        }
+        fileCsv = file.readAll();
+    }
+
+    QWebSocketServer server("SmileServer", QWebSocketServer::NonSecureMode);
+    if (!server.listen(QHostAddress::Any, port)) {
+        qCritical() << "Cannot listen on port" << port << ":" << server.errorString();
+        return 1;
+    }
+    qInfo() << "SmileServer listening on port" << port << "format:" << forcedFormat << "streams:"
+        << symbolNames.size() << "x" << expiries << "expiries x" << rows << "strikes every" << intervalMs << "ms";
+
+    QHash<QWebSocket*, ClientState> clients;
+    SendStats stats;
+    quint64 malformedCounter = 0;
+
+    auto sendText = [&](QWebSocket* socket, const QByteArray& message) {
+        socket->sendTextMessage(QString::fromUtf8(message));
+        ++stats.messages;
+        stats.bytes += quint64(message.size());
+    };
+
+    // Publishes one smile per expiry of 'symbol' to 'onlyTo', or to every client subscribed to it when null
+    auto publishSymbol = [&](SymbolState& symbol, QWebSocket* onlyTo) {
+        const QString key = streamKey(symbol.name, model);
+        // Small random walk so consecutive smiles differ
+        symbol.atmVol = qBound(0.05, symbol.atmVol * (1.0 + 0.01 * (random->generateDouble() - 0.5)), 1.5);
+        symbol.spot *= 1.0 + 0.002 * (random->generateDouble() - 0.5);
+
+        for (int e = 0; e < expiries; ++e) {
+            const QDate expiry = QDate::currentDate().addMonths(e + 1);
+            const double T = QDate::currentDate().daysTo(expiry) / 365.0;
+            const QByteArray csv = fileCsv.isEmpty()
+                ? SmileGenerator::generateSmileCsv(symbol.name, expiry, rows,
+                    SmileGenerator::ssviForExpiry(symbol.atmVol, symbol.rho, symbol.eta, T, symbol.spot))
+                : fileCsv;
+
+            QHash<quint64, QByteArray> json; // Built lazily per codec/dictionary, shared by the JSON clients using it
+            SmileWire::Frame frame; // Parsed lazily, encoded per client (own sequence)
+            bool frameParsed = false, frameOk = false;
+            for (auto it = clients.begin(); it != clients.end(); ++it) {
+                QWebSocket* socket = it.key();
+                ClientState& state = it.value();
+                if (onlyTo ? socket != onlyTo : !state.subscriptions.contains(key)) continue;
+                if (socket->bytesToWrite() > maxBacklogBytes) {
+                    ++stats.skipped; // Slow client: drop instead of buffering without bound
+                    continue;
+                }
+                const bool malformed = malformedRatio > 0 && random->generateDouble() < malformedRatio;
+                if (malformed) ++stats.malformed;
+
+                if (state.format == SmileWire::FormatBinary) {
+                    if (!frameParsed) {
+                        frameOk = parseFrame(symbol.name, model, csv, frame);
+                        frameParsed = true;
+                    }
+                    if (!frameOk) continue;
+                    frame.sequence = ++state.sequences[key];
+                    QByteArray encoded = SmileWire::encode(frame);
+                    if (malformed) encoded = malformedFrame(encoded, malformedCounter++);
+                    socket->sendBinaryMessage(encoded);
+                    ++stats.messages;
+                    stats.bytes += quint64(encoded.size());
+                }
+                else {
+                    const quint64 codecKey = (quint64(state.codec) << 32) | state.dictId;
+                    if (!json.contains(codecKey)) json.insert(codecKey, jsonMessage(symbol.name, model, fileCsv.isEmpty() ? expiry : QDate(), csv, state.codec, state.dictId));
+                    const QByteArray& message = json.value(codecKey);
+                    sendText(socket, malformed ? malformedJson(message, symbol.name, model, malformedCounter++) : message);
+                }
+            }
+        }
+    };
+
+    auto publishTick = [&]() {
+        for (auto it = universe.begin(); it != universe.end(); ++it) {
+            publishSymbol(it.value(), nullptr);
+        }
+    };
+
+    // "symbol" requests: add/remove/update/snapshot, acked with "symbol_response"
+    auto handleSymbolRequest = [&](QWebSocket* socket, const QJsonObject& request) {
+        const QString action = request.value("action").toString();
+        const QJsonObject data = request.value("data").toObject();
+        const QString symbolName = data.value("symbol_name").toString().trimmed();
+        const QString modelName = data.value("model_name").toString();
+        ClientState& state = clients[socket];
+
+        if (symbolName.isEmpty() || modelName.isEmpty()) {
+            sendText(socket, symbolResponse(action, symbolName, modelName, false, "symbol_name and model_name are required"));
+            return;
+        }
+        if (modelName != model) {
+            sendText(socket, symbolResponse(action, symbolName, modelName, false, "Unknown model: " + modelName));
+            return;
+        }
+
+        const QString key = streamKey(symbolName, modelName);
+        if (action == "add") {
+            if (!universe.contains(symbolName)) {
+                SymbolState symbol;
+                symbol.name = symbolName;
+                universe.insert(symbolName, symbol); // Streamed from the next tick on
+            }
+            state.subscriptions.insert(key);
+            sendText(socket, symbolResponse(action, symbolName, modelName, true));
+            publishSymbol(universe[symbolName], socket); // First snapshot right away
+        }
+        else if (action == "remove") {
+            const bool removed = state.subscriptions.remove(key);
+            sendText(socket, symbolResponse(action, symbolName, modelName, removed, removed ? QString() : "Not subscribed"));
+        }
+        else if (action == "update") {
+            // Settings are accepted as-is; the generated smiles do not depend on them
+            sendText(socket, symbolResponse(action, symbolName, modelName, state.subscriptions.contains(key),
+                state.subscriptions.contains(key) ? QString() : "Not subscribed"));
+        }
+        else if (action == "snapshot") {
+            state.sequences.remove(key); // Binary sequence restarts with the snapshot
+            if (universe.contains(symbolName)) publishSymbol(universe[symbolName], socket);
+        }
+        else {
+            sendText(socket, symbolResponse(action, symbolName, modelName, false, "Unknown action: " + action));
+        }
+    };
+
+    QObject::connect(&server, &QWebSocketServer::newConnection, [&]() {
+        while (QWebSocket* socket = server.nextPendingConnection()) {
+            ClientState state;
+            if (forcedFormat == "binary") state.format = SmileWire::FormatBinary;
+            if (broadcast) {
+                for (const QString& name : std::as_const(symbolNames)) state.subscriptions.insert(streamKey(name, model));
+            }
+            clients.insert(socket, state);
+            qInfo() << "Client connected:" << socket->peerAddress().toString();
+
+            QObject::connect(socket, &QWebSocket::textMessageReceived, socket, [&, socket](const QString& text) {
+                const QJsonObject obj = QJsonDocument::fromJson(text.toUtf8()).object();
+                const QString type = obj.value("type").toString();
+                if (type == "symbol") {
+                    handleSymbolRequest(socket, obj);
+                    return;
+                }
+                if (type != "hello") return;
+
+                ClientState& state = clients[socket];
+                negotiateCodec(obj, forcedCodec, state);
+                if (forcedFormat == "auto") {
+                    // Pick the best format the client accepts
+                    const QJsonArray accept = obj.value("accept").toArray();
+                    state.format = accept.contains(SmileWire::FormatBinary) ? SmileWire::FormatBinary : SmileWire::FormatJsonCsv;
+                }
+                socket->sendTextMessage(QJsonDocument(QJsonObject{ {"type", "hello_ack"}, {"format", state.format},
+                    {"codec", Compressor::codecName(state.codec)}, {"dict", qint64(state.dictId)} })
+                    .toJson(QJsonDocument::Compact));
+                qInfo() << "Client negotiated format:" << state.format << "codec:" << Compressor::codecName(state.codec)
+                    << "dict:" << state.dictId;
+            });
+            QObject::connect(socket, &QWebSocket::disconnected, socket, [&, socket]() {
+                clients.remove(socket);
+                socket->deleteLater();
+                qInfo() << "Client disconnected";
+            });
+        }
+    });
+
+    QTimer publishTimer;
+    QObject::connect(&publishTimer, &QTimer::timeout, publishTick);
+    publishTimer.start(intervalMs);
+
+    QTimer burstTimer;
+    if (burstEverySec > 0) {
+        QObject::connect(&burstTimer, &QTimer::timeout, [&]() {
+            qInfo() << "Burst:" << burstSize << "ticks";
+            for (int i = 0; i < burstSize; ++i) publishTick();
+        });
+        burstTimer.start(burstEverySec * 1000);
+    }
+
+    QTimer dropTimer;
+    if (dropEverySec > 0) {
+        QObject::connect(&dropTimer, &QTimer::timeout, [&]() {
+            qInfo() << "Dropping" << clients.size() << "connection(s)";
+            const QList<QWebSocket*> sockets = clients.keys();
+            for (QWebSocket* socket : sockets) socket->abort(); // 'disconnected' removes the client
+        });
+        dropTimer.start(dropEverySec * 1000);
+    }
+
+    QTimer statsTimer;
+    QElapsedTimer statsClock;
+    if (statsEverySec > 0) {
+        statsClock.start();
+        QObject::connect(&statsTimer, &QTimer::timeout, [&]() {
+            const double seconds = qMax(1, int(statsClock.restart())) / 1000.0;
+            qInfo().noquote() << QString("clients %1  %2 msg/s  %3 MB/s  malformed %4  skipped (slow client) %5")
+                .arg(clients.size()).arg(double(stats.messages) / seconds, 0, 'f', 0)
+                .arg(double(stats.bytes) / 1e6 / seconds, 0, 'f', 2).arg(stats.malformed).arg(stats.skipped);
+            stats = SendStats();
+        });
+        statsTimer.start(statsEverySec * 1000);
+    }
+
+    return app.exec();
+}
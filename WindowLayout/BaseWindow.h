@@ -1,25 +1,30 @@
-#pragma once
-
-#include <QMainWindow>
-#include <QSettings>
-#include <QString>
-
-class QCloseEvent;
-class WindowManager;
-
-class BaseWindow : public QMainWindow
-{
-    Q_OBJECT
-public:
-    BaseWindow(const QString& windowName, WindowManager* windowManager, QWidget* parent = nullptr);
-    virtual ~BaseWindow();
-
-protected:
-    void closeEvent(QCloseEvent* event) override;
-
-private:
-    void loadSettings();
-
-    QString windowName;
-    WindowManager* m_windowManager = nullptr;
-};
+#pragma once
+
+#include <QMainWindow>
+#include <QSettings>
+#include <QString>
+
+class QCloseEvent;
+class WindowManager;
+
+class BaseWindow : public QMainWindow
+{
+    Q_OBJECT
+public:
+    BaseWindow(const QString& windowName, WindowManager* windowManager, QWidget* parent = nullptr);
+    virtual ~BaseWindow();
+
+    // Window-specific state kept next to the geometry in the session settings. WindowManager calls these
+    // with 'settings' already in this window's group.
+    virtual void saveSessionState(QSettings& settings) const { Q_UNUSED(settings); }
+    virtual void restoreSessionState(QSettings& settings) { Q_UNUSED(settings); }
+
+protected:
+    void closeEvent(QCloseEvent* event) override;
+
+private:
+    void loadSettings();
+
+    QString windowName;
+    WindowManager* m_windowManager = nullptr;
+};
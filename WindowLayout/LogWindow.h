@@ -1,14 +1,14 @@
-#pragma once
-
-#include "BaseWindow.h"
-
-class QPlainTextEdit;
-
-class LogWindow : public BaseWindow
-{
-    Q_OBJECT
-public:
-    LogWindow(WindowManager* windowManager, QWidget* parent = nullptr);
-
-    QPlainTextEdit* logWidget;
-};
+#pragma once
+
+#include "BaseWindow.h"
+
+class QPlainTextEdit;
+
+class LogWindow : public BaseWindow
+{
+    Q_OBJECT
+public:
+    LogWindow(WindowManager* windowManager, QWidget* parent = nullptr);
+
+    QPlainTextEdit* logWidget;
+};
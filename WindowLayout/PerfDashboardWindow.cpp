@@ -0,0 +1,213 @@
+#include "PerfDashboardWindow.h"
+#include "Data/ClientReceiver.h"
+#include "Glob/Glob.h"
+#include "Glob/Logger.h"
+#include "Glob/Trace.h"
+#include "Glob/ProcessStats.h"
+
+#include <QLabel>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QSplitter>
+#include <QTimer>
+
+#include <algorithm>
+
+namespace {
+
+    enum StreamColumn {
+        ColKey, ColMsgRate, ColMBRate, ColDepth, ColPeakDepth, ColDropped, ColCoalesced, ColUncoalesced, ColSkipped, ColCpu,
+        StreamColumnCount
+    };
+
+    enum StageColumn {
+        ColStage, ColCount, ColP50, ColP99, ColMax,
+        StageColumnCount
+    };
+
+    QString formatUs(qint64 ns) {
+        return QString::number(double(ns) / 1000.0, 'f', 1);
+    }
+
+} // namespace
+
+PerfDashboardWindow::PerfDashboardWindow(WindowManager* windowManager, ClientReceiver* clientReceiver, QWidget* parent)
+    : BaseWindow("PerfDashboard", windowManager, parent),
+    m_clientReceiver(clientReceiver)
+{
+    if (!m_clientReceiver) {
+        Log.msg(FNAME + QString("ClientReceiver pointer is null, stream statistics are not available."),
+            Logger::Level::ERROR);
+    }
+
+    setupUi();
+
+    m_timer = new QTimer(this);
+    m_timer->setTimerType(Qt::PreciseTimer); // Its lateness is reported as GUI loop lag
+    m_timer->setInterval(SAMPLE_INTERVAL_MS);
+    connect(m_timer, &QTimer::timeout, this, &PerfDashboardWindow::sample);
+
+    m_clock.start();
+    sample(); // Baseline, the first rates follow one interval later
+    m_timer->start();
+}
+
+void PerfDashboardWindow::setupUi() {
+    resize(820, 560);
+
+    auto centralWidget = new QWidget(this);
+    auto mainLayout = new QVBoxLayout(centralWidget);
+
+    auto controlsLayout = new QHBoxLayout();
+    m_summaryLabel = new QLabel(centralWidget);
+    m_summaryLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    m_traceCheck = new QCheckBox("Trace latencies", centralWidget);
+    m_traceCheck->setToolTip("Record per-stage latency histograms ([Trace] Enabled)");
+    m_traceCheck->setChecked(Trace::isEnabled());
+    m_resetButton = new QPushButton("Reset", centralWidget);
+    m_resetButton->setToolTip("Clear the latency histograms");
+    controlsLayout->addWidget(m_summaryLabel, 1);
+    controlsLayout->addWidget(m_traceCheck);
+    controlsLayout->addWidget(m_resetButton);
+
+    m_streamTable = new QTableWidget(0, StreamColumnCount, centralWidget);
+    m_streamTable->setHorizontalHeaderLabels({ "symbol_model", "msg/s", "MB/s", "depth", "peak",
+        "dropped", "coalesced", "uncoalesced", "skipped", "worker CPU %" });
+
+    m_stageTable = new QTableWidget(int(Trace::Stage::Count), StageColumnCount, centralWidget);
+    m_stageTable->setHorizontalHeaderLabels({ "stage", "count", "p50 us", "p99 us", "max us" });
+    for (int i = 0; i < int(Trace::Stage::Count); ++i) {
+        setCell(m_stageTable, i, ColStage, Trace::stageName(Trace::Stage(i)));
+    }
+
+    for (QTableWidget* table : { m_streamTable, m_stageTable }) {
+        table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        table->setSelectionMode(QAbstractItemView::NoSelection);
+        table->verticalHeader()->setVisible(false);
+        table->horizontalHeader()->setStretchLastSection(true);
+    }
+
+    auto splitter = new QSplitter(Qt::Vertical, centralWidget);
+    splitter->addWidget(m_streamTable);
+    splitter->addWidget(m_stageTable);
+
+    mainLayout->addLayout(controlsLayout);
+    mainLayout->addWidget(splitter, 1);
+    setCentralWidget(centralWidget);
+
+    connect(m_traceCheck, &QCheckBox::toggled, this, &PerfDashboardWindow::onTraceToggled);
+    connect(m_resetButton, &QPushButton::clicked, this, &PerfDashboardWindow::onResetClicked);
+}
+
+void PerfDashboardWindow::sample() {
+    const qint64 nowNs = m_clock.nsecsElapsed();
+    const qint64 intervalNs = nowNs - m_lastSampleNs;
+    const bool baseline = m_lastSampleNs == 0;
+    m_lastSampleNs = nowNs;
+
+    const QList<IngestExecutor::KeyStats> stats = m_clientReceiver ? m_clientReceiver->getIngressStats()
+        : QList<IngestExecutor::KeyStats>();
+    const qint64 cpuNs = ProcessStats::cpuTimeNs();
+    const qint64 rssBytes = ProcessStats::residentBytes();
+    const RedrawScheduler::Stats redrawStats = Glob.redrawScheduler ? Glob.redrawScheduler->stats() : RedrawScheduler::Stats();
+
+    if (!baseline && intervalNs > 0 && isVisible()) {
+        const double seconds = double(intervalNs) / 1e9;
+        updateStreamTable(stats, seconds);
+        updateStageTable();
+
+        // Totals over all streams
+        quint64 messages = 0, bytes = 0;
+        qint64 busyNs = 0;
+        for (const IngestExecutor::KeyStats& s : stats) {
+            const IngestExecutor::KeyStats previous = m_previous.value(s.key);
+            messages += s.enqueued - previous.enqueued;
+            bytes += s.bytes - previous.bytes;
+            busyNs += s.busyNs - previous.busyNs;
+        }
+
+        const qint64 lagMs = qMax<qint64>(0, intervalNs / 1000000 - SAMPLE_INTERVAL_MS);
+        QString summary = QString("%1 msg/s   %2 MB/s   workers %3%   process CPU %4%   RSS %5 MB   GUI lag %6 ms")
+            .arg(double(messages) / seconds, 0, 'f', 0)
+            .arg(double(bytes) / 1e6 / seconds, 0, 'f', 2)
+            .arg(100.0 * double(busyNs) / double(intervalNs), 0, 'f', 1)
+            .arg(cpuNs >= 0 && m_lastCpuNs >= 0 ? QString::number(100.0 * double(cpuNs - m_lastCpuNs) / double(intervalNs), 'f', 1) : "n/a")
+            .arg(rssBytes >= 0 ? QString::number(double(rssBytes) / (1024.0 * 1024.0), 'f', 1) : "n/a")
+            .arg(lagMs);
+        summary += QString("   redraws %1/s of %2 updates/s")
+            .arg(double(redrawStats.redraws - m_lastRedrawStats.redraws) / seconds, 0, 'f', 0)
+            .arg(double(redrawStats.requests - m_lastRedrawStats.requests) / seconds, 0, 'f', 0);
+        if (Trace::isEnabled()) {
+            const Trace::Histogram& paint = Trace::histogram(Trace::Stage::Paint);
+            summary += QString("   paint p50/p99 %1/%2 us").arg(formatUs(paint.percentile(50)), formatUs(paint.percentile(99)));
+        }
+        m_summaryLabel->setText(summary);
+    }
+
+    m_lastCpuNs = cpuNs;
+    m_lastRedrawStats = redrawStats;
+    m_previous.clear();
+    for (const IngestExecutor::KeyStats& s : stats) {
+        m_previous.insert(s.key, s);
+    }
+}
+
+void PerfDashboardWindow::updateStreamTable(const QList<IngestExecutor::KeyStats>& stats, double seconds) {
+    QList<IngestExecutor::KeyStats> sorted = stats;
+    std::sort(sorted.begin(), sorted.end(),
+        [](const IngestExecutor::KeyStats& a, const IngestExecutor::KeyStats& b) { return a.key < b.key; });
+
+    if (m_streamTable->rowCount() != sorted.size()) {
+        m_streamTable->setRowCount(sorted.size());
+    }
+    for (int row = 0; row < sorted.size(); ++row) {
+        const IngestExecutor::KeyStats& s = sorted[row];
+        const IngestExecutor::KeyStats previous = m_previous.value(s.key); // Zero for a new key
+        setCell(m_streamTable, row, ColKey, s.key);
+        setCell(m_streamTable, row, ColMsgRate, QString::number(double(s.enqueued - previous.enqueued) / seconds, 'f', 1));
+        setCell(m_streamTable, row, ColMBRate, QString::number(double(s.bytes - previous.bytes) / 1e6 / seconds, 'f', 3));
+        setCell(m_streamTable, row, ColDepth, QString::number(s.depth));
+        setCell(m_streamTable, row, ColPeakDepth, QString::number(s.peakDepth));
+        setCell(m_streamTable, row, ColDropped, QString::number(s.dropped));
+        setCell(m_streamTable, row, ColCoalesced, QString::number(s.coalesced));
+        setCell(m_streamTable, row, ColUncoalesced, QString::number(s.uncoalesced));
+        setCell(m_streamTable, row, ColSkipped, QString::number(s.skipped));
+        setCell(m_streamTable, row, ColCpu, QString::number(100.0 * double(s.busyNs - previous.busyNs) / (seconds * 1e9), 'f', 1));
+    }
+}
+
+void PerfDashboardWindow::updateStageTable() {
+    for (int i = 0; i < int(Trace::Stage::Count); ++i) {
+        const Trace::Histogram& h = Trace::histogram(Trace::Stage(i));
+        const bool empty = h.count() == 0;
+        setCell(m_stageTable, i, ColCount, QString::number(h.count()));
+        setCell(m_stageTable, i, ColP50, empty ? "-" : formatUs(h.percentile(50)));
+        setCell(m_stageTable, i, ColP99, empty ? "-" : formatUs(h.percentile(99)));
+        setCell(m_stageTable, i, ColMax, empty ? "-" : formatUs(h.max()));
+    }
+}
+
+void PerfDashboardWindow::setCell(QTableWidget* table, int row, int column, const QString& text) {
+    QTableWidgetItem* item = table->item(row, column);
+    if (!item) {
+        item = new QTableWidgetItem(text);
+        if (column != 0) item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        table->setItem(row, column, item);
+    }
+    else if (item->text() != text) {
+        item->setText(text);
+    }
+}
+
+void PerfDashboardWindow::onTraceToggled(bool enabled) {
+    Trace::setEnabled(enabled);
+}
+
+void PerfDashboardWindow::onResetClicked() {
+    Trace::reset();
+    updateStageTable();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "BaseWindow.h"
+#include "RedrawScheduler.h"
+#include "Data/IngestExecutor.h"
+
+#include <QHash>
+#include <QElapsedTimer>
+
+// Forward declarations
+class QLabel;
+class QCheckBox;
+class QPushButton;
+class QTableWidget;
+class QTimer;
+class ClientReceiver;
+
+// Live health of the ingest pipeline: per stream rates, queue depths, drops, worker CPU time,
+// per-stage latency percentiles (Trace), GUI loop lag and process RSS/CPU.
+//
+// Everything is sampled once per SAMPLE_INTERVAL_MS from relaxed atomic counters (IngestExecutor
+// stats, Trace histograms) and rates are derived from the difference between two samples. Nothing is
+// pushed to this window, so an open dashboard adds no work to the network or ingest threads.
+class PerfDashboardWindow : public BaseWindow
+{
+    Q_OBJECT
+
+public:
+    explicit PerfDashboardWindow(WindowManager* windowManager, ClientReceiver* clientReceiver, QWidget* parent = nullptr);
+    ~PerfDashboardWindow() override = default;
+
+private slots:
+    void sample();
+    void onTraceToggled(bool enabled);
+    void onResetClicked();
+
+private:
+    void setupUi();
+    void updateStreamTable(const QList<IngestExecutor::KeyStats>& stats, double seconds);
+    void updateStageTable();
+    // Sets the text of a cell, creating the item on first use; unchanged text does not repaint
+    static void setCell(QTableWidget* table, int row, int column, const QString& text);
+
+    static const int SAMPLE_INTERVAL_MS = 1000;
+
+    ClientReceiver* m_clientReceiver = nullptr;
+
+    QLabel* m_summaryLabel = nullptr;
+    QCheckBox* m_traceCheck = nullptr;
+    QPushButton* m_resetButton = nullptr;
+    QTableWidget* m_streamTable = nullptr; // One row per symbol_model
+    QTableWidget* m_stageTable = nullptr;  // One row per Trace::Stage
+    QTimer* m_timer = nullptr;
+
+    // Previous sample, rates are computed against it
+    QElapsedTimer m_clock;
+    qint64 m_lastSampleNs = 0;
+    qint64 m_lastCpuNs = -1;
+    RedrawScheduler::Stats m_lastRedrawStats;
+    QHash<QString, IngestExecutor::KeyStats> m_previous;
+};
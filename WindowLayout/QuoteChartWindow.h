@@ -1,81 +1,95 @@
-#pragma once
-
-#include "BaseWindow.h"
-#include "Plots/SmilePlot.h"
-#include "Plots/PlotDataForDate.h"
-
-#include <QMainWindow>
-#include <QMap>
-#include <QList>
-#include <QDate>
-#include <QPointF>
-#include <QStringList>
-
-// Forward declarations
-class QComboBox;
-class QPushButton;
-class QVBoxLayout;
-class QHBoxLayout;
-class QWidget;
-class ClientReceiver;
-class QLabel;     // Include QLabel
-class QButtonGroup;
-
-class QuoteChartWindow : public BaseWindow
-{
-    Q_OBJECT
-
-public:
-    explicit QuoteChartWindow(WindowManager* windowManager, ClientReceiver* clientReceiver, QWidget* parent = nullptr);
-    ~QuoteChartWindow() override = default;
-
-protected:
-    void closeEvent(QCloseEvent* event) override;
-
-private slots:
-    void plotDataUpdated(const QString& symbol, const QDate& date, const PlotDataForDate& data);
-    void onSymbolChanged(int index);
-    void onDateChanged(int index);
-    void onRecalibrateClicked();
-    void onResetZoomClicked();
-    void onModeButtonClicked(int id);
-    void onPlotPointClicked(const SmilePointData& pointData);
-
-private:
-    QWidget* m_centralWidget = nullptr;
-    QVBoxLayout* m_mainLayout = nullptr;
-    QHBoxLayout* m_controlsLayout = nullptr;
-    QComboBox* m_symbolCombo = nullptr;
-    QComboBox* m_dateCombo = nullptr;
-    QPushButton* m_recalibrateButton = nullptr;
-    SmilePlot* m_smilePlot = nullptr; // Instance of the Qt Charts based SmilePlot
-
-    QPushButton* m_resetZoomButton = nullptr;
-
-    // Interaction Mode Handling
-    QToolButton* m_panButton = nullptr;
-    QToolButton* m_zoomButton = nullptr;
-    QButtonGroup* m_modeButtons = nullptr;
-
-    ClientReceiver* m_clientReceiver = nullptr;
-
-    // --- Data Storage ---
-    // Stores ALL plot data received, keyed by symbol string, then by QDate
-    QMap<QString, QMap<QDate, PlotDataForDate>> m_allPlotData;
-    // Stores available dates for the *currently selected* symbol (used to populate date combo)
-    QList<QDate> m_availableDatesForCurrentSymbol;
-    QStringList m_availableSymbols; // Keep track of all symbols seen
-    // Stores the currently selected symbol and date from the UI
-    QString m_currentSymbol;
-    QDate m_currentDate;
-
-    void setupUi();
-    void setupConnections();
-    void populateSymbolCombo();
-    void populateDateCombo();
-    void plotSelectedData();  // Filters data and calls SmilePlot::updateData
-
-    void setupModeButtons(); // Create Pan/Zoom buttons
-    void applyCurrentInteractionMode();
-    void setMode(SmilePlot::PlotMode mode);
-};
+#pragma once
+
+#include "BaseWindow.h"
+#include "Plots/SmilePlotView.h"
+#include "Plots/SmilePointData.h"
+#include "Data/SmileSnapshot.h"
+
+#include <QMainWindow>
+#include <QMap>
+#include <QList>
+#include <QDate>
+#include <QPointF>
+#include <QStringList>
+
+// Forward declarations
+class QComboBox;
+class QPushButton;
+class QVBoxLayout;
+class QHBoxLayout;
+class QWidget;
+class ClientReceiver;
+class QLabel;     // Include QLabel
+class QButtonGroup;
+class QToolButton;
+
+class QuoteChartWindow : public BaseWindow
+{
+    Q_OBJECT
+
+public:
+    explicit QuoteChartWindow(WindowManager* windowManager, ClientReceiver* clientReceiver, QWidget* parent = nullptr);
+    ~QuoteChartWindow() override = default;
+
+    // Persists the plot renderer of this window
+    void saveSessionState(QSettings& settings) const override;
+    void restoreSessionState(QSettings& settings) override;
+
+protected:
+    void closeEvent(QCloseEvent* event) override;
+
+private slots:
+    void plotDataUpdated(const QString& symbol, const QDate& date, const SmileSnapshotPtr& snapshot);
+    void onSymbolChanged(int index);
+    void onDateChanged(int index);
+    void onRecalibrateClicked();
+    void onResetZoomClicked();
+    void onModeButtonClicked(int id);
+    void onRendererChanged(int index);
+    void onPlotPointClicked(const SmilePointData& pointData);
+
+private:
+    QWidget* m_centralWidget = nullptr;
+    QVBoxLayout* m_mainLayout = nullptr;
+    QHBoxLayout* m_controlsLayout = nullptr;
+    QComboBox* m_symbolCombo = nullptr;
+    QComboBox* m_dateCombo = nullptr;
+    QPushButton* m_recalibrateButton = nullptr;
+    QComboBox* m_rendererCombo = nullptr;
+    SmilePlotView* m_smilePlot = nullptr; // SmilePlot (Qt Charts) or RasterSmilePlot, see createSmilePlot
+
+    QPushButton* m_resetZoomButton = nullptr;
+
+    // Interaction Mode Handling
+    QToolButton* m_panButton = nullptr;
+    QToolButton* m_zoomButton = nullptr;
+    QButtonGroup* m_modeButtons = nullptr;
+
+    ClientReceiver* m_clientReceiver = nullptr;
+
+    // --- Data Storage ---
+    // Handle to the latest shared snapshot, keyed by stream (symbol_model, see ClientReceiver::streamKey), then by QDate
+    // (data is owned by ClientReceiver). Two models of one symbol are separate entries of the symbol combo.
+    QMap<QString, QMap<QDate, SmileSnapshotPtr>> m_allPlotData;
+    SmileSnapshotPtr m_plottedSnapshot; // Snapshot currently shown by m_smilePlot (null if the plot is clear)
+    // Stores available dates for the *currently selected* stream (used to populate date combo)
+    QList<QDate> m_availableDatesForCurrentStream;
+    QStringList m_availableStreams; // Keep track of all symbol_model streams seen
+    // Stores the currently selected stream and date from the UI
+    QString m_currentStream;
+    QDate m_currentDate;
+
+    void setupUi();
+    void setupConnections();
+    void loadExistingSnapshots(); // Pick up snapshots published before this window was opened
+    void populateSymbolCombo();
+    void populateDateCombo();
+    void plotSelectedData();  // Filters data and calls SmilePlot::updateData
+    void redrawPlot();        // Frame callback of the RedrawScheduler: plots the latest selected snapshot
+
+    // Replaces the plot widget by a 'renderer' one ("charts" or "raster"), keeping mode and plotted data
+    void createSmilePlot(const QString& renderer);
+    void setupModeButtons(); // Create Pan/Zoom buttons
+    void applyCurrentInteractionMode();
+    void setMode(SmilePlotView::PlotMode mode);
+};
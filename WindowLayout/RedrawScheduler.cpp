@@ -0,0 +1,128 @@
+#include "RedrawScheduler.h"
+#include "Glob/Logger.h"
+
+#include <QWidget>
+#include <QWindow>
+#include <QEvent>
+
+RedrawScheduler::RedrawScheduler(int frameIntervalMs, QObject* parent)
+    : QObject(parent), m_timer(this), m_frameIntervalMs(qMax(1, frameIntervalMs))
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer); // Coarse timers may slip by 5% of the interval
+    connect(&m_timer, &QTimer::timeout, this, &RedrawScheduler::onFrame);
+    m_clock.start();
+}
+
+void RedrawScheduler::registerWindow(QWidget* window, std::function<void()> redraw) {
+    if (!window || !redraw) {
+        Log.msg(FNAME + "Attempted to register a null window or redraw callback.", Logger::Level::WARNING);
+        return;
+    }
+
+    const bool known = m_windows.contains(window);
+    m_windows[window].redraw = std::move(redraw);
+    if (known) return;
+
+    window->installEventFilter(this);
+    watchWindowHandle(window);
+    connect(window, &QObject::destroyed, this, [this, window]() { unregisterWindow(window); });
+}
+
+void RedrawScheduler::unregisterWindow(QWidget* window) {
+    if (m_windows.remove(window) == 0) return;
+
+    // Called from 'destroyed' too: 'window' is not dereferenced
+    for (auto it = m_windowHandles.begin(); it != m_windowHandles.end();) {
+        if (it.value() == window) {
+            it.key()->removeEventFilter(this);
+            it = m_windowHandles.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void RedrawScheduler::markDirty(QWidget* window) {
+    auto it = m_windows.find(window);
+    if (it == m_windows.end()) {
+        Log.msg(FNAME + "markDirty for an unregistered window.", Logger::Level::DEBUG);
+        return;
+    }
+    ++m_stats.requests;
+    if (it->dirty) return; // Already due on the next frame
+
+    it->dirty = true;
+    if (isVisibleToUser(window)) {
+        scheduleFrame();
+    }
+}
+
+void RedrawScheduler::setFrameIntervalMs(int frameIntervalMs) {
+    m_frameIntervalMs = qMax(1, frameIntervalMs);
+}
+
+void RedrawScheduler::scheduleFrame() {
+    if (m_timer.isActive()) return;
+
+    // A request after an idle period draws at once; otherwise it waits for the end of the current frame
+    const qint64 sinceLastMs = m_lastFrameNs < 0 ? m_frameIntervalMs : (m_clock.nsecsElapsed() - m_lastFrameNs) / 1000000;
+    m_timer.start(int(qMax<qint64>(0, m_frameIntervalMs - sinceLastMs)));
+}
+
+void RedrawScheduler::onFrame() {
+    m_lastFrameNs = m_clock.nsecsElapsed();
+    ++m_stats.frames;
+
+    // Callbacks may mark windows dirty again (handled on the next frame) but do not add or remove windows
+    const QList<QWidget*> windows = m_windows.keys();
+    for (QWidget* window : windows) {
+        auto it = m_windows.find(window);
+        if (it == m_windows.end() || !it->dirty) continue;
+        if (!isVisibleToUser(window)) continue; // Stays dirty: redrawn once shown (see eventFilter)
+
+        it->dirty = false;
+        ++m_stats.redraws;
+        const std::function<void()> redraw = it->redraw; // The entry may be gone after the call
+        redraw();
+    }
+}
+
+bool RedrawScheduler::eventFilter(QObject* watched, QEvent* event) {
+    switch (event->type()) {
+    case QEvent::Show:
+    case QEvent::WindowStateChange: // Restored from minimized
+    case QEvent::Expose: {          // Uncovered (sent to the native window)
+        QWidget* window = m_windowHandles.value(qobject_cast<QWindow*>(watched), qobject_cast<QWidget*>(watched));
+        if (!window) break;
+        if (event->type() == QEvent::Show) {
+            watchWindowHandle(window);
+        }
+        auto it = m_windows.constFind(window);
+        if (it != m_windows.constEnd() && it->dirty && isVisibleToUser(window)) {
+            scheduleFrame();
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void RedrawScheduler::watchWindowHandle(QWidget* window) {
+    QWindow* handle = window->windowHandle();
+    if (!handle || m_windowHandles.contains(handle)) return;
+
+    m_windowHandles.insert(handle, window);
+    handle->installEventFilter(this);
+    connect(handle, &QObject::destroyed, this, [this, handle]() { m_windowHandles.remove(handle); });
+}
+
+bool RedrawScheduler::isVisibleToUser(const QWidget* window) {
+    const QWidget* topLevel = window->window();
+    if (!topLevel->isVisible() || topLevel->isMinimized()) return false;
+    const QWindow* handle = topLevel->windowHandle();
+    return !handle || handle->isExposed();
+}
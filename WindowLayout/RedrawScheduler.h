@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <functional>
+
+class QWidget;
+class QWindow;
+
+// Frame clock for data-driven repaints, shared by all windows (Glob.redrawScheduler).
+// A window marks itself dirty on every data update instead of replotting; on the next frame the scheduler
+// runs its redraw callback once, so a window draws at most once per frame interval and always the latest data,
+// however fast the feed. Windows that are hidden, minimized or not exposed (fully covered, where the platform
+// reports it) stay dirty without drawing and are redrawn on the first frame after they are shown again.
+// Idle (nothing dirty) the timer is stopped. GUI thread only.
+class RedrawScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit RedrawScheduler(int frameIntervalMs, QObject* parent = nullptr);
+
+    // 'redraw' runs on a frame while top-level 'window' is dirty and visible. Ends when 'window' is destroyed.
+    void registerWindow(QWidget* window, std::function<void()> redraw);
+    void unregisterWindow(QWidget* window);
+    // Requests a redraw of 'window' on the next frame (several requests before it are coalesced)
+    void markDirty(QWidget* window);
+
+    int frameIntervalMs() const { return m_frameIntervalMs; }
+    void setFrameIntervalMs(int frameIntervalMs);
+
+    // Cumulative counters since start
+    struct Stats {
+        quint64 requests = 0; // markDirty calls
+        quint64 redraws = 0;  // Redraw callbacks run
+        quint64 frames = 0;   // Frame ticks
+    };
+    Stats stats() const { return m_stats; }
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private slots:
+    void onFrame();
+
+private:
+    struct Entry {
+        std::function<void()> redraw;
+        bool dirty = false;
+    };
+
+    QHash<QWidget*, Entry> m_windows;
+    QHash<QWindow*, QWidget*> m_windowHandles; // Native windows watched for expose events
+    QTimer m_timer; // Single shot, started by the first request after a frame
+    QElapsedTimer m_clock;
+    qint64 m_lastFrameNs = -1;
+    int m_frameIntervalMs;
+    Stats m_stats;
+
+    void scheduleFrame();
+    // The widget's native window exists only once shown; watched from then on
+    void watchWindowHandle(QWidget* window);
+    static bool isVisibleToUser(const QWidget* window);
+};
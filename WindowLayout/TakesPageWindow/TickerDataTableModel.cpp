@@ -1,226 +1,422 @@
-#include "TickerDataTableModel.h"
-
-#include <QDateTime>
-#include <QFont>
-#include <QColor>
-#include <QDebug>
-#include <algorithm> // for std::find
-
-// Define initial headers - these might be adjusted dynamically
-const QStringList INITIAL_HEADERS = { "Symbol", "Model", "Timestamp" };
-// Define update interval for batching (milliseconds)
-const int UPDATE_INTERVAL_MS = 100;
-
-
-TickerDataTableModel::TickerDataTableModel(SymbolDataManager* dataManager, QObject* parent)
-    : QAbstractTableModel(parent), m_dataManager(dataManager)
-{
-    m_headers = INITIAL_HEADERS;
-
-    // Setup timer for batching updates
-    m_updateTimer.setInterval(UPDATE_INTERVAL_MS);
-    m_updateTimer.setSingleShot(true); // Fire only once per interval after activity
-    connect(&m_updateTimer, &QTimer::timeout, this, &TickerDataTableModel::processPendingUpdates);
-}
-
-int TickerDataTableModel::rowCount(const QModelIndex& parent) const {
-    return parent.isValid() ? 0 : m_tickerData.count();
-}
-
-int TickerDataTableModel::columnCount(const QModelIndex& parent) const {
-    return parent.isValid() ? 0 : m_headers.count();
-}
-
-QVariant TickerDataTableModel::data(const QModelIndex& index, int role) const {
-    if (!index.isValid() || index.row() >= m_tickerData.count() || index.column() >= m_headers.count()) {
-        return QVariant();
-    }
-
-    const TickerRowData& rowData = m_tickerData.at(index.row());
-    const QString& header = m_headers.at(index.column());
-
-    if (role == Qt::DisplayRole) {
-        if (header == "Symbol") return rowData.symbol;
-        if (header == "Model") return rowData.model;
-        if (header == "Timestamp") {
-            // Format timestamp nicely
-            return QDateTime::fromMSecsSinceEpoch(rowData.lastUpdateTime).toString(Qt::ISODateWithMs);
-        }
-        // Return data from the dynamic fields map
-        return rowData.fields.value(header, QVariant()); // Return empty QVariant if key not found
-    }
-    // Add other roles (e.g., Qt::TextAlignmentRole, Qt::ForegroundRole for highlighting changes)
-    else if (role == Qt::TextAlignmentRole) {
-        // Example: Right-align numerical data (check if value is numeric)
-        QVariant value = rowData.fields.value(header);
-        bool isNumeric;
-        value.toDouble(&isNumeric);
-        if (isNumeric || header == "Timestamp") { // Align timestamp right too
-            return QVariant::fromValue(Qt::AlignRight | Qt::AlignVCenter);
-        }
-        return QVariant::fromValue(Qt::AlignLeft | Qt::AlignVCenter);
-    }
-    // Example: Highlight recent updates 
-   /*
-   else if (role == Qt::BackgroundRole) {
-       qint64 now = QDateTime::currentMSecsSinceEpoch();
-       if (now - rowData.lastUpdateTime < 500) { // Highlight if updated < 500ms ago
-           return QColor(Qt::yellow).lighter(180);
-       }
-   }
-   */
-
-    return QVariant();
-}
-
-QVariant TickerDataTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
-    if (role == Qt::DisplayRole && orientation == Qt::Horizontal) {
-        if (section >= 0 && section < m_headers.count()) {
-            return m_headers.at(section);
-        }
-    }
-    return QAbstractTableModel::headerData(section, orientation, role);
-}
-
-QString TickerDataTableModel::generateKey(const QString& symbol, const QString& model) const {
-    return symbol + "_" + model;
-}
-
-
-void TickerDataTableModel::handleTickerDataReceived(const QString& symbol, const QString& model, const QVariantMap& data) {
-    // Crucial: Check if the symbol is currently active in the data manager
-    if (m_dataManager->getSymbolState(symbol, model) != SymbolDataManager::SymbolState::Active) {
-        // qInfo() << "Ignoring data for paused/removed symbol:" << symbol << model;
-        return; // Ignore data for paused or non-existent symbols
-    }
-
-    // Prepare data for batching
-    QString key = generateKey(symbol, model);
-    TickerRowData updateData;
-    updateData.symbol = symbol;
-    updateData.model = model;
-    ///updateData.fields = QMap<QString, QVariant>::fromMap(data); // Convert QVariantMap to QMap
-    updateData.lastUpdateTime = QDateTime::currentMSecsSinceEpoch(); // Use arrival time
-
-    { // Lock scope for pending updates map
-        QMutexLocker locker(&m_pendingUpdatesMutex);
-        m_pendingUpdates[key] = updateData; // Overwrite previous pending update for the same key
-    }
-
-    // Start or restart the timer to process the batch soon
-    if (!m_updateTimer.isActive()) {
-        m_updateTimer.start();
-    }
-}
-
-void TickerDataTableModel::processPendingUpdates() {
-    QMap<QString, TickerRowData> updatesToProcess;
-    { // Lock scope
-        QMutexLocker locker(&m_pendingUpdatesMutex);
-        if (m_pendingUpdates.isEmpty()) {
-            return; // Nothing to process
-        }
-        updatesToProcess = std::move(m_pendingUpdates); // Move data out efficiently
-        m_pendingUpdates.clear(); // Clear the original map
-    }
-
-    // Check for new headers from the batch
-    if (!updatesToProcess.isEmpty()) {
-        updateHeaders(updatesToProcess.first().fields); // Use first item's fields as sample
-    }
-
-    // Process updates (add or update rows)
-    for (const auto& data : updatesToProcess) {
-        addOrUpdateRow(data);
-    }
-}
-
-
-void TickerDataTableModel::updateHeaders(const QVariantMap& dataSample) {
-    bool headersChanged = false;
-    QStringList currentKeys = dataSample.keys();
-
-    // Check for new keys to add as headers
-    for (const QString& key : std::as_const(currentKeys)) {
-        if (!m_headers.contains(key)) {
-            m_headers.append(key);
-            headersChanged = true;
-        }
-    }
-
-    // If headers changed, signal the view to reset
-    if (headersChanged) {
-        qInfo() << "Headers updated:" << m_headers;
-        beginResetModel(); // More drastic than headerDataChanged, forces view update
-        endResetModel();
-    }
-}
-
-void TickerDataTableModel::addOrUpdateRow(const TickerRowData& newData) {
-    QString key = generateKey(newData.symbol, newData.model);
-
-    if (m_rowMap.contains(key)) {
-        // Update existing row
-        int rowIndex = m_rowMap.value(key);
-        if (rowIndex >= 0 && rowIndex < m_tickerData.count()) {
-            m_tickerData[rowIndex] = newData; // Replace data
-            // Emit dataChanged for the entire row
-            emit dataChanged(index(rowIndex, 0), index(rowIndex, columnCount() - 1), { Qt::DisplayRole, Qt::BackgroundRole }); // Include roles that might change
-        }
-        else {
-            qWarning() << "Row map contains key but index is invalid:" << key << rowIndex;
-            // Fallback to adding as new row?
-            m_rowMap.remove(key); // Remove invalid entry
-            goto AddNewRow; // Use goto for simplicity here, or restructure
-        }
-    }
-    else {
-    AddNewRow:
-        // Add new row
-        int newRowIndex = m_tickerData.count();
-        beginInsertRows(QModelIndex(), newRowIndex, newRowIndex);
-        m_tickerData.append(newData);
-        m_rowMap.insert(key, newRowIndex); // Add to map
-        endInsertRows();
-    }
-}
-
-void TickerDataTableModel::removeRow(const QString& symbol, const QString& model) {
-    QString key = generateKey(symbol, model);
-    if (m_rowMap.contains(key)) {
-        int rowIndex = m_rowMap.value(key);
-        if (rowIndex >= 0 && rowIndex < m_tickerData.count()) {
-            beginRemoveRows(QModelIndex(), rowIndex, rowIndex);
-            m_tickerData.removeAt(rowIndex);
-            m_rowMap.remove(key); // Remove from map
-
-            // Update row indices in the map for rows that came after the removed one
-            for (auto it = m_rowMap.begin(); it != m_rowMap.end(); ++it) {
-                if (it.value() > rowIndex) {
-                    it.value()--; // Decrement index
-                }
-            }
-            endRemoveRows();
-        }
-        else {
-            qWarning() << "Row map contains key for removal but index is invalid:" << key << rowIndex;
-            m_rowMap.remove(key); // Clean up invalid entry
-        }
-    }
-}
-
-// --- Slots reacting to symbol list changes ---
-
-void TickerDataTableModel::handleSymbolRemoved(const QString& symbol, const QString& model) {
-    // If a symbol is removed from the watchlist, remove its row from the table
-    removeRow(symbol, model);
-}
-
-void TickerDataTableModel::handleSymbolStateChanged(const QString& symbol, const QString& model, SymbolDataManager::SymbolState newState) {
-    // If a symbol is paused, remove its row from the table
-    if (newState == SymbolDataManager::SymbolState::Paused) {
-        removeRow(symbol, model);
-    }
-    // If it's resumed, data will start flowing again via handleTickerDataReceived,
-    // which will re-add the row if it's not present. No action needed here for resume.
+#include "TickerDataTableModel.h"
+
+#include <QDateTime>
+#include <QFont>
+#include <QColor>
+#include <QtMath>
+#include <QDebug>
+#include <algorithm> // for std::find
+#include <functional>
+#include <tuple>
+
+// Define update interval for batching (milliseconds)
+const int UPDATE_INTERVAL_MS = 100;
+// How long the cells changed by a batch stay highlighted (if no newer batch replaces them)
+const int HIGHLIGHT_MS = 500;
+
+
+TickerDataTableModel::TickerDataTableModel(SymbolDataManager* dataManager, QObject* parent)
+    : QAbstractTableModel(parent), m_dataManager(dataManager)
+{
+    // Fixed columns, the data fields are appended as they appear
+    addColumn("Symbol", TickerColumn::Type::Symbol);
+    addColumn("Model", TickerColumn::Type::Model);
+    addColumn("Timestamp", TickerColumn::Type::Timestamp);
+
+    // Setup timer for batching updates
+    m_updateTimer.setInterval(UPDATE_INTERVAL_MS);
+    m_updateTimer.setSingleShot(true); // Fire only once per interval after activity
+    connect(&m_updateTimer, &QTimer::timeout, this, &TickerDataTableModel::processPendingUpdates);
+
+    m_highlightTimer.setInterval(HIGHLIGHT_MS);
+    m_highlightTimer.setSingleShot(true);
+    connect(&m_highlightTimer, &QTimer::timeout, this, &TickerDataTableModel::clearHighlight);
+}
+
+int TickerDataTableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : m_tickerData.count();
+}
+
+int TickerDataTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : m_columns.count();
+}
+
+QVariant TickerDataTableModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= m_tickerData.count() || index.column() >= m_columns.count()) {
+        return QVariant();
+    }
+
+    const TickerRowData& rowData = m_tickerData.at(index.row());
+    const TickerColumn& column = m_columns.at(index.column());
+
+    if (role == Qt::DisplayRole) {
+        switch (column.type) {
+        case TickerColumn::Type::Symbol:
+            return rowData.symbol;
+        case TickerColumn::Type::Model:
+            return rowData.model;
+        case TickerColumn::Type::Timestamp:
+            return rowData.timestampText;
+        case TickerColumn::Type::Number: {
+            const double value = column.slot < rowData.numbers.count() ? rowData.numbers.at(column.slot) : qQNaN();
+            return qIsNaN(value) ? QVariant() : QVariant(value);
+        }
+        case TickerColumn::Type::Text:
+            return column.slot < rowData.texts.count() ? rowData.texts.at(column.slot) : QString();
+        }
+    }
+    // Add other roles (e.g., Qt::ForegroundRole for up/down colouring)
+    else if (role == Qt::TextAlignmentRole) {
+        // Numbers and the timestamp right-aligned
+        if (column.type == TickerColumn::Type::Number || column.type == TickerColumn::Type::Timestamp) {
+            return QVariant::fromValue(Qt::AlignRight | Qt::AlignVCenter);
+        }
+        return QVariant::fromValue(Qt::AlignLeft | Qt::AlignVCenter);
+    }
+    // Highlight the cells changed by the latest batch (no clock read per paint: m_highlightTimer ends it)
+    else if (role == Qt::BackgroundRole) {
+        if (m_highlightBatch != 0 && index.column() < rowData.changedBatch.count()
+            && rowData.changedBatch.at(index.column()) == m_highlightBatch) {
+            return QColor(Qt::yellow).lighter(180);
+        }
+    }
+
+    return QVariant();
+}
+
+QVariant TickerDataTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal) {
+        if (section >= 0 && section < m_columns.count()) {
+            return m_columns.at(section).name;
+        }
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+void TickerDataTableModel::setHighlightChanges(bool enabled) {
+    if (!enabled) {
+        m_highlightTimer.stop();
+        clearHighlight();
+    }
+    m_highlightChanges = enabled;
+}
+
+QString TickerDataTableModel::generateKey(const QString& symbol, const QString& model) const {
+    return symbol + "_" + model;
+}
+
+void TickerDataTableModel::addColumn(const QString& name, TickerColumn::Type type) {
+    TickerColumn column;
+    column.name = name;
+    column.type = type;
+    if (type == TickerColumn::Type::Number) {
+        column.slot = m_numberSlots++;
+    }
+    else if (type == TickerColumn::Type::Text) {
+        column.slot = m_textSlots++;
+    }
+    m_columnIds.insert(name, m_columns.count());
+    m_columns.append(column);
+}
+
+int TickerDataTableModel::columnId(const QString& name, const QVariant& sample) {
+    const auto it = m_columnIds.constFind(name);
+    if (it != m_columnIds.constEnd()) {
+        return it.value();
+    }
+
+    // Numeric values, or strings holding one, make a Number column. Later values that are not numbers show empty.
+    bool isNumeric = false;
+    switch (sample.typeId()) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Double:
+    case QMetaType::Float:
+        isNumeric = true;
+        break;
+    case QMetaType::QString:
+        sample.toString().toDouble(&isNumeric);
+        break;
+    default:
+        break;
+    }
+
+    const int id = m_columns.count();
+    beginInsertColumns(QModelIndex(), id, id);
+    addColumn(name, isNumeric ? TickerColumn::Type::Number : TickerColumn::Type::Text);
+    endInsertColumns();
+    qInfo() << "Column added:" << name << (isNumeric ? "(number)" : "(text)");
+    return id;
+}
+
+TickerRowData TickerDataTableModel::makeRow(const PendingUpdate& update) {
+    TickerRowData row;
+    row.key = generateKey(update.symbol, update.model);
+    row.symbol = update.symbol;
+    row.model = update.model;
+    row.lastUpdateTime = update.receiveTime;
+    row.timestampText = QDateTime::fromMSecsSinceEpoch(update.receiveTime).toString(Qt::ISODateWithMs);
+    row.numbers.fill(qQNaN(), m_numberSlots);
+    row.texts.resize(m_textSlots);
+
+    for (auto it = update.fields.cbegin(); it != update.fields.cend(); ++it) {
+        const TickerColumn& column = m_columns.at(columnId(it.key(), it.value()));
+        if (column.type == TickerColumn::Type::Number) {
+            if (column.slot >= row.numbers.count()) {
+                row.numbers.resize(m_numberSlots, qQNaN()); // Column added by this update
+            }
+            bool ok = false;
+            const double value = it.value().toDouble(&ok);
+            row.numbers[column.slot] = ok ? value : qQNaN();
+        }
+        else if (column.type == TickerColumn::Type::Text) {
+            if (column.slot >= row.texts.count()) {
+                row.texts.resize(m_textSlots);
+            }
+            row.texts[column.slot] = it.value().toString();
+        }
+        // Symbol, Model and Timestamp come from the update itself
+    }
+    return row;
+}
+
+
+void TickerDataTableModel::handleTickerDataReceived(const QString& symbol, const QString& model, const QVariantMap& data) {
+    // Crucial: Check if the symbol is currently active in the data manager
+    if (m_dataManager->getSymbolState(symbol, model) != SymbolDataManager::SymbolState::Active) {
+        // qInfo() << "Ignoring data for paused/removed symbol:" << symbol << model;
+        return; // Ignore data for paused or non-existent symbols
+    }
+
+    // Prepare data for batching
+    QString key = generateKey(symbol, model);
+    PendingUpdate updateData;
+    updateData.symbol = symbol;
+    updateData.model = model;
+    updateData.fields = data;
+    updateData.receiveTime = QDateTime::currentMSecsSinceEpoch(); // Use arrival time
+
+    { // Lock scope for pending updates map
+        QMutexLocker locker(&m_pendingUpdatesMutex);
+        m_pendingUpdates[key] = updateData; // Overwrite previous pending update for the same key
+    }
+
+    // Start or restart the timer to process the batch soon
+    if (!m_updateTimer.isActive()) {
+        m_updateTimer.start();
+    }
+}
+
+void TickerDataTableModel::processPendingUpdates() {
+    QMap<QString, PendingUpdate> updatesToProcess;
+    QSet<QString> removalsToProcess;
+    { // Lock scope
+        QMutexLocker locker(&m_pendingUpdatesMutex);
+        if (m_pendingUpdates.isEmpty() && m_pendingRemovals.isEmpty()) {
+            return; // Nothing to process
+        }
+        updatesToProcess = std::move(m_pendingUpdates); // Move data out efficiently
+        m_pendingUpdates.clear(); // Clear the original map
+        removalsToProcess = std::move(m_pendingRemovals);
+        m_pendingRemovals.clear();
+    }
+
+    // Removals first: an update queued after a removal re-adds the row
+    if (!removalsToProcess.isEmpty()) {
+        clearHighlight(); // Its ranges are stale once rows move
+        removeKeys(removalsToProcess);
+    }
+
+    // Process updates (add or update rows); fields seen for the first time add their column
+    ++m_batch;
+    QList<CellRange> changedCells;
+    QList<TickerRowData> newRows;
+    for (const auto& update : std::as_const(updatesToProcess)) {
+        TickerRowData row = makeRow(update);
+        if (!updateRow(row, changedCells)) {
+            newRows.append(std::move(row));
+        }
+    }
+    appendRows(std::move(newRows));
+    if (changedCells.isEmpty()) {
+        return;
+    }
+
+    // Repaint only the changed cells
+    if (m_highlightChanges) {
+        clearHighlight(); // Cells of the previous batch
+        m_highlightBatch = m_batch;
+        m_highlightedRanges = emitChangedRanges(std::move(changedCells), { Qt::DisplayRole, Qt::BackgroundRole });
+        m_highlightTimer.start();
+    }
+    else {
+        emitChangedRanges(std::move(changedCells), { Qt::DisplayRole });
+    }
+}
+
+QList<TickerDataTableModel::CellRange> TickerDataTableModel::emitChangedRanges(QList<CellRange> changedCells, const QList<int>& roles) {
+    // Grouped by columns, then by row: a run of adjacent rows with the same columns is one rectangle
+    std::sort(changedCells.begin(), changedCells.end(), [](const CellRange& a, const CellRange& b) {
+        return std::tie(a.left, a.right, a.top) < std::tie(b.left, b.right, b.top);
+    });
+
+    QList<CellRange> ranges;
+    for (const CellRange& cells : std::as_const(changedCells)) {
+        if (!ranges.isEmpty()) {
+            CellRange& last = ranges.last();
+            if (last.left == cells.left && last.right == cells.right && last.bottom + 1 == cells.top) {
+                last.bottom = cells.bottom;
+                continue;
+            }
+        }
+        ranges.append(cells);
+    }
+
+    for (const CellRange& range : std::as_const(ranges)) {
+        emit dataChanged(index(range.top, range.left), index(range.bottom, range.right), roles);
+    }
+    return ranges;
+}
+
+void TickerDataTableModel::clearHighlight() {
+    m_highlightBatch = 0;
+    const int lastRow = m_tickerData.count() - 1;
+    for (const CellRange& range : std::as_const(m_highlightedRanges)) {
+        // Rows removed since: the view already repainted the rows that moved
+        const int bottom = qMin(range.bottom, lastRow);
+        if (range.top <= bottom) {
+            emit dataChanged(index(range.top, range.left), index(bottom, range.right), { Qt::BackgroundRole });
+        }
+    }
+    m_highlightedRanges.clear();
+}
+
+bool TickerDataTableModel::cellChanged(const TickerColumn& column, const TickerRowData& oldData, const TickerRowData& newData) const {
+    switch (column.type) {
+    case TickerColumn::Type::Symbol:
+    case TickerColumn::Type::Model:
+        return false; // Row key
+    case TickerColumn::Type::Timestamp:
+        return oldData.lastUpdateTime != newData.lastUpdateTime;
+    case TickerColumn::Type::Number: {
+        // A row may predate the column (shorter array): no value
+        const double before = column.slot < oldData.numbers.count() ? oldData.numbers.at(column.slot) : qQNaN();
+        const double after = column.slot < newData.numbers.count() ? newData.numbers.at(column.slot) : qQNaN();
+        return before != after && !(qIsNaN(before) && qIsNaN(after));
+    }
+    case TickerColumn::Type::Text: {
+        const QString before = column.slot < oldData.texts.count() ? oldData.texts.at(column.slot) : QString();
+        const QString after = column.slot < newData.texts.count() ? newData.texts.at(column.slot) : QString();
+        return before != after;
+    }
+    }
+    return false;
+}
+
+
+bool TickerDataTableModel::updateRow(TickerRowData& newData, QList<CellRange>& changedCells) {
+    const auto it = m_rowMap.constFind(newData.key);
+    if (it == m_rowMap.constEnd()) {
+        return false;
+    }
+
+    // Diff against the displayed values: one range per run of changed columns
+    const int rowIndex = it.value();
+    TickerRowData& oldData = m_tickerData[rowIndex];
+    const int columns = m_columns.count();
+    newData.changedBatch = std::move(oldData.changedBatch);
+    newData.changedBatch.resize(columns);
+    int runStart = -1;
+    for (int column = 0; column <= columns; ++column) {
+        if (column < columns && cellChanged(m_columns.at(column), oldData, newData)) {
+            newData.changedBatch[column] = m_batch;
+            if (runStart < 0) runStart = column;
+        }
+        else if (runStart >= 0) {
+            changedCells.append({ rowIndex, rowIndex, runStart, column - 1 });
+            runStart = -1;
+        }
+    }
+    oldData = std::move(newData); // Replace data
+    return true;
+}
+
+void TickerDataTableModel::appendRows(QList<TickerRowData> newRows) {
+    if (newRows.isEmpty()) {
+        return;
+    }
+
+    // One insert signal for the whole batch
+    const int first = m_tickerData.count();
+    beginInsertRows(QModelIndex(), first, first + int(newRows.count()) - 1);
+    m_tickerData.reserve(first + newRows.count());
+    for (TickerRowData& row : newRows) {
+        m_rowMap.insert(row.key, int(m_tickerData.count()));
+        m_tickerData.append(std::move(row));
+    }
+    endInsertRows();
+}
+
+void TickerDataTableModel::queueRemoval(const QString& symbol, const QString& model) {
+    const QString key = generateKey(symbol, model);
+    { // Lock scope
+        QMutexLocker locker(&m_pendingUpdatesMutex);
+        m_pendingUpdates.remove(key); // Received before the removal: must not bring the row back
+        m_pendingRemovals.insert(key);
+    }
+
+    if (!m_updateTimer.isActive()) {
+        m_updateTimer.start();
+    }
+}
+
+void TickerDataTableModel::removeKeys(const QSet<QString>& keys) {
+    QList<int> rows;
+    rows.reserve(keys.count());
+    for (const QString& key : keys) {
+        const auto it = m_rowMap.constFind(key);
+        if (it != m_rowMap.constEnd()) {
+            rows.append(it.value());
+            m_rowMap.erase(it);
+        }
+    }
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    // Contiguous runs, last first so the indices of the runs still to remove do not move
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    for (qsizetype i = 0; i < rows.count();) {
+        const int last = rows.at(i);
+        int first = last;
+        while (++i < rows.count() && rows.at(i) == first - 1) {
+            first = rows.at(i);
+        }
+        beginRemoveRows(QModelIndex(), first, last);
+        m_tickerData.remove(first, last - first + 1);
+        endRemoveRows();
+    }
+
+    // Only the rows after the first removed one moved: re-index them once for the whole batch
+    for (int row = rows.last(); row < m_tickerData.count(); ++row) {
+        m_rowMap[m_tickerData.at(row).key] = row;
+    }
+}
+
+// --- Slots reacting to symbol list changes ---
+
+void TickerDataTableModel::handleSymbolRemoved(const QString& symbol, const QString& model) {
+    // If a symbol is removed from the watchlist, remove its row from the table (with the next batch)
+    queueRemoval(symbol, model);
+}
+
+void TickerDataTableModel::handleSymbolStateChanged(const QString& symbol, const QString& model, SymbolDataManager::SymbolState newState) {
+    // If a symbol is paused, remove its row from the table (with the next batch)
+    if (newState == SymbolDataManager::SymbolState::Paused) {
+        queueRemoval(symbol, model);
+    }
+    // If it's resumed, data will start flowing again via handleTickerDataReceived,
+    // which will re-add the row if it's not present. No action needed here for resume.
 }
\ No newline at end of file
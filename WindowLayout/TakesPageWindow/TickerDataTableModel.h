@@ -1,62 +1,126 @@
-#pragma once
-
-#include "Data/SymbolDataManager.h"
-
-#include <QAbstractTableModel>
-#include <QList>
-#include <QMap>
-#include <QVariantMap>
-#include <QStringList>
-#include <QTimer> 
-#include <QMutex> 
-
-// Represents one row in the table
-struct TickerRowData {
-    QString symbol;
-    QString model;
-    QMap<QString, QVariant> fields; // FieldName -> Value
-    qint64 lastUpdateTime = 0; // Timestamp for sorting or highlighting
-};
-
-
-class TickerDataTableModel : public QAbstractTableModel {
-    Q_OBJECT
-
-public:
-    explicit TickerDataTableModel(SymbolDataManager* dataManager, QObject* parent = nullptr);
-    ~TickerDataTableModel() override = default;
-
-    // QAbstractTableModel overrides
-    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
-    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
-    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
-    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
-
-public slots:
-    // Slot to receive data from WebSocket/DataManager
-    void handleTickerDataReceived(const QString& symbol, const QString& model, const QVariantMap& data);
-    // Slots to react to symbol list changes
-    void handleSymbolRemoved(const QString& symbol, const QString& model);
-    void handleSymbolStateChanged(const QString& symbol, const QString& model, SymbolDataManager::SymbolState newState);
-
-private slots:
-    void processPendingUpdates(); // Process batched updates
-
-private:
-    SymbolDataManager* m_dataManager; // To check if symbol is active
-
-    QStringList m_headers; // Dynamic list of column headers (e.g., Symbol, Model, Price, Size, Time, ...)
-    QList<TickerRowData> m_tickerData; // Holds all rows currently displayed
-    QMap<QString, int> m_rowMap; // Map key (symbol_model) to row index for fast updates
-
-    // Batching updates to avoid excessive UI refreshes
-    QTimer m_updateTimer;
-    QMap<QString, TickerRowData> m_pendingUpdates; // Key: symbol_model
-    QMutex m_pendingUpdatesMutex; // Protect pending updates if accessed from different threads
-
-
-    void updateHeaders(const QVariantMap& dataSample);
-    void addOrUpdateRow(const TickerRowData& newData);
-    void removeRow(const QString& symbol, const QString& model);
-    QString generateKey(const QString& symbol, const QString& model) const;
-};
+#pragma once
+
+#include "Data/SymbolDataManager.h"
+
+#include <QAbstractTableModel>
+#include <QList>
+#include <QHash>
+#include <QSet>
+#include <QMap>
+#include <QVariantMap>
+#include <QStringList>
+#include <QTimer> 
+#include <QMutex> 
+
+// One column of the table. Its id is its column index: ids are assigned in order of first appearance
+// of a field and never change, so data() indexes straight into the typed arrays of a row.
+struct TickerColumn {
+    enum class Type : quint8 {
+        Symbol,    // TickerRowData::symbol
+        Model,     // TickerRowData::model
+        Timestamp, // TickerRowData::lastUpdateTime
+        Number,    // TickerRowData::numbers[slot] (NaN = no value), right-aligned
+        Text       // TickerRowData::texts[slot]
+    };
+
+    QString name; // Header and field name
+    Type type = Type::Text;
+    int slot = -1; // Index into the array of 'type' (Number, Text)
+};
+
+// Represents one row in the table
+struct TickerRowData {
+    QString key; // symbol_model
+    QString symbol;
+    QString model;
+    QList<double> numbers; // Number fields by TickerColumn::slot (may be shorter than the column count: no value)
+    QStringList texts;     // Text fields by TickerColumn::slot (idem)
+    qint64 lastUpdateTime = 0; // Timestamp for sorting or highlighting
+    QString timestampText;     // lastUpdateTime formatted once per update instead of once per paint
+    QList<quint32> changedBatch; // By column id: update batch that last changed the cell (0 = none), for the highlight
+};
+
+
+class TickerDataTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit TickerDataTableModel(SymbolDataManager* dataManager, QObject* parent = nullptr);
+    ~TickerDataTableModel() override = default;
+
+    // QAbstractTableModel overrides
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // Cells changed by the latest update batch get a background (Qt::BackgroundRole) for HIGHLIGHT_MS. Off by default.
+    void setHighlightChanges(bool enabled);
+
+public slots:
+    // Slot to receive data from WebSocket/DataManager
+    void handleTickerDataReceived(const QString& symbol, const QString& model, const QVariantMap& data);
+    // Slots to react to symbol list changes
+    void handleSymbolRemoved(const QString& symbol, const QString& model);
+    void handleSymbolStateChanged(const QString& symbol, const QString& model, SymbolDataManager::SymbolState newState);
+
+private slots:
+    void processPendingUpdates(); // Process batched updates
+    void clearHighlight();
+
+private:
+    SymbolDataManager* m_dataManager; // To check if symbol is active
+
+    // Column registry: Symbol, Model, Timestamp, then the data fields (e.g., Price, Size, ...) as they appear
+    QList<TickerColumn> m_columns; // By column id
+    QHash<QString, int> m_columnIds; // Field name -> column id
+    int m_numberSlots = 0;
+    int m_textSlots = 0;
+
+    QList<TickerRowData> m_tickerData; // Holds all rows currently displayed
+    QHash<QString, int> m_rowMap; // Map key (symbol_model) to row index for fast updates
+
+    // Received update, typed when applied on the GUI thread (where the column registry lives)
+    struct PendingUpdate {
+        QString symbol;
+        QString model;
+        QVariantMap fields;
+        qint64 receiveTime = 0;
+    };
+
+    // Batching updates to avoid excessive UI refreshes
+    QTimer m_updateTimer;
+    QMap<QString, PendingUpdate> m_pendingUpdates; // Key: symbol_model
+    QSet<QString> m_pendingRemovals; // Keys of rows to remove with the next batch
+    QMutex m_pendingUpdatesMutex; // Protect pending updates if accessed from different threads
+
+    // Rectangle of cells: rows top..bottom, columns left..right
+    struct CellRange {
+        int top;
+        int bottom;
+        int left;
+        int right;
+    };
+
+    quint32 m_batch = 0; // Id of the latest applied update batch
+    bool m_highlightChanges = false;
+    quint32 m_highlightBatch = 0; // Batch whose changed cells are highlighted (0 = none)
+    QList<CellRange> m_highlightedRanges; // Repainted when the highlight ends
+    QTimer m_highlightTimer;
+
+    void addColumn(const QString& name, TickerColumn::Type type);
+    // Column id of field 'name', registered (typed after 'sample') the first time it is seen
+    int columnId(const QString& name, const QVariant& sample);
+    TickerRowData makeRow(const PendingUpdate& update);
+    // Replaces the row of 'newData' and appends its changed cells (one range per run of columns) to 'changedCells'.
+    // False if there is no such row.
+    bool updateRow(TickerRowData& newData, QList<CellRange>& changedCells);
+    void appendRows(QList<TickerRowData> newRows); // One insert signal for all
+    void queueRemoval(const QString& symbol, const QString& model);
+    // One remove signal per contiguous run of rows, one re-index of the moved rows
+    void removeKeys(const QSet<QString>& keys);
+    bool cellChanged(const TickerColumn& column, const TickerRowData& oldData, const TickerRowData& newData) const;
+    // Merges single-row ranges into rectangles (same columns, adjacent rows), one dataChanged each
+    QList<CellRange> emitChangedRanges(QList<CellRange> changedCells, const QList<int>& roles);
+    QString generateKey(const QString& symbol, const QString& model) const;
+};
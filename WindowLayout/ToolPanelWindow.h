@@ -1,22 +1,23 @@
-#pragma once
-
-#include "BaseWindow.h"
-
-class WindowManager;
-
-class ToolPanelWindow : public BaseWindow
-{
-    Q_OBJECT
-public:
-    ToolPanelWindow(WindowManager* manager, QWidget* parent = nullptr);
-
-private slots:
-    void buttonClicked();
-    void showAllWindows();
-    void openChartWindow();
-    void openTakesWindow();
-    void exitApp();
-
-private:
-    WindowManager* windowManager = nullptr;
-};
+#pragma once
+
+#include "BaseWindow.h"
+
+class WindowManager;
+
+class ToolPanelWindow : public BaseWindow
+{
+    Q_OBJECT
+public:
+    ToolPanelWindow(WindowManager* manager, QWidget* parent = nullptr);
+
+private slots:
+    void buttonClicked();
+    void showAllWindows();
+    void openChartWindow();
+    void openTakesWindow();
+    void openPerfDashboardWindow();
+    void exitApp();
+
+private:
+    WindowManager* windowManager = nullptr;
+};
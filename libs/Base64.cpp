@@ -0,0 +1,353 @@
+#include "Base64.h"
+
+#include <array>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define DA_BASE64_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define DA_BASE64_X86 0
+#endif
+
+// MSVC compiles any intrinsic without /arch; GCC/Clang need the target per function
+#if DA_BASE64_X86 && !defined(_MSC_VER)
+#define DA_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define DA_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DA_TARGET_SSE41
+#define DA_TARGET_AVX2
+#endif
+
+namespace Base64 {
+
+namespace {
+
+    constexpr int8_t Invalid = -1;
+    constexpr int8_t Skip = -2;    // Whitespace
+    constexpr int8_t Padding = -3; // '='
+
+    constexpr std::array<int8_t, 256> makeTable() {
+        std::array<int8_t, 256> table{};
+        for (int c = 0; c < 256; ++c) table[c] = Invalid;
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; ++i) table[static_cast<unsigned char>(alphabet[i])] = static_cast<int8_t>(i);
+        table['\r'] = table['\n'] = table['\t'] = table[' '] = Skip;
+        table['='] = Padding;
+        return table;
+    }
+    constexpr std::array<int8_t, 256> DecodeTable = makeTable();
+
+    // Decodes [src, end) starting on a 4-character boundary. Handles whitespace, padding and the tail.
+    template <typename CharT>
+    qsizetype decodeScalar(const CharT* src, const CharT* end, char* dst) {
+        char* out = dst;
+        uint32_t acc = 0;
+        int count = 0;   // Characters in 'acc'
+        int padding = 0;
+
+        for (; src < end; ++src) {
+            const uint32_t c = static_cast<std::make_unsigned_t<CharT>>(*src);
+            if (c > 0xFF) return -1;
+            const int8_t v = DecodeTable[c];
+            if (v >= 0) {
+                if (padding) return -1; // Data after padding
+                acc = (acc << 6) | uint32_t(v);
+                if (++count == 4) {
+                    *out++ = char(acc >> 16);
+                    *out++ = char(acc >> 8);
+                    *out++ = char(acc);
+                    acc = 0;
+                    count = 0;
+                }
+            }
+            else if (v == Padding) {
+                if (++padding > 2) return -1;
+            }
+            else if (v != Skip) {
+                return -1;
+            }
+        }
+
+        if (padding && count + padding != 4) return -1;
+        switch (count) {
+        case 0:
+            break;
+        case 2:
+            *out++ = char(acc >> 4);
+            break;
+        case 3:
+            *out++ = char(acc >> 10);
+            *out++ = char(acc >> 2);
+            break;
+        default:
+            return -1; // A single dangling character
+        }
+        return out - dst;
+    }
+
+    qsizetype decodeScalarBytes(const char* src, qsizetype length, char* dst) {
+        return decodeScalar(src, src + length, dst);
+    }
+
+    qsizetype decodeScalarUtf16(const char16_t* src, qsizetype length, char* dst) {
+        return decodeScalar(src, src + length, dst);
+    }
+
+#if DA_BASE64_X86
+
+    // --- SSE4.1: 16 characters -> 12 bytes per step ---
+    // Translation and validation with nibble lookups (W. Mula, "Base64 decoding with SIMD instructions").
+
+    DA_TARGET_SSE41 inline bool translate(__m128i input, __m128i& values) {
+        const __m128i higherNibble = _mm_and_si128(_mm_srli_epi32(input, 4), _mm_set1_epi8(0x0f));
+        const __m128i lowerNibble = _mm_and_si128(input, _mm_set1_epi8(0x0f));
+
+        const __m128i shiftLut = _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i maskLut = _mm_setr_epi8(
+            char(0xa8), char(0xf8), char(0xf8), char(0xf8), char(0xf8), char(0xf8), char(0xf8), char(0xf8),
+            char(0xf8), char(0xf8), char(0xf0), char(0x54), char(0x50), char(0x50), char(0x50), char(0x54));
+        const __m128i bitposLut = _mm_setr_epi8(
+            0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, char(0x80), 0, 0, 0, 0, 0, 0, 0, 0);
+
+        const __m128i shiftByNibble = _mm_shuffle_epi8(shiftLut, higherNibble);
+        const __m128i isSlash = _mm_cmpeq_epi8(input, _mm_set1_epi8(0x2f));
+        const __m128i shift = _mm_blendv_epi8(shiftByNibble, _mm_set1_epi8(16), isSlash);
+
+        const __m128i mask = _mm_shuffle_epi8(maskLut, lowerNibble);
+        const __m128i bit = _mm_shuffle_epi8(bitposLut, higherNibble);
+        const __m128i nonMatch = _mm_cmpeq_epi8(_mm_and_si128(mask, bit), _mm_setzero_si128());
+        if (_mm_movemask_epi8(nonMatch)) {
+            return false; // Padding, whitespace or invalid: scalar path decides
+        }
+        values = _mm_add_epi8(input, shift);
+        return true;
+    }
+
+    // 16 x 6 bits -> 12 bytes in the low part of the register
+    DA_TARGET_SSE41 inline __m128i pack(__m128i values) {
+        const __m128i mergedPairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i merged = _mm_madd_epi16(mergedPairs, _mm_set1_epi32(0x00011000));
+        return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    }
+
+    DA_TARGET_SSE41 inline __m128i load16(const char* src) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    }
+
+    // UTF-16 -> bytes; code units above 0xFF saturate to 0x00/0xFF, both rejected by translate()
+    DA_TARGET_SSE41 inline __m128i load16(const char16_t* src) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 8));
+        return _mm_packus_epi16(lo, hi);
+    }
+
+    template <typename CharT>
+    DA_TARGET_SSE41 qsizetype decodeSse41(const CharT* src, qsizetype length, char* dst) {
+        const CharT* end = src + length;
+        char* out = dst;
+        char* const outEnd = dst + decodedSizeBound(length);
+
+        // Each step stores 16 bytes (12 valid): keep 16 bytes of room
+        while (end - src >= 16 && outEnd - out >= 16) {
+            __m128i values;
+            if (!translate(load16(src), values)) break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), pack(values));
+            src += 16;
+            out += 12;
+        }
+
+        const qsizetype tail = decodeScalar(src, end, out);
+        return tail < 0 ? -1 : (out - dst) + tail;
+    }
+
+    // --- AVX2: 32 characters -> 24 bytes per step, same lookups per 128-bit lane ---
+
+    DA_TARGET_AVX2 inline bool translate(__m256i input, __m256i& values) {
+        const __m256i higherNibble = _mm256_and_si256(_mm256_srli_epi32(input, 4), _mm256_set1_epi8(0x0f));
+        const __m256i lowerNibble = _mm256_and_si256(input, _mm256_set1_epi8(0x0f));
+
+        const __m256i shiftLut = _mm256_setr_epi8(
+            0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m256i maskLut = _mm256_setr_epi8(
+            char(0xa8), char(0xf8), char(0xf8), char(0xf8), char(0xf8), char(0xf8), char(0xf8), char(0xf8),
+            char(0xf8), char(0xf8), char(0xf0), char(0x54), char(0x50), char(0x50), char(0x50), char(0x54),
+            char(0xa8), char(0xf8), char(0xf8), char(0xf8), char(0xf8), char(0xf8), char(0xf8), char(0xf8),
+            char(0xf8), char(0xf8), char(0xf0), char(0x54), char(0x50), char(0x50), char(0x50), char(0x54));
+        const __m256i bitposLut = _mm256_setr_epi8(
+            0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, char(0x80), 0, 0, 0, 0, 0, 0, 0, 0,
+            0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, char(0x80), 0, 0, 0, 0, 0, 0, 0, 0);
+
+        const __m256i shiftByNibble = _mm256_shuffle_epi8(shiftLut, higherNibble);
+        const __m256i isSlash = _mm256_cmpeq_epi8(input, _mm256_set1_epi8(0x2f));
+        const __m256i shift = _mm256_blendv_epi8(shiftByNibble, _mm256_set1_epi8(16), isSlash);
+
+        const __m256i mask = _mm256_shuffle_epi8(maskLut, lowerNibble);
+        const __m256i bit = _mm256_shuffle_epi8(bitposLut, higherNibble);
+        const __m256i nonMatch = _mm256_cmpeq_epi8(_mm256_and_si256(mask, bit), _mm256_setzero_si256());
+        if (_mm256_movemask_epi8(nonMatch)) {
+            return false;
+        }
+        values = _mm256_add_epi8(input, shift);
+        return true;
+    }
+
+    // 32 x 6 bits -> 24 contiguous bytes
+    DA_TARGET_AVX2 inline __m256i pack(__m256i values) {
+        const __m256i mergedPairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        const __m256i merged = _mm256_madd_epi16(mergedPairs, _mm256_set1_epi32(0x00011000));
+        const __m256i lanes = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        return _mm256_permutevar8x32_epi32(lanes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+    }
+
+    DA_TARGET_AVX2 inline __m256i load32(const char* src) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    }
+
+    DA_TARGET_AVX2 inline __m256i load32(const char16_t* src) {
+        const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 16));
+        // packus works per 128-bit lane: restore the character order
+        return _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+    }
+
+    template <typename CharT>
+    DA_TARGET_AVX2 qsizetype decodeAvx2(const CharT* src, qsizetype length, char* dst) {
+        const CharT* end = src + length;
+        char* out = dst;
+        char* const outEnd = dst + decodedSizeBound(length);
+
+        // Each step stores 32 bytes (24 valid): keep 32 bytes of room
+        while (end - src >= 32 && outEnd - out >= 32) {
+            __m256i values;
+            if (!translate(load32(src), values)) break;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), pack(values));
+            src += 32;
+            out += 24;
+        }
+
+        const qsizetype tail = decodeScalar(src, end, out);
+        return tail < 0 ? -1 : (out - dst) + tail;
+    }
+
+    struct CpuFeatures {
+        bool sse41 = false;
+        bool avx2 = false;
+    };
+
+    CpuFeatures detectCpu() {
+        CpuFeatures features;
+        unsigned regs1[4] = {};
+        unsigned regs7[4] = {};
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+        __cpuid(info, 1);
+        for (int i = 0; i < 4; ++i) regs1[i] = unsigned(info[i]);
+        if (maxLeaf >= 7) {
+            __cpuidex(info, 7, 0);
+            for (int i = 0; i < 4; ++i) regs7[i] = unsigned(info[i]);
+        }
+#else
+        const unsigned maxLeaf = __get_cpuid_max(0, nullptr);
+        __get_cpuid(1, &regs1[0], &regs1[1], &regs1[2], &regs1[3]);
+        if (maxLeaf >= 7) {
+            __get_cpuid_count(7, 0, &regs7[0], &regs7[1], &regs7[2], &regs7[3]);
+        }
+#endif
+        const bool ssse3 = regs1[2] & (1u << 9);
+        features.sse41 = ssse3 && (regs1[2] & (1u << 19));
+
+        // AVX2 also needs the OS to save the YMM registers (OSXSAVE + XCR0 bits 1 and 2)
+        const bool osxsave = regs1[2] & (1u << 27);
+        const bool avx = regs1[2] & (1u << 28);
+        if (osxsave && avx) {
+#if defined(_MSC_VER)
+            const unsigned long long xcr0 = _xgetbv(0);
+#else
+            unsigned lo = 0, hi = 0;
+            __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            const unsigned long long xcr0 = (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+            features.avx2 = ((xcr0 & 0x6) == 0x6) && (regs7[1] & (1u << 5));
+        }
+        return features;
+    }
+
+#endif // DA_BASE64_X86
+
+    struct Implementation {
+        qsizetype (*bytes)(const char*, qsizetype, char*) = decodeScalarBytes;
+        qsizetype (*utf16)(const char16_t*, qsizetype, char*) = decodeScalarUtf16;
+        const char* name = "scalar";
+    };
+
+    const Implementation& implementation() {
+        static const Implementation impl = []() {
+            Implementation selected;
+#if DA_BASE64_X86
+            const CpuFeatures cpu = detectCpu();
+            if (cpu.avx2) {
+                selected.bytes = decodeAvx2<char>;
+                selected.utf16 = decodeAvx2<char16_t>;
+                selected.name = "avx2";
+            }
+            else if (cpu.sse41) {
+                selected.bytes = decodeSse41<char>;
+                selected.utf16 = decodeSse41<char16_t>;
+                selected.name = "sse4.1";
+            }
+#endif
+            return selected;
+        }();
+        return impl;
+    }
+
+} // namespace
+
+qsizetype decode(const char* src, qsizetype length, char* dst) {
+    if (length <= 0) return 0;
+    return implementation().bytes(src, length, dst);
+}
+
+qsizetype decode(const char16_t* src, qsizetype length, char* dst) {
+    if (length <= 0) return 0;
+    return implementation().utf16(src, length, dst);
+}
+
+bool decode(const QString& text, QByteArray& out) {
+    out.resize(decodedSizeBound(text.size()));
+    const qsizetype size = decode(reinterpret_cast<const char16_t*>(text.utf16()), text.size(), out.data());
+    if (size < 0) {
+        out.resize(0);
+        return false;
+    }
+    out.resize(size);
+    return true;
+}
+
+bool decode(const char* src, qsizetype length, QByteArray& out) {
+    out.resize(decodedSizeBound(length));
+    const qsizetype size = decode(src, length, out.data());
+    if (size < 0) {
+        out.resize(0);
+        return false;
+    }
+    out.resize(size);
+    return true;
+}
+
+const char* implementationName() {
+    return implementation().name;
+}
+
+} // namespace Base64
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+// Vectorised base64 decoder for the 'data_compressed' field.
+//
+// QByteArray::fromBase64(str.toLatin1()) walks a multi-MB payload twice and allocates an
+// intermediate Latin-1 copy. Base64::decode reads the message text directly (UTF-8 bytes or the
+// UTF-16 of a QString) and writes into a caller supplied buffer in a single pass.
+//
+// Implementation is picked once at runtime: AVX2 (32 chars/step), SSE4.1 (16 chars/step) or a
+// table driven scalar loop. Vector blocks that contain anything but the 64 base64 characters
+// (padding, line breaks) are finished by the scalar loop, so results are identical on every path.
+//
+// Accepted input: standard alphabet, optional '=' padding, CR/LF/TAB/space are skipped.
+// Anything else is an error (unlike fromBase64, which silently drops invalid characters).
+namespace Base64 {
+
+    // Output bytes needed for 'length' input characters (upper bound)
+    constexpr qsizetype decodedSizeBound(qsizetype length) { return (length + 3) / 4 * 3; }
+
+    // Decodes into 'dst' (at least decodedSizeBound(length) bytes). Returns the decoded size, -1 on invalid input.
+    qsizetype decode(const char* src, qsizetype length, char* dst);
+    qsizetype decode(const char16_t* src, qsizetype length, char* dst);
+
+    // Decodes into 'out', reusing its capacity. Returns false on invalid input.
+    bool decode(const QString& text, QByteArray& out);
+    bool decode(const char* src, qsizetype length, QByteArray& out);
+
+    // Selected implementation: "avx2", "sse4.1" or "scalar"
+    const char* implementationName();
+
+} // namespace Base64
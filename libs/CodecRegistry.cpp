@@ -0,0 +1,383 @@
+#include "CodecRegistry.h"
+
+#include <QDir>
+#include <QFile>
+#include <QRegularExpression>
+#include <QtEndian>
+#include <algorithm>
+
+#if DA_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#if DA_HAVE_LZ4
+#include <lz4.h>
+#endif
+
+namespace Compressor {
+
+namespace {
+
+    constexpr qsizetype Lz4DictionaryWindow = 64 * 1024; // LZ4 only looks back 64 KB
+
+    // Per-thread decode state: zstd context and the pooled output buffer of zstd/LZ4
+    struct ThreadDecoder {
+        QByteArray buffer; // Only grows, like Inflater's buffer
+#if DA_HAVE_ZSTD
+        ZSTD_DCtx* zstd = nullptr;
+#endif
+        ~ThreadDecoder() {
+#if DA_HAVE_ZSTD
+            if (zstd) ZSTD_freeDCtx(zstd);
+#endif
+        }
+
+        // Sizes the pooled buffer for 'size' bytes, keeping its capacity
+        char* prepare(qsizetype size) {
+            buffer.resize(size); // data() below detaches if the previous result is still referenced
+            return buffer.data();
+        }
+
+        static ThreadDecoder& local() {
+            thread_local ThreadDecoder decoder;
+            return decoder;
+        }
+    };
+
+    void logUnavailable(Codec codec) {
+        Log.msg(FNAME + "Codec '" + codecName(codec) + "' is not compiled in.", Logger::Level::ERROR);
+    }
+
+} // namespace
+
+QString codecName(Codec codec) {
+    switch (codec) {
+    case Codec::Zlib: return "zlib";
+    case Codec::Zstd: return "zstd";
+    case Codec::Lz4: return "lz4";
+    }
+    return QString();
+}
+
+bool codecFromName(const QString& name, Codec& outCodec) {
+    const QString lower = name.trimmed().toLower();
+    if (lower.isEmpty() || lower == "zlib" || lower == "gzip") {
+        outCodec = Codec::Zlib;
+    }
+    else if (lower == "zstd") {
+        outCodec = Codec::Zstd;
+    }
+    else if (lower == "lz4") {
+        outCodec = Codec::Lz4;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+bool isCodecAvailable(Codec codec) {
+    switch (codec) {
+    case Codec::Zlib: return true;
+    case Codec::Zstd: return DA_HAVE_ZSTD;
+    case Codec::Lz4: return DA_HAVE_LZ4;
+    }
+    return false;
+}
+
+QStringList availableCodecNames() {
+    QStringList names;
+    // Preferred first: the server picks the first one it supports
+    for (Codec codec : { Codec::Zstd, Codec::Lz4, Codec::Zlib }) {
+        if (isCodecAvailable(codec)) names.append(codecName(codec));
+    }
+    return names;
+}
+
+CodecRegistry& CodecRegistry::instance() {
+    static CodecRegistry registry;
+    return registry;
+}
+
+CodecRegistry::~CodecRegistry() {
+    for (Dictionary* dict : m_dictionaries) {
+#if DA_HAVE_ZSTD
+        if (dict->zstdDDict) ZSTD_freeDDict(static_cast<ZSTD_DDict*>(dict->zstdDDict));
+#endif
+        delete dict;
+    }
+}
+
+int CodecRegistry::loadDictionaries(const QString& directory) {
+    QDir dir(directory);
+    if (!dir.exists()) {
+        Log.msg(FNAME + "Dictionary directory not found: " + directory, Logger::Level::WARNING);
+        return 0;
+    }
+
+    static const QRegularExpression namePattern("^([a-z0-9]+)-(\\d+)\\.dict$", QRegularExpression::CaseInsensitiveOption);
+    int loaded = 0;
+    const QStringList files = dir.entryList({ "*.dict" }, QDir::Files, QDir::Name);
+    for (const QString& fileName : files) {
+        const QRegularExpressionMatch match = namePattern.match(fileName);
+        Codec codec;
+        bool idOk = false;
+        const quint32 id = match.hasMatch() ? match.captured(2).toUInt(&idOk) : 0;
+        if (!match.hasMatch() || !codecFromName(match.captured(1), codec) || !idOk || id == 0) {
+            Log.msg(FNAME + "Skipping dictionary with unexpected name: " + fileName +
+                " (expected <codec>-<id>.dict)", Logger::Level::WARNING);
+            continue;
+        }
+
+        QFile file(dir.filePath(fileName));
+        if (!file.open(QIODevice::ReadOnly)) {
+            Log.msg(FNAME + "Cannot read dictionary: " + file.fileName(), Logger::Level::WARNING);
+            continue;
+        }
+        if (addDictionary(codec, id, file.readAll())) {
+            ++loaded;
+        }
+    }
+    Log.msg(FNAME + QString("Loaded %1 compression dictionaries from %2").arg(loaded).arg(directory), Logger::Level::INFO);
+    return loaded;
+}
+
+bool CodecRegistry::addDictionary(Codec codec, quint32 id, const QByteArray& dictionary) {
+    if (id == 0 || dictionary.isEmpty()) {
+        Log.msg(FNAME + "Dictionary id must be > 0 and content non-empty.", Logger::Level::WARNING);
+        return false;
+    }
+    if (codec == Codec::Zlib) {
+        Log.msg(FNAME + "zlib dictionaries are not supported, use zstd or lz4.", Logger::Level::WARNING);
+        return false;
+    }
+    if (!isCodecAvailable(codec)) {
+        logUnavailable(codec);
+        return false;
+    }
+
+    Dictionary* dict = new Dictionary;
+    dict->content = dictionary;
+#if DA_HAVE_ZSTD
+    if (codec == Codec::Zstd) {
+        dict->zstdDDict = ZSTD_createDDict(dictionary.constData(), dictionary.size());
+        if (!dict->zstdDDict) {
+            Log.msg(FNAME + QString("Invalid zstd dictionary %1").arg(id), Logger::Level::WARNING);
+            delete dict;
+            return false;
+        }
+    }
+#endif
+    if (codec == Codec::Lz4 && dict->content.size() > Lz4DictionaryWindow) {
+        dict->content = dict->content.right(Lz4DictionaryWindow);
+    }
+
+    QWriteLocker locker(&m_lock);
+    if (m_dictionaries.contains(dictKey(codec, id))) {
+        locker.unlock();
+        Log.msg(FNAME + QString("Dictionary %1-%2 already loaded, keeping the first one.")
+            .arg(codecName(codec)).arg(id), Logger::Level::WARNING);
+#if DA_HAVE_ZSTD
+        if (dict->zstdDDict) ZSTD_freeDDict(static_cast<ZSTD_DDict*>(dict->zstdDDict));
+#endif
+        delete dict;
+        return false;
+    }
+    m_dictionaries.insert(dictKey(codec, id), dict);
+    return true;
+}
+
+bool CodecRegistry::hasDictionary(Codec codec, quint32 id) const {
+    return dictionary(codec, id) != nullptr;
+}
+
+QList<quint32> CodecRegistry::dictionaryIds(Codec codec) const {
+    QReadLocker locker(&m_lock);
+    QList<quint32> ids;
+    for (auto it = m_dictionaries.constBegin(); it != m_dictionaries.constEnd(); ++it) {
+        if ((it.key() >> 32) == quint64(codec)) ids.append(static_cast<quint32>(it.key()));
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+const CodecRegistry::Dictionary* CodecRegistry::dictionary(Codec codec, quint32 id) const {
+    QReadLocker locker(&m_lock);
+    return m_dictionaries.value(dictKey(codec, id), nullptr);
+}
+
+QByteArray CodecRegistry::decompress(Codec codec, const char* data, qsizetype size, quint32 dictId, qsizetype sizeHint) {
+    if (!data || size <= 0) {
+        return QByteArray();
+    }
+    if (!isCodecAvailable(codec)) {
+        logUnavailable(codec);
+        return QByteArray();
+    }
+
+    const Dictionary* dict = nullptr;
+    if (dictId != 0) {
+        dict = dictionary(codec, dictId);
+        if (!dict) {
+            Log.msg(FNAME + QString("Unknown %1 dictionary id %2").arg(codecName(codec)).arg(dictId), Logger::Level::ERROR);
+            return QByteArray();
+        }
+    }
+
+    switch (codec) {
+    case Codec::Zlib:
+        return Inflater::local().inflate(data, size, sizeHint);
+
+    case Codec::Zstd: {
+#if DA_HAVE_ZSTD
+        const unsigned long long contentSize = ZSTD_getFrameContentSize(data, size);
+        if (contentSize == ZSTD_CONTENTSIZE_ERROR) {
+            Log.msg(FNAME + "Payload is not a zstd frame.", Logger::Level::ERROR);
+            return QByteArray();
+        }
+        if (contentSize == ZSTD_CONTENTSIZE_UNKNOWN && sizeHint <= 0) {
+            Log.msg(FNAME + "zstd frame without content size.", Logger::Level::ERROR);
+            return QByteArray();
+        }
+        // The content size comes from the frame header: checked before anything is allocated
+        if (contentSize != ZSTD_CONTENTSIZE_UNKNOWN && contentSize > quint64(MaxDecompressedSize)) {
+            Log.msg(FNAME + QString("zstd frame claims %1 bytes, more than %2, rejected.")
+                .arg(contentSize).arg(MaxDecompressedSize), Logger::Level::ERROR);
+            return QByteArray();
+        }
+        const qsizetype capacity = contentSize == ZSTD_CONTENTSIZE_UNKNOWN ? qMin(sizeHint, MaxDecompressedSize) : qsizetype(contentSize);
+
+        ThreadDecoder& decoder = ThreadDecoder::local();
+        if (!decoder.zstd) decoder.zstd = ZSTD_createDCtx(); // Reused for every frame of this thread
+        char* out = decoder.prepare(capacity);
+        const size_t produced = dict
+            ? ZSTD_decompress_usingDDict(decoder.zstd, out, capacity, data, size, static_cast<const ZSTD_DDict*>(dict->zstdDDict))
+            : ZSTD_decompressDCtx(decoder.zstd, out, capacity, data, size);
+        if (ZSTD_isError(produced)) {
+            Log.msg(FNAME + QString("zstd decompression failed: %1").arg(ZSTD_getErrorName(produced)), Logger::Level::ERROR);
+            return QByteArray();
+        }
+        decoder.buffer.resize(qsizetype(produced));
+        return decoder.buffer;
+#else
+        break;
+#endif
+    }
+
+    case Codec::Lz4: {
+#if DA_HAVE_LZ4
+        if (size < qsizetype(sizeof(quint32))) {
+            Log.msg(FNAME + "LZ4 payload is missing its raw size.", Logger::Level::ERROR);
+            return QByteArray();
+        }
+        const quint32 rawSize = qFromLittleEndian<quint32>(data);
+        const char* block = data + sizeof(quint32);
+        const int blockSize = int(size - qsizetype(sizeof(quint32)));
+        if (qsizetype(rawSize) > MaxDecompressedSize) {
+            Log.msg(FNAME + QString("LZ4 payload claims %1 bytes, more than %2, rejected.")
+                .arg(rawSize).arg(MaxDecompressedSize), Logger::Level::ERROR);
+            return QByteArray();
+        }
+
+        ThreadDecoder& decoder = ThreadDecoder::local();
+        char* out = decoder.prepare(rawSize);
+        const int produced = dict
+            ? LZ4_decompress_safe_usingDict(block, out, blockSize, int(rawSize), dict->content.constData(), int(dict->content.size()))
+            : LZ4_decompress_safe(block, out, blockSize, int(rawSize));
+        if (produced < 0 || quint32(produced) != rawSize) {
+            Log.msg(FNAME + QString("LZ4 decompression failed (%1 of %2 bytes).").arg(produced).arg(rawSize), Logger::Level::ERROR);
+            return QByteArray();
+        }
+        return decoder.buffer;
+#else
+        break;
+#endif
+    }
+    }
+    return QByteArray();
+}
+
+bool CodecRegistry::decompress(Codec codec, const char* data, qsizetype size, quint32 dictId, const Inflater::ChunkSink& sink) {
+    if (codec == Codec::Zlib && dictId == 0) {
+        return Inflater::local().inflate(data, size, sink);
+    }
+
+    QByteArray output = decompress(codec, data, size, dictId);
+    if (output.isNull()) {
+        return false;
+    }
+    return sink(output.constData(), output.size());
+}
+
+QByteArray CodecRegistry::compress(Codec codec, const QByteArray& data, int level, quint32 dictId) {
+    if (!isCodecAvailable(codec)) {
+        logUnavailable(codec);
+        return QByteArray();
+    }
+
+    const Dictionary* dict = nullptr;
+    if (dictId != 0) {
+        dict = dictionary(codec, dictId);
+        if (!dict) {
+            Log.msg(FNAME + QString("Unknown %1 dictionary id %2").arg(codecName(codec)).arg(dictId), Logger::Level::ERROR);
+            return QByteArray();
+        }
+    }
+
+    switch (codec) {
+    case Codec::Zlib:
+        return compressZlib(data, level);
+
+    case Codec::Zstd: {
+#if DA_HAVE_ZSTD
+        QByteArray out(qsizetype(ZSTD_compressBound(data.size())), Qt::Uninitialized);
+        ZSTD_CCtx* cctx = ZSTD_createCCtx();
+        const int zstdLevel = level < 0 ? ZSTD_CLEVEL_DEFAULT : level;
+        const size_t written = dict
+            ? ZSTD_compress_usingDict(cctx, out.data(), out.size(), data.constData(), data.size(),
+                dict->content.constData(), dict->content.size(), zstdLevel)
+            : ZSTD_compressCCtx(cctx, out.data(), out.size(), data.constData(), data.size(), zstdLevel);
+        ZSTD_freeCCtx(cctx);
+        if (ZSTD_isError(written)) {
+            Log.msg(FNAME + QString("zstd compression failed: %1").arg(ZSTD_getErrorName(written)), Logger::Level::ERROR);
+            return QByteArray();
+        }
+        out.resize(qsizetype(written));
+        return out;
+#else
+        break;
+#endif
+    }
+
+    case Codec::Lz4: {
+#if DA_HAVE_LZ4
+        // 'level' is not used: LZ4 is run at its default acceleration
+        const int bound = LZ4_compressBound(int(data.size()));
+        QByteArray out(qsizetype(sizeof(quint32)) + bound, Qt::Uninitialized);
+        qToLittleEndian<quint32>(quint32(data.size()), out.data());
+        char* block = out.data() + sizeof(quint32);
+
+        int written = 0;
+        if (dict) {
+            LZ4_stream_t* stream = LZ4_createStream();
+            LZ4_loadDict(stream, dict->content.constData(), int(dict->content.size()));
+            written = LZ4_compress_fast_continue(stream, data.constData(), block, int(data.size()), bound, 1);
+            LZ4_freeStream(stream);
+        }
+        else {
+            written = LZ4_compress_default(data.constData(), block, int(data.size()), bound);
+        }
+        if (written <= 0) {
+            Log.msg(FNAME + "LZ4 compression failed.", Logger::Level::ERROR);
+            return QByteArray();
+        }
+        out.resize(qsizetype(sizeof(quint32)) + written);
+        return out;
+#else
+        break;
+#endif
+    }
+    }
+    return QByteArray();
+}
+
+} // namespace Compressor
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QStringList>
+
+#include "Compressor.h"
+
+// zstd / LZ4 are optional: enabled when their headers are found (vcpkg: zstd, lz4),
+// or forced with DA_HAVE_ZSTD=0/1, DA_HAVE_LZ4=0/1 in the preprocessor definitions.
+#ifndef DA_HAVE_ZSTD
+#if __has_include(<zstd.h>)
+#define DA_HAVE_ZSTD 1
+#else
+#define DA_HAVE_ZSTD 0
+#endif
+#endif
+
+#ifndef DA_HAVE_LZ4
+#if __has_include(<lz4.h>)
+#define DA_HAVE_LZ4 1
+#else
+#define DA_HAVE_LZ4 0
+#endif
+#endif
+
+// Codec registry on top of Compressor: zlib (always), zstd and LZ4 (when compiled in).
+//
+// The codec of a 'data_stream' message is named by its "codec" envelope field ("zlib" when
+// absent) and an optional "dict" field selects a trained dictionary by id. The client lists the
+// codecs and dictionaries it can decode in the "hello" handshake.
+//
+// Payload layout per codec:
+//   zlib - zlib or gzip stream (Compressor::Inflater)
+//   zstd - one zstd frame (content size in the frame header)
+//   lz4  - u32 little-endian raw size followed by one LZ4 block
+//
+// Dictionaries are files named "<codec>-<id>.dict" (e.g. "zstd-1.dict") loaded from a directory.
+// A zstd dictionary is a trained one (zstd --train, or IngestBench --train-dict); an LZ4
+// dictionary is raw content, only its last 64 KB are used.
+namespace Compressor {
+
+    enum class Codec : quint8 {
+        Zlib = 0,
+        Zstd = 1,
+        Lz4 = 2
+    };
+
+    // Envelope name ("zlib", "zstd", "lz4")
+    QString codecName(Codec codec);
+    bool codecFromName(const QString& name, Codec& outCodec);
+    // True if the codec was compiled in
+    bool isCodecAvailable(Codec codec);
+    QStringList availableCodecNames();
+
+    class CodecRegistry {
+    public:
+        static CodecRegistry& instance();
+
+        // Loads every "<codec>-<id>.dict" file of 'directory'. Returns the number loaded.
+        int loadDictionaries(const QString& directory);
+        bool addDictionary(Codec codec, quint32 id, const QByteArray& dictionary);
+        bool hasDictionary(Codec codec, quint32 id) const;
+        // Ids of the loaded dictionaries of 'codec' (advertised in the hello handshake)
+        QList<quint32> dictionaryIds(Codec codec) const;
+
+        // Decompresses a whole payload. 'dictId' 0 = no dictionary.
+        // Zstd/LZ4 results share a per-thread pooled buffer, same contract as Inflater::inflate().
+        // Returns a null QByteArray on error.
+        QByteArray decompress(Codec codec, const char* data, qsizetype size, quint32 dictId = 0, qsizetype sizeHint = 0);
+
+        // Decompresses and hands the output to 'sink': zlib streams in chunks, zstd/LZ4 decode
+        // into the pooled buffer and hand it over in one call.
+        bool decompress(Codec codec, const char* data, qsizetype size, quint32 dictId, const Inflater::ChunkSink& sink);
+
+        // 'level' -1 = codec default. Used by the stand-in server and benchmarks.
+        QByteArray compress(Codec codec, const QByteArray& data, int level = -1, quint32 dictId = 0);
+
+    private:
+        CodecRegistry() = default;
+        ~CodecRegistry();
+        CodecRegistry(const CodecRegistry&) = delete;
+        CodecRegistry& operator=(const CodecRegistry&) = delete;
+
+        struct Dictionary {
+            QByteArray content;
+            void* zstdDDict = nullptr; // ZSTD_DDict*, built once, shared by all threads
+        };
+
+        static quint64 dictKey(Codec codec, quint32 id) { return (quint64(codec) << 32) | id; }
+        const Dictionary* dictionary(Codec codec, quint32 id) const;
+
+        QHash<quint64, Dictionary*> m_dictionaries; // Never removed, so lookups can hand out pointers
+        mutable QReadWriteLock m_lock;
+    };
+
+} // namespace Compressor
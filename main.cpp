@@ -1,157 +1,244 @@
-#include "Glob/Glob.h"
-#include "Glob/Logger.h"
-#include "Glob/Config.h"
-#include "WindowLayout/WindowManager.h"
-#include "WindowLayout/ToolPanelWindow.h"
-#include "WindowLayout/TakesPageWindow/TakesPageWindow.h"
-#include "WindowLayout/QuoteChartWindow.h"
-#include "WindowLayout/WatchlistWindow/WatchlistWindow.h"
-#include "WindowLayout/LogWindow.h"
-
-#include "Data/ClientReceiver.h"
-#include "Data/SymbolDataManager.h"
-#include "Network/WebSocketClient.h"
-
-#include <QApplication>
-#include <QStyleFactory>
-#include <QScreen>
-#include <QSessionManager>
-#include <QGuiApplication>
-#include <QObject>
-#include <QMessageBox>
-#include <QStandardPaths>
-
-QByteArray loadCsvDataFromFile(const QString& filename);
-QJsonObject generateTestDataFromCsv(const QByteArray& csvDataBytes);
-
-int main(int argc, char *argv[])
-{
-    QApplication app(argc, argv);
-
-    Config::initializeUserSettingsDefaults();
-
-    app.setStyle(QStyleFactory::create("Fusion"));
-
-    WindowManager windowManager;
-
-    LogWindow logWindow(&windowManager);
-    Log.init(logWindow.logWidget);
-    Log.msg(APP_VERSION);
-    Logger::Level logLevel = Config::getLogLevel(); // Get level from config
-    Log.msg("Using Log Level: " + Logger::levelToString(logLevel), Logger::Level::INFO);
-    Log.setLevel(logLevel);
-
-
-    QSettings pathFinder;
-    Log.msg("Window settings file location: " + pathFinder.fileName());
-
-    ///////////
-    // Data pipeline
-    // Create core components (ensure they exist before windows are created/restored)
-    Glob.dataManager = new SymbolDataManager(&app);
-    Glob.dataReceiver = new ClientReceiver();
-    Glob.wsClient = new WebSocketClient(&app);
-
-    Log.msg("Initiating WebSocket connection process...", Logger::Level::INFO);
-    QUrl webSocketUrl = Config::getWebSocketUrl();
-    Glob.wsClient->connectToServer(webSocketUrl); // Start connecting (will retry automatically)
-
-    QObject::connect(Glob.wsClient, &WebSocketClient::tickerDataReceived,
-                     Glob.dataReceiver, &ClientReceiver::processWebSocketMessage);
-
-    //Connect WS signals to UI for status updates-- -
-    QObject::connect(Glob.wsClient, &WebSocketClient::connected, [&]() {
-            Log.msg("Main: WebSocket Connected!", Logger::Level::INFO);
-            // update a status bar, enable UI elements
-            // toolPanel.updateWsStatus(true);
-        }
-    );
-    QObject::connect(Glob.wsClient, &WebSocketClient::disconnected, [&]() {
-            Log.msg("Main: WebSocket Disconnected! Reconnecting...", Logger::Level::WARNING);
-            // update status bar, disable UI elements
-            // toolPanel.updateWsStatus(false);
-        }
-    );
-    ///////////
-
-    // Main windows
-    ToolPanelWindow toolPanel(&windowManager);
-    WatchlistWindow watchlist(Glob.dataManager, Glob.wsClient, &windowManager);
-
-    windowManager.registerWindow(&toolPanel, "ToolPanel");
-    windowManager.registerWindow(&watchlist, "Watchlist");
-    windowManager.registerWindow(&logWindow, "LogWindow");
-
-    toolPanel.show(); // ensure that ToolPanel window always first in task bar
-    watchlist.show();
-    logWindow.show();
-
-    windowManager.restoreWindowStates();
-
-    QObject::connect(qApp, &QApplication::focusChanged,
-        &windowManager, &WindowManager::handleFocusChanged);
-
-    /////////////////////////
-    // --- Simulate receiving data (Optional - Keep for testing) ---
-    QString appPath = QCoreApplication::applicationDirPath();
-    QString csvFilePath = appPath + "/c2_update_volsmile_canvas__smile_to_be_plotted.csv";
-    Log.msg(QString("[main] Attempting to load test data from: %1").arg(csvFilePath), Logger::Level::DEBUG);
-    QByteArray csvBytes = loadCsvDataFromFile(csvFilePath);
-    if (!csvBytes.isEmpty()) {
-        QJsonObject testMessage = generateTestDataFromCsv(csvBytes);
-        QString type = testMessage.value("type").toString();
-        Log.msg(QString("B1: %1").arg(type), Logger::Level::DEBUG);
-        if (!testMessage.isEmpty()) {
-            QTimer::singleShot(150, Qt::CoarseTimer, [&, testMessage]() {
-                Log.msg("[main] Sending simulated WebSocket message to receiver...", Logger::Level::INFO);
-                QString type = testMessage.value("type").toString();
-                Log.msg(QString("B2: %1").arg(type), Logger::Level::DEBUG);
-                Glob.dataReceiver->processWebSocketMessage("AAPL", "SSVI", testMessage);
-                });
-        }
-        else { /* Log Warning */ }
-    }
-    else { /* Log Warning */ }
-    /////////////////////////
-
-    return app.exec();
-}
-
-//////////////////////////////////////////
-// For Local test
-
-#include "libs/Compressor.h"
-
-#include <vector>
-#include <QFile>
-#include <QDebug>
-
-// --- Test Data Generation Implementation ---
-QByteArray loadCsvDataFromFile(const QString& filename) {
-    QFile file(filename);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        Log.msg(QString("[main] Failed to open test CSV file: %1").arg(filename), Logger::Level::ERROR);
-        return QByteArray();
-    }
-    QByteArray data = file.readAll();
-    Log.msg(QString("[main] Loading test data from: %1, bytes[%2]").arg(filename).arg(data.size()), Logger::Level::INFO);
-    file.close();
-    return data;
-}
-
-QJsonObject generateTestDataFromCsv(const QByteArray& csvDataBytes) {
-    if (csvDataBytes.isEmpty()) { return QJsonObject(); }
-    QByteArray compressedBytes = Compressor::compressZlib(csvDataBytes);
-    if (compressedBytes.isEmpty() && !csvDataBytes.isEmpty()) { Log.msg(QString("[main] Test data compression failed!"), Logger::Level::ERROR); return QJsonObject(); }
-    QString compressedDataB64 = QString::fromLatin1(compressedBytes.toBase64());
-    QJsonObject message;
-    message["type"] = "data_stream";
-    message["symbol"] = "AAPL"; // Assuming from CSV
-    message["model"] = "SSVI"; // Assuming from CSV
-    message["metrics"] = QJsonObject{ {"load_time", QDateTime::currentMSecsSinceEpoch()} };
-    message["data_compressed"] = compressedDataB64;
-    return message;
-}
-
-//////////////////////////////////////////
-
+#include "Glob/Glob.h"
+#include "Glob/Logger.h"
+#include "Glob/Config.h"
+#include "Glob/Trace.h"
+#include "WindowLayout/WindowManager.h"
+#include "WindowLayout/ToolPanelWindow.h"
+#include "WindowLayout/TakesPageWindow/TakesPageWindow.h"
+#include "WindowLayout/QuoteChartWindow.h"
+#include "WindowLayout/WatchlistWindow/WatchlistWindow.h"
+#include "WindowLayout/LogWindow.h"
+#include "WindowLayout/RedrawScheduler.h"
+
+#include "Data/ClientReceiver.h"
+#include "Data/SymbolDataManager.h"
+#include "Network/WebSocketClient.h"
+#include "libs/CodecRegistry.h"
+
+#include <QApplication>
+#include <QStyleFactory>
+#include <QScreen>
+#include <QSessionManager>
+#include <QGuiApplication>
+#include <QObject>
+#include <QMessageBox>
+#include <QStandardPaths>
+#include <QDir>
+#include <QJsonDocument>
+#include <QCommandLineParser>
+
+QByteArray loadCsvDataFromFile(const QString& filename);
+QJsonObject generateTestDataFromCsv(const QByteArray& csvDataBytes);
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+
+    Config::initializeUserSettingsDefaults();
+
+    // Feed capture options (see Network/FeedCapture.h)
+    QCommandLineParser cmdLine;
+    cmdLine.addHelpOption();
+    const QCommandLineOption recordOption("record", "Append every received WebSocket message to <file>.", "file");
+    const QCommandLineOption replayOption("replay", "Replay <file> instead of connecting to the server.", "file");
+    const QCommandLineOption speedOption("replay-speed", "Replay speed: 1 = recorded pace, N = N times faster, 0 = max.", "x", "1");
+    const QCommandLineOption replayExitOption("replay-exit", "Quit once the replay is done and ingested (benchmark runs).");
+    cmdLine.addOptions({ recordOption, replayOption, speedOption, replayExitOption });
+    cmdLine.process(app);
+
+    app.setStyle(QStyleFactory::create("Fusion"));
+
+    WindowManager windowManager;
+
+    LogWindow logWindow(&windowManager);
+    Log.init(logWindow.logWidget);
+    Log.msg(APP_VERSION);
+    Logger::Level logLevel = Config::getLogLevel(); // Get level from config
+    Log.msg("Using Log Level: " + Logger::levelToString(logLevel), Logger::Level::INFO);
+    Log.setLevel(logLevel);
+
+
+    QSettings pathFinder;
+    Log.msg("Window settings file location: " + pathFinder.fileName());
+
+    ///////////
+    // Data pipeline
+    // Create core components (ensure they exist before windows are created/restored)
+    // Trained zstd/LZ4 dictionaries must be loaded before the hello handshake advertises them
+    QString dictionaryDir = Config::getDictionaryDir();
+    if (!dictionaryDir.isEmpty() && QDir(dictionaryDir).exists()) {
+        Compressor::CodecRegistry::instance().loadDictionaries(dictionaryDir);
+    }
+    Log.msg("Available codecs: " + Compressor::availableCodecNames().join(", "), Logger::Level::INFO);
+    Trace::setEnabled(Config::getTraceEnabled());
+
+    Glob.dataManager = new SymbolDataManager(&app);
+    IngestExecutor::OverflowPolicy overflowPolicy = IngestExecutor::OverflowPolicy::DropOldest;
+    IngestExecutor::policyFromName(Config::getIngestOverflowPolicy(), overflowPolicy);
+    Glob.dataReceiver = new ClientReceiver(Config::getIngestWorkerCount(), Config::getIngestQueueCapacity(), overflowPolicy);
+    Glob.dataReceiver->setCoalesceUndatedSnapshots(Config::getCoalesceUndatedSnapshots());
+    Glob.wsClient = new WebSocketClient();
+    Glob.redrawScheduler = new RedrawScheduler(Config::getFrameIntervalMs(), &app); // Chart windows repaint at most once per frame
+    Glob.wsClient->startNetworkThread(); // Socket reads no longer wait for the GUI
+
+    // Direct: runs on the network thread and only queues the message for an ingest worker (no GUI hop)
+    QObject::connect(Glob.wsClient, &WebSocketClient::tickerDataReceived,
+                     Glob.dataReceiver, &ClientReceiver::processWebSocketMessage, Qt::DirectConnection);
+    QObject::connect(Glob.wsClient, &WebSocketClient::smileFrameReceived,
+                     Glob.dataReceiver, &ClientReceiver::processSmileFrame, Qt::DirectConnection);
+    // Delta sequence gap -> ask the server for a full snapshot (signal comes from an ingest worker)
+    QObject::connect(Glob.dataReceiver, &ClientReceiver::resnapshotRequired,
+                     Glob.wsClient, &WebSocketClient::requestSnapshot, Qt::QueuedConnection);
+    // Stop the network thread, then the ingest workers it feeds, before the event loop ends
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, Glob.wsClient, &WebSocketClient::shutdown, Qt::DirectConnection);
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, Glob.dataReceiver, &ClientReceiver::shutdown);
+    // Always connected: tracing can be switched on at runtime (dump() skips runs that recorded nothing)
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, &app, []() { Trace::dump(Config::getTraceDumpFile()); });
+
+    // Connect once every receiver is wired: the network thread may deliver messages right away
+    if (cmdLine.isSet(recordOption)) {
+        Glob.wsClient->startRecording(cmdLine.value(recordOption));
+    }
+    if (cmdLine.isSet(replayOption)) {
+        bool ok = false;
+        const double speed = cmdLine.value(speedOption).toDouble(&ok);
+        if (!ok || speed < 0) {
+            Log.msg("Invalid --replay-speed: " + cmdLine.value(speedOption) + ". Using 1.", Logger::Level::WARNING);
+        }
+        // What the replay cost the ingest queues: with backpressure nothing should be dropped
+        QObject::connect(Glob.wsClient, &WebSocketClient::replayFinished, &app, []() {
+            quint64 dropped = 0, coalesced = 0, uncoalesced = 0;
+            for (const IngestExecutor::KeyStats& stats : Glob.dataReceiver->getIngressStats()) {
+                dropped += stats.dropped;
+                coalesced += stats.coalesced;
+                uncoalesced += stats.uncoalesced;
+            }
+            Log.msg(QString("Replay ingest: dropped %1, coalesced %2, uncoalesced %3.").arg(dropped).arg(coalesced).arg(uncoalesced),
+                dropped > 0 ? Logger::Level::WARNING : Logger::Level::INFO);
+        });
+        if (cmdLine.isSet(replayExitOption)) {
+            // Quit once the ingest queues are empty (the tasks still running finish during shutdown)
+            QObject::connect(Glob.wsClient, &WebSocketClient::replayFinished, &app, [&app]() {
+                QTimer* drainTimer = new QTimer(&app);
+                QObject::connect(drainTimer, &QTimer::timeout, &app, [&app]() {
+                    for (const IngestExecutor::KeyStats& stats : Glob.dataReceiver->getIngressStats()) {
+                        if (stats.depth > 0) return;
+                    }
+                    app.quit();
+                });
+                drainTimer->start(100);
+            });
+        }
+        // Starts with the event loop, once the restored windows are up
+        const QString replayFile = cmdLine.value(replayOption);
+        const double replaySpeed = ok && speed >= 0 ? speed : 1.0;
+        QTimer::singleShot(0, &app, [replayFile, replaySpeed]() {
+            // Max speed waits for the ingest workers below half a queue, so the overflow policy never kicks in
+            Glob.wsClient->startReplay(replayFile, replaySpeed, []() { return Glob.dataReceiver->getIngressBacklog(); },
+                Glob.dataReceiver->getIngressQueueCapacity() / 2);
+        });
+    }
+    else {
+        Log.msg("Initiating WebSocket connection process...", Logger::Level::INFO);
+        QUrl webSocketUrl = Config::getWebSocketUrl();
+        Glob.wsClient->connectToServer(webSocketUrl); // Start connecting (will retry automatically)
+    }
+
+    //Connect WS signals to UI for status updates-- -
+    QObject::connect(Glob.wsClient, &WebSocketClient::connected, &app, [&]() {
+            Log.msg("Main: WebSocket Connected!", Logger::Level::INFO);
+            // update a status bar, enable UI elements
+            // toolPanel.updateWsStatus(true);
+        }
+    );
+    QObject::connect(Glob.wsClient, &WebSocketClient::disconnected, &app, [&]() {
+            Log.msg("Main: WebSocket Disconnected! Reconnecting...", Logger::Level::WARNING);
+            // update status bar, disable UI elements
+            // toolPanel.updateWsStatus(false);
+        }
+    );
+    ///////////
+
+    // Main windows
+    ToolPanelWindow toolPanel(&windowManager);
+    WatchlistWindow watchlist(Glob.dataManager, Glob.wsClient, &windowManager);
+
+    windowManager.registerWindow(&toolPanel, "ToolPanel");
+    windowManager.registerWindow(&watchlist, "Watchlist");
+    windowManager.registerWindow(&logWindow, "LogWindow");
+
+    toolPanel.show(); // ensure that ToolPanel window always first in task bar
+    watchlist.show();
+    logWindow.show();
+
+    windowManager.restoreWindowStates();
+
+    QObject::connect(qApp, &QApplication::focusChanged,
+        &windowManager, &WindowManager::handleFocusChanged);
+
+    /////////////////////////
+    // --- Simulate receiving data (Optional - Keep for testing) ---
+    QString appPath = QCoreApplication::applicationDirPath();
+    QString csvFilePath = appPath + "/c2_update_volsmile_canvas__smile_to_be_plotted.csv";
+    Log.msg(QString("[main] Attempting to load test data from: %1").arg(csvFilePath), Logger::Level::DEBUG);
+    QByteArray csvBytes = loadCsvDataFromFile(csvFilePath);
+    if (!csvBytes.isEmpty()) {
+        QJsonObject testMessage = generateTestDataFromCsv(csvBytes);
+        QString type = testMessage.value("type").toString();
+        Log.msg(QString("B1: %1").arg(type), Logger::Level::DEBUG);
+        if (!testMessage.isEmpty()) {
+            QTimer::singleShot(150, Qt::CoarseTimer, [&, testMessage]() {
+                Log.msg("[main] Sending simulated WebSocket message to receiver...", Logger::Level::INFO);
+                QString type = testMessage.value("type").toString();
+                Log.msg(QString("B2: %1").arg(type), Logger::Level::DEBUG);
+                MessageEnvelope envelope;
+                MessageEnvelope::parse(QString::fromUtf8(QJsonDocument(testMessage).toJson(QJsonDocument::Compact)), envelope);
+                Glob.dataReceiver->processWebSocketMessage(envelope);
+                });
+        }
+        else { /* Log Warning */ }
+    }
+    else { /* Log Warning */ }
+    /////////////////////////
+
+    return app.exec();
+}
+
+//////////////////////////////////////////
+// For Local test
+
+#include "libs/Compressor.h"
+
+#include <vector>
+#include <QFile>
+#include <QDebug>
+
+// --- Test Data Generation Implementation ---
+QByteArray loadCsvDataFromFile(const QString& filename) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        Log.msg(QString("[main] Failed to open test CSV file: %1").arg(filename), Logger::Level::ERROR);
+        return QByteArray();
+    }
+    QByteArray data = file.readAll();
+    Log.msg(QString("[main] Loading test data from: %1, bytes[%2]").arg(filename).arg(data.size()), Logger::Level::INFO);
+    file.close();
+    return data;
+}
+
+QJsonObject generateTestDataFromCsv(const QByteArray& csvDataBytes) {
+    if (csvDataBytes.isEmpty()) { return QJsonObject(); }
+    QByteArray compressedBytes = Compressor::compressZlib(csvDataBytes);
+    if (compressedBytes.isEmpty() && !csvDataBytes.isEmpty()) { Log.msg(QString("[main] Test data compression failed!"), Logger::Level::ERROR); return QJsonObject(); }
+    QString compressedDataB64 = QString::fromLatin1(compressedBytes.toBase64());
+    QJsonObject message;
+    message["type"] = "data_stream";
+    message["symbol"] = "AAPL"; // Assuming from CSV
+    message["model"] = "SSVI"; // Assuming from CSV
+    message["metrics"] = QJsonObject{ {"load_time", QDateTime::currentMSecsSinceEpoch()} };
+    message["data_compressed"] = compressedDataB64;
+    return message;
+}
+
+//////////////////////////////////////////
+